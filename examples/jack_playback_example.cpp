@@ -2,12 +2,12 @@
  * @file jack_playback_example.cpp
  * @brief JACK audio file playback example using Phasor and BufRd.
  *
- * This example demonstrates loading an audio file using libsndfile and playing
+ * This example demonstrates loading a WAV file with WavFile and playing
  * it back in a loop using the Phasor and BufRd UGens. The playback rate is
  * automatically scaled to match the difference between the server sample rate
  * and the file's original sample rate.
  *
- * Compile with: -ljack -lsndfile
+ * Compile with: -ljack -lX11
  *
  * Usage:
  *   ./example_jack_playback
@@ -16,9 +16,9 @@
  */
 
 #include <jack/jack.h>
-#include <sndfile.h>
 #include <subcollider.h>
 #include <subcollider/BufferAllocator.h>
+#include <subcollider/WavFile.h>
 #include <subcollider/ugens/BufRd.h>
 #include <subcollider/ugens/Phasor.h>
 #include <X11/Xlib.h>
@@ -38,6 +38,7 @@ using namespace subcollider::ugens;
 // Global state for JACK callback
 static constexpr size_t OVERSAMPLE_FACTOR = 2;
 static BufferAllocator<> g_allocator;
+static WavFile g_wavFile;
 static Buffer g_audioBuffer;
 static Phasor g_phasor;
 static BufRd g_bufRd;
@@ -78,62 +79,40 @@ void configurePlayback(float sampleRate) {
 }
 
 /**
- * @brief Load audio file using libsndfile.
+ * @brief Load a WAV file by memory-mapping it.
  * @param filename Path to audio file
  * @return true if successful, false otherwise
+ *
+ * Float32 files are played straight from the mapping; integer PCM is
+ * converted into the allocator in a single pass.
  */
 bool loadAudioFile(const char* filename) {
-  SF_INFO sfInfo;
-  memset(&sfInfo, 0, sizeof(sfInfo));
-
-  SNDFILE* sndFile = sf_open(filename, SFM_READ, &sfInfo);
-  if (!sndFile) {
-    std::cerr << "Failed to open audio file: " << filename << std::endl;
-    std::cerr << "Error: " << sf_strerror(nullptr) << std::endl;
+  if (!g_wavFile.open(filename)) {
+    std::cerr << "Failed to open WAV file: " << filename << std::endl;
     return false;
   }
 
+  const WavInfo& info = g_wavFile.info();
   std::cout << "Loaded: " << filename << std::endl;
-  std::cout << "  Sample rate: " << sfInfo.samplerate << " Hz" << std::endl;
-  std::cout << "  Channels: " << sfInfo.channels << std::endl;
-  std::cout << "  Frames: " << sfInfo.frames << std::endl;
-  std::cout << "  Duration: " << (float)sfInfo.frames / sfInfo.samplerate
+  std::cout << "  Sample rate: " << info.sampleRate << " Hz" << std::endl;
+  std::cout << "  Channels: " << info.channels << std::endl;
+  std::cout << "  Frames: " << info.frames << std::endl;
+  std::cout << "  Duration: " << (float)info.frames / info.sampleRate
             << " seconds" << std::endl;
 
-  g_fileSampleRate = static_cast<float>(sfInfo.samplerate);
-
-  // Allocate buffer
-  uint8_t channels = (sfInfo.channels >= 2) ? 2 : 1;
-  g_audioBuffer = g_allocator.allocate(sfInfo.frames, channels);
+  g_fileSampleRate = static_cast<float>(info.sampleRate);
 
+  g_audioBuffer = g_wavFile.buffer();
+  if (!g_audioBuffer.isValid()) {
+    g_audioBuffer = g_wavFile.load(g_allocator);
+  }
   if (!g_audioBuffer.isValid()) {
     std::cerr << "Failed to allocate buffer" << std::endl;
-    sf_close(sndFile);
     return false;
   }
 
-  // Read audio data
-  if (channels == 1) {
-    // Mono file - read directly
-    sf_count_t readCount =
-        sf_read_float(sndFile, g_audioBuffer.data, sfInfo.frames);
-    if (readCount != sfInfo.frames) {
-      std::cerr << "Warning: Only read " << readCount << " of " << sfInfo.frames
-                << " frames" << std::endl;
-    }
-  } else {
-    // Stereo or multi-channel file
-    // libsndfile reads interleaved data, which matches our stereo buffer format
-    sf_count_t readCount =
-        sf_readf_float(sndFile, g_audioBuffer.data, sfInfo.frames);
-    if (readCount != sfInfo.frames) {
-      std::cerr << "Warning: Only read " << readCount << " of " << sfInfo.frames
-                << " frames" << std::endl;
-    }
-  }
-
-  sf_close(sndFile);
-  std::cout << "Audio file loaded successfully!" << std::endl;
+  std::cout << "Audio file loaded successfully"
+            << (g_wavFile.isZeroCopy() ? " (zero-copy)" : "") << "!" << std::endl;
   return true;
 }
 
@@ -10,10 +10,29 @@
 
 // Core types and utilities
 #include "subcollider/types.h"
+#include "subcollider/simd.h"
+#include "subcollider/SincTable.h"
 #include "subcollider/AudioBuffer.h"
+#include "subcollider/MultiBuffer.h"
+#include "subcollider/MpscRing.h"
+#include "subcollider/ControlQueue.h"
+#include "subcollider/EventScheduler.h"
 #include "subcollider/AudioLoop.h"
+#include "subcollider/AudioRingLoop.h"
 #include "subcollider/Buffer.h"
+#include "subcollider/Playhead.h"
+#include "subcollider/TlsfStrategy.h"
+#include "subcollider/PoolStorage.h"
 #include "subcollider/BufferAllocator.h"
+#include "subcollider/ConcurrentBufferAllocator.h"
+#include "subcollider/BufferHandle.h"
+#include "subcollider/RelocatableBufferAllocator.h"
+#include "subcollider/WavFile.h"
+#include "subcollider/MipPyramid.h"
+#include "subcollider/DiskStreamer.h"
+#include "subcollider/VoicePool.h"
+#include "subcollider/WorkerPool.h"
+#include "subcollider/ParallelVoiceRenderer.h"
 
 // UGens
 #include "subcollider/ugens/SinOsc.h"
@@ -34,6 +53,8 @@
 #include "subcollider/ugens/XLine.h"
 #include "subcollider/ugens/Phasor.h"
 #include "subcollider/ugens/BufRd.h"
+#include "subcollider/ugens/PlayBuf.h"
+#include "subcollider/ugens/DiskIn.h"
 #include "subcollider/ugens/Downsampler.h"
 #include "subcollider/ugens/CombC.h"
 #include "subcollider/ugens/Tape.h"
@@ -50,9 +71,12 @@
 #include "subcollider/ugens/OberheimMoogLadder.h"
 #include "subcollider/ugens/ImprovedMoogLadder.h"
 #include "subcollider/ugens/RKSimulationMoogLadder.h"
+#include "subcollider/ugens/ZDFMoogLadder.h"
+#include "subcollider/ugens/LadderBank.h"
 
 // Composite UGens
 #include "subcollider/ugens/SuperSaw.h"
+#include "subcollider/ugens/GrainCloud.h"
 
 // Example voice
 #include "subcollider/ExampleVoice.h"
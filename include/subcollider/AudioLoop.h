@@ -12,9 +12,83 @@
 
 #include "types.h"
 #include "AudioBuffer.h"
+#include "MultiBuffer.h"
+#include "ControlQueue.h"
+#include <atomic>
+#include <cstdint>
 
 namespace subcollider {
 
+/**
+ * @brief Control queue attachment shared by the AudioLoop variants.
+ *
+ * Holds a type-erased pointer to a ControlQueue and a handler, so the
+ * loops stay independent of the queue capacity.
+ */
+struct AudioLoopControl {
+    /// Function pointer type for control message handling
+    using ControlHandler = void (*)(const ControlMessage& msg, void* userData);
+
+    /// Attached control queue (type-erased, may be null)
+    void* controlQueue;
+
+    /// Drains controlQueue into controlHandler
+    size_t (*controlDrain)(void* queue, ControlHandler handler, void* userData);
+
+    /// Handler for control messages
+    ControlHandler controlHandler;
+
+    /// User data passed to controlHandler
+    void* controlUserData;
+
+    /**
+     * @brief Detach any control queue.
+     */
+    void initControl() noexcept {
+        controlQueue = nullptr;
+        controlDrain = nullptr;
+        controlHandler = nullptr;
+        controlUserData = nullptr;
+    }
+
+    /**
+     * @brief Attach a control queue drained by processControl().
+     * @param queue Queue written by UI, MIDI or sequencer threads
+     * @param handler Called on the audio thread for each message
+     * @param userData User data passed to the handler
+     */
+    template<size_t Capacity>
+    void setControlQueue(ControlQueue<Capacity>* queue, ControlHandler handler,
+                         void* userData = nullptr) noexcept {
+        controlQueue = queue;
+        controlDrain = &drainQueue<Capacity>;
+        controlHandler = handler;
+        controlUserData = userData;
+    }
+
+    /**
+     * @brief Deliver pending control messages (call once per block).
+     * @return Number of messages handled
+     *
+     * Call at the start of each block, before rendering into the
+     * processing buffer, so every change lands in the block it was
+     * queued for. Handles at most one queue's worth of messages.
+     */
+    size_t processControl() noexcept {
+        if (controlQueue == nullptr || controlHandler == nullptr) {
+            return 0;
+        }
+        return controlDrain(controlQueue, controlHandler, controlUserData);
+    }
+
+private:
+    template<size_t Capacity>
+    static size_t drainQueue(void* queue, ControlHandler handler, void* userData) noexcept {
+        return static_cast<ControlQueue<Capacity>*>(queue)->drain(
+            [handler, userData](const ControlMessage& msg) { handler(msg, userData); });
+    }
+};
+
 /**
  * @brief ISR-safe audio processing loop.
  *
@@ -24,12 +98,19 @@ namespace subcollider {
  * It maintains a double buffer for output and processes audio in fixed-size
  * blocks to minimize cache misses and optimize for embedded targets.
  *
+ * The buffer index is published with release semantics and read with
+ * acquire semantics, so an output reader on another core sees the block
+ * contents that were written before swapBuffers(). The double buffer has
+ * no backpressure, though: when the renderer and the device run on
+ * different threads and may drift, use AudioRingLoop instead.
+ *
  * Usage:
  * @code
  * AudioLoop<64> loop;
  * loop.init(48000.0f);
  *
  * // In audio interrupt or callback:
+ * loop.processControl();
  * float* buf = loop.getProcessingBuffer();
  * loop.clearProcessingBuffer();
  * myVoice.process(buf, 64);
@@ -38,7 +119,7 @@ namespace subcollider {
  * @endcode
  */
 template<size_t BlockSize = DEFAULT_BLOCK_SIZE>
-struct AudioLoop {
+struct AudioLoop : AudioLoopControl {
     /// Output buffer A
     AudioBuffer<BlockSize> bufferA;
 
@@ -46,7 +127,7 @@ struct AudioLoop {
     AudioBuffer<BlockSize> bufferB;
 
     /// Current buffer index (0 = A, 1 = B)
-    volatile uint8_t currentBuffer;
+    std::atomic<uint8_t> currentBuffer;
 
     /// Sample rate in Hz
     Sample sampleRate;
@@ -60,9 +141,10 @@ struct AudioLoop {
      */
     void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
         sampleRate = sr;
-        currentBuffer = 0;
+        currentBuffer.store(0, std::memory_order_relaxed);
         bufferA.clear();
         bufferB.clear();
+        initControl();
     }
 
     /**
@@ -70,7 +152,7 @@ struct AudioLoop {
      * @return Pointer to sample data ready for output
      */
     const Sample* getOutputBuffer() const noexcept {
-        return currentBuffer == 0 ? bufferB.data : bufferA.data;
+        return currentBuffer.load(std::memory_order_acquire) == 0 ? bufferB.data : bufferA.data;
     }
 
     /**
@@ -78,14 +160,14 @@ struct AudioLoop {
      * @return Pointer to sample data for writing
      */
     Sample* getProcessingBuffer() noexcept {
-        return currentBuffer == 0 ? bufferA.data : bufferB.data;
+        return currentBuffer.load(std::memory_order_relaxed) == 0 ? bufferA.data : bufferB.data;
     }
 
     /**
      * @brief Clear the processing buffer.
      */
     void clearProcessingBuffer() noexcept {
-        if (currentBuffer == 0) {
+        if (currentBuffer.load(std::memory_order_relaxed) == 0) {
             bufferA.clear();
         } else {
             bufferB.clear();
@@ -99,7 +181,106 @@ struct AudioLoop {
      * samples available for output.
      */
     void swapBuffers() noexcept {
-        currentBuffer = currentBuffer == 0 ? 1 : 0;
+        const uint8_t next = currentBuffer.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+        currentBuffer.store(next, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the block size.
+     * @return Number of samples per block
+     */
+    static constexpr size_t getBlockSize() noexcept {
+        return BlockSize;
+    }
+};
+
+/**
+ * @brief ISR-safe multichannel audio processing loop.
+ *
+ * @tparam Channels Number of output channels
+ * @tparam BlockSize Size of audio blocks in samples
+ *
+ * Same double-buffer scheme as AudioLoop, but each buffer is a planar,
+ * cache-line aligned MultiBuffer so stereo and N-channel block kernels
+ * can write whole channels with vector stores.
+ *
+ * Usage:
+ * @code
+ * StereoAudioLoop<64> loop;
+ * loop.init(48000.0f);
+ *
+ * // In audio interrupt or callback:
+ * loop.processControl();
+ * auto& buf = loop.getProcessingBuffer();
+ * supersaw.process(buf.left(), buf.right(), 64);
+ * loop.swapBuffers();
+ * loop.getOutputBuffer().interleave(deviceBuffer);
+ * @endcode
+ */
+template<size_t Channels, size_t BlockSize = DEFAULT_BLOCK_SIZE>
+struct MultiAudioLoop : AudioLoopControl {
+    /// Block buffer type
+    using Buffer = MultiBuffer<Channels, BlockSize>;
+
+    /// Output buffer A
+    Buffer bufferA;
+
+    /// Output buffer B
+    Buffer bufferB;
+
+    /// Current buffer index (0 = A, 1 = B)
+    std::atomic<uint8_t> currentBuffer;
+
+    /// Sample rate in Hz
+    Sample sampleRate;
+
+    /// Block size in samples
+    static constexpr size_t blockSize = BlockSize;
+
+    /// Number of channels
+    static constexpr size_t numChannels = Channels;
+
+    /**
+     * @brief Initialize the audio loop.
+     * @param sr Sample rate in Hz
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
+        sampleRate = sr;
+        currentBuffer.store(0, std::memory_order_relaxed);
+        bufferA.clear();
+        bufferB.clear();
+        initControl();
+    }
+
+    /**
+     * @brief Get the current output buffer (ISR-safe read).
+     * @return Planar block ready for output
+     */
+    const Buffer& getOutputBuffer() const noexcept {
+        return currentBuffer.load(std::memory_order_acquire) == 0 ? bufferB : bufferA;
+    }
+
+    /**
+     * @brief Get the processing buffer.
+     * @return Planar block for writing
+     */
+    Buffer& getProcessingBuffer() noexcept {
+        return currentBuffer.load(std::memory_order_relaxed) == 0 ? bufferA : bufferB;
+    }
+
+    /**
+     * @brief Clear the processing buffer.
+     */
+    void clearProcessingBuffer() noexcept {
+        getProcessingBuffer().clear();
+    }
+
+    /**
+     * @brief Swap buffers after processing (ISR-safe).
+     */
+    void swapBuffers() noexcept {
+        const uint8_t next = currentBuffer.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+        currentBuffer.store(next, std::memory_order_release);
     }
 
     /**
@@ -111,6 +292,10 @@ struct AudioLoop {
     }
 };
 
+/// Stereo audio processing loop with planar left/right buffers
+template<size_t BlockSize = DEFAULT_BLOCK_SIZE>
+using StereoAudioLoop = MultiAudioLoop<2, BlockSize>;
+
 /**
  * @brief Simple audio callback handler for non-templated use.
  *
@@ -122,12 +307,21 @@ struct AudioCallbackHandler {
     /// Function pointer type for audio processing callback
     using ProcessCallback = void (*)(Sample* buffer, size_t numSamples, void* userData);
 
+    /// Function pointer type for stereo audio processing callback
+    using StereoProcessCallback = void (*)(Sample* left, Sample* right, size_t numSamples, void* userData);
+
     /// Audio processing callback
     ProcessCallback callback;
 
     /// User data passed to callback
     void* userData;
 
+    /// Stereo audio processing callback
+    StereoProcessCallback stereoCallback;
+
+    /// User data passed to stereo callback
+    void* stereoUserData;
+
     /// Sample rate in Hz
     Sample sampleRate;
 
@@ -139,6 +333,8 @@ struct AudioCallbackHandler {
         sampleRate = sr;
         callback = nullptr;
         userData = nullptr;
+        stereoCallback = nullptr;
+        stereoUserData = nullptr;
     }
 
     /**
@@ -161,6 +357,31 @@ struct AudioCallbackHandler {
             callback(buffer, numSamples, userData);
         }
     }
+
+    /**
+     * @brief Set the stereo processing callback.
+     * @param cb Callback function
+     * @param data User data pointer
+     *
+     * ParallelVoiceRenderer::stereoCallback fits here, so a host callback
+     * only has to call processStereo() and wait for the block barrier.
+     */
+    void setStereoCallback(StereoProcessCallback cb, void* data = nullptr) noexcept {
+        stereoCallback = cb;
+        stereoUserData = data;
+    }
+
+    /**
+     * @brief Process a block of stereo audio.
+     * @param left Left output buffer
+     * @param right Right output buffer
+     * @param numSamples Number of samples to generate
+     */
+    void processStereo(Sample* left, Sample* right, size_t numSamples) noexcept {
+        if (stereoCallback) {
+            stereoCallback(left, right, numSamples, stereoUserData);
+        }
+    }
 };
 
 } // namespace subcollider
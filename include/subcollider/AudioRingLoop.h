@@ -0,0 +1,252 @@
+/**
+ * @file AudioRingLoop.h
+ * @brief Lock-free N-slot block ring between a renderer and a device.
+ *
+ * AudioRingLoop lets the renderer run ahead of the device callback by a
+ * configurable number of blocks. Blocks are handed over through a
+ * single-producer/single-consumer ring with acquire/release ordering, so
+ * the two sides can run on different cores (or in an ISR) without locks
+ * and without tearing. No heap allocation occurs.
+ */
+
+#ifndef SUBCOLLIDER_AUDIO_RING_LOOP_H
+#define SUBCOLLIDER_AUDIO_RING_LOOP_H
+
+#include "types.h"
+#include "AudioBuffer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+
+/**
+ * @brief N-slot lock-free block ring with overrun/underrun counting.
+ *
+ * @tparam BlockSize Size of audio blocks in samples
+ * @tparam NumSlots Number of block slots (3 = triple buffering)
+ *
+ * The renderer (producer) fills slots with getProcessingBuffer() and
+ * publishes them with swapBuffers(). The device (consumer) takes the
+ * oldest published block with getOutputBuffer() and returns it with
+ * releaseOutputBuffer(). The producer may be at most maxAhead blocks in
+ * front of the consumer (set in init(), at most NumSlots).
+ *
+ * - An overrun is a getProcessingBuffer() call while the ring is full;
+ *   it returns nullptr. A renderer that checks writable() first never
+ *   overruns.
+ * - An underrun is a getOutputBuffer() call while the ring is empty; it
+ *   returns a silent block so the device always has something to play.
+ *
+ * Each side only writes its own counter; the other side reads it with
+ * acquire ordering, so a published block's samples are always visible
+ * before its slot is handed over.
+ *
+ * Usage:
+ * @code
+ * AudioRingLoop<64, 4> ring;
+ * ring.init(48000.0f, 2);  // render up to 2 blocks ahead
+ *
+ * // Renderer thread:
+ * while (ring.writable() > 0) {
+ *     Sample* buf = ring.getProcessingBuffer();
+ *     myVoice.process(buf, 64);
+ *     ring.swapBuffers();
+ * }
+ *
+ * // Device callback or ISR:
+ * const Sample* out = ring.getOutputBuffer();
+ * copyToDevice(out, 64);
+ * ring.releaseOutputBuffer();
+ * @endcode
+ */
+template<size_t BlockSize = DEFAULT_BLOCK_SIZE, size_t NumSlots = 3>
+struct AudioRingLoop {
+    static_assert(NumSlots >= 2, "AudioRingLoop needs at least two slots");
+
+    /// Block slots
+    AudioBuffer<BlockSize> slots[NumSlots];
+
+    /// Silent block returned on underrun
+    AudioBuffer<BlockSize> silence;
+
+    /// Sample rate in Hz
+    Sample sampleRate;
+
+    /// Block size in samples
+    static constexpr size_t blockSize = BlockSize;
+
+    /**
+     * @brief Initialize the ring (not thread-safe; call before starting).
+     * @param sr Sample rate in Hz
+     * @param ahead Maximum number of blocks the renderer may run ahead
+     *              (clamped to 1..NumSlots)
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE, size_t ahead = NumSlots) noexcept {
+        sampleRate = sr;
+        setMaxAhead(ahead);
+        for (size_t i = 0; i < NumSlots; ++i) {
+            slots[i].clear();
+        }
+        silence.clear();
+        written_.store(0, std::memory_order_relaxed);
+        read_.store(0, std::memory_order_relaxed);
+        overruns_.store(0, std::memory_order_relaxed);
+        underruns_.store(0, std::memory_order_relaxed);
+        holding_ = false;
+    }
+
+    /**
+     * @brief Set how many blocks the renderer may run ahead.
+     * @param ahead Block count (clamped to 1..NumSlots)
+     *
+     * Lowering it while running only takes effect once the consumer has
+     * drained below the new limit.
+     */
+    void setMaxAhead(size_t ahead) noexcept {
+        if (ahead < 1) {
+            ahead = 1;
+        }
+        if (ahead > NumSlots) {
+            ahead = NumSlots;
+        }
+        maxAhead_.store(ahead, std::memory_order_relaxed);
+    }
+
+    // --- Producer side (renderer thread) ---
+
+    /**
+     * @brief Get the number of blocks the renderer may write now.
+     * @return Free slots within the run-ahead limit
+     */
+    size_t writable() const noexcept {
+        const size_t filled = written_.load(std::memory_order_relaxed) -
+                              read_.load(std::memory_order_acquire);
+        const size_t ahead = maxAhead_.load(std::memory_order_relaxed);
+        return filled >= ahead ? 0 : ahead - filled;
+    }
+
+    /**
+     * @brief Get the next slot to render into.
+     * @return Pointer to block samples, or nullptr if the ring is full
+     *         (counted as an overrun)
+     */
+    Sample* getProcessingBuffer() noexcept {
+        if (writable() == 0) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return slots[written_.load(std::memory_order_relaxed) % NumSlots].data;
+    }
+
+    /**
+     * @brief Clear the next slot to render into.
+     */
+    void clearProcessingBuffer() noexcept {
+        slots[written_.load(std::memory_order_relaxed) % NumSlots].clear();
+    }
+
+    /**
+     * @brief Publish the rendered slot to the consumer.
+     *
+     * Only call after a successful getProcessingBuffer().
+     */
+    void swapBuffers() noexcept {
+        written_.store(written_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // --- Consumer side (device callback or ISR) ---
+
+    /**
+     * @brief Get the number of published blocks waiting for output.
+     * @return Block count
+     */
+    size_t readable() const noexcept {
+        return written_.load(std::memory_order_acquire) -
+               read_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the oldest published block.
+     * @return Pointer to block samples, or a silent block if none is ready
+     *         (counted as an underrun)
+     *
+     * Repeated calls without releaseOutputBuffer() return the same block.
+     */
+    const Sample* getOutputBuffer() noexcept {
+        if (readable() == 0) {
+            holding_ = false;
+            underruns_.fetch_add(1, std::memory_order_relaxed);
+            return silence.data;
+        }
+        holding_ = true;
+        return slots[read_.load(std::memory_order_relaxed) % NumSlots].data;
+    }
+
+    /**
+     * @brief Return the block obtained from getOutputBuffer() to the renderer.
+     *
+     * Does nothing after an underrun.
+     */
+    void releaseOutputBuffer() noexcept {
+        if (!holding_) {
+            return;
+        }
+        holding_ = false;
+        read_.store(read_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // --- Statistics (any thread) ---
+
+    /**
+     * @brief Get the number of overruns since init().
+     * @return Rejected getProcessingBuffer() calls
+     */
+    uint32_t overrunCount() const noexcept {
+        return overruns_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of underruns since init().
+     * @return getOutputBuffer() calls that returned silence
+     */
+    uint32_t underrunCount() const noexcept {
+        return underruns_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the run-ahead limit.
+     * @return Maximum blocks the renderer may be ahead
+     */
+    size_t maxAhead() const noexcept {
+        return maxAhead_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the block size.
+     * @return Number of samples per block
+     */
+    static constexpr size_t getBlockSize() noexcept {
+        return BlockSize;
+    }
+
+    /**
+     * @brief Get the number of slots.
+     * @return Slot count
+     */
+    static constexpr size_t getNumSlots() noexcept {
+        return NumSlots;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> written_{0};     ///< Blocks published (producer)
+    alignas(64) std::atomic<size_t> read_{0};        ///< Blocks released (consumer)
+    bool holding_ = false;                           ///< Consumer holds a real block
+    alignas(64) std::atomic<uint32_t> overruns_{0};  ///< Producer-side count
+    std::atomic<uint32_t> underruns_{0};             ///< Consumer-side count
+    std::atomic<size_t> maxAhead_{NumSlots};         ///< Run-ahead limit
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_AUDIO_RING_LOOP_H
@@ -10,6 +10,7 @@
 #define SUBCOLLIDER_BUFFER_H
 
 #include "types.h"
+#include <cstddef>
 
 namespace subcollider {
 
@@ -28,10 +29,33 @@ namespace subcollider {
  *   data[2], data[3] = left[1], right[1]
  *   etc. (interleaved format)
  *
+ * A buffer may carry guard frames: guardFrames extra frames directly
+ * before data[0] and after the last frame, owned by the same allocation.
+ * updateGuards() fills them with the wrapped neighbours (GuardMode::Wrap)
+ * or repeats the edge frames (GuardMode::Clamp), so interpolating readers
+ * whose loop setting matches guardMode can read a few frames past either
+ * edge with no index wrapping. Rewrite the guards after changing the
+ * sample data.
+ *
+ * A buffer may also link to a mip pyramid (see MipPyramid): mip points
+ * to a half-band filtered copy at half the length and sample rate, whose
+ * own mip points to the next level, and so on. BufRd reads the level that
+ * matches its playback rate (BufRd::setMipRate()).
+ *
  * Note: This struct does not own the memory pointed to by `data`.
  * The caller is responsible for managing the lifetime of the audio data.
  */
 struct Buffer {
+    /// Contents of the guard frames
+    enum class GuardMode : uint8_t {
+        Off = 0,    ///< Not written, or stale
+        Wrap = 1,   ///< Copies of the frames at the other end (looping)
+        Clamp = 2   ///< Copies of the edge frames (clamping)
+    };
+
+    /// blockId value for buffers that did not come from a BufferAllocator
+    static constexpr uint32_t NO_BLOCK = 0xFFFFFFFFu;
+
     /// Pointer to float array containing audio samples
     Sample* data;
 
@@ -44,12 +68,28 @@ struct Buffer {
     /// Number of samples in the buffer (per channel for stereo)
     size_t numSamples;
 
+    /// Allocator block id, lets BufferAllocator release in O(1)
+    uint32_t blockId;
+
+    /// Guard frames before data[0] and after the last frame
+    uint8_t guardFrames;
+
+    /// What the guard frames currently hold
+    GuardMode guardMode;
+
+    /// Next coarser mip level (half length, half rate), or nullptr
+    const Buffer* mip;
+
     /// Default constructor - initialize to empty buffer
     constexpr Buffer() noexcept
         : data(nullptr)
         , channels(1)
         , sampleRate(DEFAULT_SAMPLE_RATE)
-        , numSamples(0) {}
+        , numSamples(0)
+        , blockId(NO_BLOCK)
+        , guardFrames(0)
+        , guardMode(GuardMode::Off)
+        , mip(nullptr) {}
 
     /**
      * @brief Construct a buffer with the given parameters.
@@ -57,12 +97,19 @@ struct Buffer {
      * @param ch Number of channels (1 or 2)
      * @param sr Sample rate in Hz
      * @param n Number of samples (per channel for stereo)
+     * @param id Allocator block id (NO_BLOCK if not pool memory)
+     * @param guard Guard frames allocated on each side of d
      */
-    constexpr Buffer(Sample* d, uint8_t ch, Sample sr, size_t n) noexcept
+    constexpr Buffer(Sample* d, uint8_t ch, Sample sr, size_t n, uint32_t id = NO_BLOCK,
+                     uint8_t guard = 0) noexcept
         : data(d)
         , channels(ch)
         , sampleRate(sr)
-        , numSamples(n) {}
+        , numSamples(n)
+        , blockId(id)
+        , guardFrames(guard)
+        , guardMode(GuardMode::Off)
+        , mip(nullptr) {}
 
     /**
      * @brief Check if the buffer is valid (has data and samples).
@@ -130,6 +177,65 @@ struct Buffer {
         return Stereo(data[i], data[i + 1]);
     }
 
+    /**
+     * @brief Get the number of floats including guard frames.
+     * @return (numSamples + 2 * guardFrames) * channels
+     */
+    constexpr size_t allocatedFloats() const noexcept {
+        return (numSamples + 2 * static_cast<size_t>(guardFrames)) * channels;
+    }
+
+    /**
+     * @brief Check that guard frames of the given mode cover a reach.
+     * @param mode Required guard contents
+     * @param frames Frames a reader needs past either edge
+     * @return true if reads up to frames beyond either edge are valid
+     */
+    constexpr bool hasGuards(GuardMode mode, size_t frames) const noexcept {
+        return guardMode == mode && guardFrames >= frames;
+    }
+
+    /**
+     * @brief Write the guard frames from the current sample data.
+     * @param mode Wrap or Clamp (Off marks the guards unused)
+     *
+     * Call after filling or modifying the buffer. Does nothing for
+     * buffers without guard frames.
+     */
+    void updateGuards(GuardMode mode) noexcept {
+        if (guardFrames == 0 || !isValid()) {
+            return;
+        }
+        guardMode = mode;
+        if (mode == GuardMode::Off) {
+            return;
+        }
+        const size_t g = guardFrames;
+        for (size_t k = 1; k <= g; ++k) {
+            // Frame -k before the start and frame numSamples - 1 + k after the end
+            size_t before = 0;
+            size_t after = numSamples - 1;
+            if (mode == GuardMode::Wrap) {
+                before = numSamples - 1 - (k - 1) % numSamples;
+                after = (k - 1) % numSamples;
+            }
+            for (size_t c = 0; c < channels; ++c) {
+                data[-static_cast<ptrdiff_t>(k * channels) + static_cast<ptrdiff_t>(c)] =
+                    data[before * channels + c];
+                data[(numSamples - 1 + k) * channels + c] = data[after * channels + c];
+            }
+        }
+    }
+
+    /**
+     * @brief Rewrite the guard frames in their current mode.
+     *
+     * Call after changing sample data; does nothing if the guards are unused.
+     */
+    void updateGuards() noexcept {
+        updateGuards(guardMode);
+    }
+
     /**
      * @brief Get the duration of the buffer in seconds.
      * @return Duration in seconds
@@ -12,10 +12,153 @@
 
 #include "types.h"
 #include "Buffer.h"
+#include "TlsfStrategy.h"
+#include "PoolStorage.h"
 #include <cstddef>
+#include <cstdint>
 
 namespace subcollider {
 
+/**
+ * @brief First-fit block manager over a pool of PoolSamples floats.
+ *
+ * @tparam PoolSamples Pool size in floats
+ * @tparam MaxBlocks Maximum number of blocks (used and free) tracked
+ *
+ * Blocks are kept sorted by offset in a flat array. Allocation takes the
+ * first free block that fits and splits it; release marks the block free
+ * and merges adjacent free blocks. Both scan the array, so their cost
+ * grows with the number of blocks. Block ids are not stable (the array
+ * shifts on split and merge), so allocate() returns NONE.
+ */
+template<size_t PoolSamples, size_t MaxBlocks>
+class FirstFitStrategy {
+public:
+    /// Id returned for every block (ids are not stable)
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    /**
+     * @brief Reset to a single free block spanning the pool.
+     */
+    void init() noexcept {
+        blockCount_ = 1;
+        blocks_[0] = Block{0, PoolSamples, false};
+    }
+
+    /**
+     * @brief Allocate a range of floats.
+     * @param size Number of floats
+     * @param offset Receives the range start within the pool
+     * @param id Receives NONE
+     * @return true on success
+     */
+    bool allocate(size_t size, size_t& offset, uint32_t& id) noexcept {
+        // First-fit search for a free block
+        for (size_t i = 0; i < blockCount_; ++i) {
+            if (!blocks_[i].used && blocks_[i].size >= size) {
+                // Found a suitable block
+                offset = blocks_[i].offset;
+                id = NONE;
+                const size_t remaining = blocks_[i].size - size;
+
+                if (remaining > 0 && blockCount_ < MaxBlocks) {
+                    // Split the block
+                    blocks_[i].size = size;
+                    blocks_[i].used = true;
+
+                    // Insert new free block after current
+                    for (size_t j = blockCount_; j > i + 1; --j) {
+                        blocks_[j] = blocks_[j - 1];
+                    }
+                    blocks_[i + 1] = Block{offset + size, remaining, false};
+                    ++blockCount_;
+                } else {
+                    // Use the entire block
+                    blocks_[i].used = true;
+                }
+                return true;
+            }
+        }
+
+        // No suitable block found
+        return false;
+    }
+
+    /**
+     * @brief Release a range and merge adjacent free blocks.
+     * @param offset Range start as returned by allocate()
+     * @param id Ignored
+     * @return true if a used block was released
+     */
+    bool release(size_t offset, uint32_t id) noexcept {
+        (void)id;
+        for (size_t i = 0; i < blockCount_; ++i) {
+            if (blocks_[i].offset == offset && blocks_[i].used) {
+                blocks_[i].used = false;
+                mergeAdjacentFreeBlocks();
+                return true;
+            }
+        }
+        return false;  // Block not found
+    }
+
+    /**
+     * @brief Get the number of blocks (used and free).
+     * @return Block count
+     */
+    size_t blockCount() const noexcept {
+        return blockCount_;
+    }
+
+    /**
+     * @brief Get the number of free floats.
+     * @return Free space
+     */
+    size_t freeSpace() const noexcept {
+        size_t free = 0;
+        for (size_t i = 0; i < blockCount_; ++i) {
+            if (!blocks_[i].used) {
+                free += blocks_[i].size;
+            }
+        }
+        return free;
+    }
+
+private:
+    /// Block metadata for tracking allocations
+    struct Block {
+        size_t offset;  ///< Offset into the pool
+        size_t size;    ///< Size in floats
+        bool used;      ///< Whether block is allocated
+    };
+
+    /// Merge adjacent free blocks to reduce fragmentation
+    void mergeAdjacentFreeBlocks() noexcept {
+        if (blockCount_ <= 1) {
+            return;  // Nothing to merge
+        }
+        size_t i = 0;
+        while (i < blockCount_ - 1) {
+            if (!blocks_[i].used && !blocks_[i + 1].used) {
+                // Merge blocks i and i+1
+                blocks_[i].size += blocks_[i + 1].size;
+
+                // Remove block i+1
+                for (size_t j = i + 1; j < blockCount_ - 1; ++j) {
+                    blocks_[j] = blocks_[j + 1];
+                }
+                --blockCount_;
+                // Don't increment i, check for more merges at same position
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    Block blocks_[MaxBlocks];  ///< Block metadata, sorted by offset
+    size_t blockCount_ = 0;    ///< Number of blocks in use
+};
+
 /**
  * @brief Memory pool allocator for audio buffers.
  *
@@ -24,8 +167,25 @@ namespace subcollider {
  * at 48kHz stereo) at initialization time, and provides methods to allocate
  * and release portions of this memory for use as audio buffers.
  *
- * The allocator uses a simple first-fit free list algorithm for allocation.
- * Released buffers are merged with adjacent free blocks when possible.
+ * How blocks are found and merged is chosen by the Strategy parameter:
+ * - FirstFitStrategy (default): a first-fit scan over a sorted block
+ *   array. Simple, but allocate() and release() are O(MaxBlocks).
+ * - TlsfStrategy: two-level segregated fit. allocate() and release() are
+ *   O(1) with a fixed worst case, for control paths with hundreds of live
+ *   buffers. Use the TlsfBufferAllocator alias.
+ *
+ * Both strategies keep their metadata outside the pool and merge released
+ * buffers with adjacent free blocks, so freeSpace() is exact and the API
+ * behaves identically.
+ *
+ * Where the pool memory lives is chosen by the Storage parameter:
+ * - EmbeddedStorage (default): the pool is an array inside the object and
+ *   init() zeroes all of it.
+ * - MmapStorage: the pool is an anonymous mapping reserved by init().
+ *   Pages are zero-filled on first touch, so init() is cheap and resident
+ *   memory grows with what is loaded. Call prefault() or lock() on the
+ *   buffers the audio thread will read before going real-time. Use the
+ *   MmapBufferAllocator alias.
  *
  * Example usage:
  * @code
@@ -47,14 +207,17 @@ namespace subcollider {
  *                     Default is 5 minutes at 48kHz stereo = 28,800,000 floats.
  * @tparam MaxBlocks Maximum number of allocation blocks to track.
  *                   Default is 256 blocks.
+ * @tparam Strategy Block management strategy (FirstFitStrategy or TlsfStrategy).
+ * @tparam Storage Pool backing store (EmbeddedStorage or MmapStorage).
  */
-template<size_t PoolSamples = 5 * 60 * 48000 * 2, size_t MaxBlocks = 256>
+template<size_t PoolSamples = 5 * 60 * 48000 * 2, size_t MaxBlocks = 256,
+         template<size_t, size_t> class Strategy = FirstFitStrategy,
+         template<size_t> class Storage = EmbeddedStorage>
 class BufferAllocator {
 public:
-    /// Default constructor - pool is zero-initialized
+    /// Default constructor - pool is set up by init()
     BufferAllocator() noexcept
         : sampleRate_(DEFAULT_SAMPLE_RATE)
-        , blockCount_(0)
         , initialized_(false) {
     }
 
@@ -63,65 +226,52 @@ public:
      * @param sr Sample rate in Hz for allocated buffers
      *
      * This clears the pool and sets up the initial free block.
-     * Must be called before allocate().
+     * Must be called before allocate(). With MmapStorage the pool is
+     * mapped here; if that fails the allocator stays uninitialized.
      */
     void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
         sampleRate_ = sr;
-        blockCount_ = 1;
-        blocks_[0] = Block{0, PoolSamples, false};
-        initialized_ = true;
-        
-        // Zero-initialize the pool
-        for (size_t i = 0; i < PoolSamples; ++i) {
-            pool_[i] = 0.0f;
+        if (!storage_.reserve()) {
+            initialized_ = false;
+            return;
         }
+        pool_ = storage_.data();
+        strategy_.init();
+        initialized_ = true;
+
+        // Zero the pool (with MmapStorage: drop pages, zero-filled on demand)
+        storage_.discard();
     }
 
     /**
      * @brief Allocate a buffer from the pool.
      * @param numSamples Number of samples (per channel for stereo)
      * @param channels Number of channels (1 for mono, 2 for stereo)
+     * @param guardFrames Extra frames to reserve before and after the data
      * @return Buffer object pointing to allocated memory, or invalid Buffer if allocation fails
      *
      * For stereo buffers, the actual float count is numSamples * 2 (interleaved).
      * Returns an invalid Buffer (data == nullptr) if allocation fails.
+     *
+     * With guardFrames > 0, data points past the leading guard frames and
+     * the guards start unused (GuardMode::Off); call updateGuards() on
+     * the buffer once it is filled. The fill helpers below refresh guards
+     * that are already in use.
      */
-    Buffer allocate(size_t numSamples, uint8_t channels = 1) noexcept {
+    Buffer allocate(size_t numSamples, uint8_t channels = 1, uint8_t guardFrames = 0) noexcept {
         if (!initialized_ || numSamples == 0 || (channels != 1 && channels != 2)) {
             return Buffer();
         }
 
-        const size_t floatsNeeded = numSamples * channels;
-
-        // First-fit search for a free block
-        for (size_t i = 0; i < blockCount_; ++i) {
-            if (!blocks_[i].used && blocks_[i].size >= floatsNeeded) {
-                // Found a suitable block
-                const size_t offset = blocks_[i].offset;
-                const size_t remaining = blocks_[i].size - floatsNeeded;
-
-                if (remaining > 0 && blockCount_ < MaxBlocks) {
-                    // Split the block
-                    blocks_[i].size = floatsNeeded;
-                    blocks_[i].used = true;
-
-                    // Insert new free block after current
-                    for (size_t j = blockCount_; j > i + 1; --j) {
-                        blocks_[j] = blocks_[j - 1];
-                    }
-                    blocks_[i + 1] = Block{offset + floatsNeeded, remaining, false};
-                    ++blockCount_;
-                } else {
-                    // Use the entire block
-                    blocks_[i].used = true;
-                }
+        const size_t floatsNeeded = (numSamples + 2 * static_cast<size_t>(guardFrames)) * channels;
 
-                return Buffer(&pool_[offset], channels, sampleRate_, numSamples);
-            }
+        size_t offset = 0;
+        uint32_t id = Buffer::NO_BLOCK;
+        if (!strategy_.allocate(floatsNeeded, offset, id)) {
+            return Buffer();
         }
-
-        // No suitable block found
-        return Buffer();
+        return Buffer(&pool_[offset + static_cast<size_t>(guardFrames) * channels], channels,
+                      sampleRate_, numSamples, id, guardFrames);
     }
 
     /**
@@ -140,23 +290,57 @@ public:
 
         // Find the block corresponding to this buffer
         // Note: pool_ + PoolSamples is a valid one-past-the-end pointer for bounds checking
-        const Sample* start = buf.data;
-        if (start < pool_ || start >= pool_ + PoolSamples) {
+        const size_t lead = static_cast<size_t>(buf.guardFrames) * buf.channels;
+        if (buf.data < pool_ + lead || buf.data >= pool_ + PoolSamples) {
             return false;  // Not from this pool
         }
 
-        // Safe cast: we've verified start is within pool_ bounds
-        const size_t offset = static_cast<size_t>(start - pool_);
+        // Safe cast: we've verified the block start is within pool_ bounds
+        const size_t offset = static_cast<size_t>(buf.data - pool_) - lead;
+        return strategy_.release(offset, buf.blockId);
+    }
 
-        for (size_t i = 0; i < blockCount_; ++i) {
-            if (blocks_[i].offset == offset && blocks_[i].used) {
-                blocks_[i].used = false;
-                mergeAdjacentFreeBlocks();
-                return true;
-            }
-        }
+    /**
+     * @brief Commit the pages backing a buffer (not real-time safe).
+     * @param buf Buffer from this allocator
+     * @return true on success
+     *
+     * Contents are unchanged. With EmbeddedStorage this does nothing.
+     */
+    bool prefault(const Buffer& buf) noexcept {
+        size_t offset = 0;
+        return poolOffset(buf, offset) && storage_.prefault(offset, buf.allocatedFloats());
+    }
 
-        return false;  // Block not found
+    /**
+     * @brief Commit and pin the pages backing a buffer (not real-time safe).
+     * @param buf Buffer from this allocator
+     * @return true on success (mlock may be limited by RLIMIT_MEMLOCK)
+     *
+     * Pages shared with a neighbouring buffer stay pinned until both are
+     * unlocked.
+     */
+    bool lock(const Buffer& buf) noexcept {
+        size_t offset = 0;
+        return poolOffset(buf, offset) && storage_.lock(offset, buf.allocatedFloats());
+    }
+
+    /**
+     * @brief Unpin the pages backing a buffer (not real-time safe).
+     * @param buf Buffer previously passed to lock()
+     * @return true on success
+     */
+    bool unlock(const Buffer& buf) noexcept {
+        size_t offset = 0;
+        return poolOffset(buf, offset) && storage_.unlock(offset, buf.allocatedFloats());
+    }
+
+    /**
+     * @brief Access the backing store, e.g. to request huge pages before init().
+     * @return Storage policy object
+     */
+    Storage<PoolSamples>& storage() noexcept {
+        return storage_;
     }
 
     /**
@@ -178,6 +362,7 @@ public:
         for (size_t i = 0; i < toCopy; ++i) {
             buf.data[i] = data[i];
         }
+        buf.updateGuards();
         return true;
     }
 
@@ -202,6 +387,7 @@ public:
             buf.data[i * 2] = left[i];
             buf.data[i * 2 + 1] = right[i];
         }
+        buf.updateGuards();
         return true;
     }
 
@@ -222,6 +408,7 @@ public:
         for (size_t i = 0; i < floats; ++i) {
             buf.data[i] = interleaved[i];
         }
+        buf.updateGuards();
         return true;
     }
 
@@ -238,7 +425,7 @@ public:
      * @return Number of blocks (both used and free)
      */
     size_t blockCount() const noexcept {
-        return blockCount_;
+        return strategy_.blockCount();
     }
 
     /**
@@ -246,13 +433,7 @@ public:
      * @return Number of unallocated float samples
      */
     size_t freeSpace() const noexcept {
-        size_t free = 0;
-        for (size_t i = 0; i < blockCount_; ++i) {
-            if (!blocks_[i].used) {
-                free += blocks_[i].size;
-            }
-        }
-        return free;
+        return strategy_.freeSpace();
     }
 
     /**
@@ -292,43 +473,35 @@ public:
     }
 
 private:
-    /// Block metadata for tracking allocations
-    struct Block {
-        size_t offset;  ///< Offset into pool_ array
-        size_t size;    ///< Size in floats
-        bool used;      ///< Whether block is allocated
-    };
-
-    /// Merge adjacent free blocks to reduce fragmentation
-    void mergeAdjacentFreeBlocks() noexcept {
-        if (blockCount_ <= 1) {
-            return;  // Nothing to merge
-        }
-        size_t i = 0;
-        while (i < blockCount_ - 1) {
-            if (!blocks_[i].used && !blocks_[i + 1].used) {
-                // Merge blocks i and i+1
-                blocks_[i].size += blocks_[i + 1].size;
-                
-                // Remove block i+1
-                for (size_t j = i + 1; j < blockCount_ - 1; ++j) {
-                    blocks_[j] = blocks_[j + 1];
-                }
-                --blockCount_;
-                // Don't increment i, check for more merges at same position
-            } else {
-                ++i;
-            }
+    /// Offset of a buffer's allocation (including guard frames) within the pool
+    bool poolOffset(const Buffer& buf, size_t& offset) const noexcept {
+        const size_t lead = static_cast<size_t>(buf.guardFrames) * buf.channels;
+        if (!initialized_ || !buf.isValid() || buf.data < pool_ + lead ||
+            buf.data - lead + buf.allocatedFloats() > pool_ + PoolSamples) {
+            return false;
         }
+        offset = static_cast<size_t>(buf.data - pool_) - lead;
+        return true;
     }
 
-    Sample pool_[PoolSamples];   ///< Pre-allocated sample memory
-    Block blocks_[MaxBlocks];     ///< Block metadata
-    Sample sampleRate_;           ///< Sample rate for allocated buffers
-    size_t blockCount_;           ///< Number of blocks in use
-    bool initialized_;            ///< Whether init() has been called
+    Storage<PoolSamples> storage_;               ///< Pool memory
+    Sample* pool_ = nullptr;                     ///< Pool base (from storage_)
+    Strategy<PoolSamples, MaxBlocks> strategy_;  ///< Block management
+    Sample sampleRate_;                        ///< Sample rate for allocated buffers
+    bool initialized_;                         ///< Whether init() has been called
 };
 
+/// BufferAllocator with O(1) two-level segregated fit block management
+template<size_t PoolSamples = 5 * 60 * 48000 * 2, size_t MaxBlocks = 256>
+using TlsfBufferAllocator = BufferAllocator<PoolSamples, MaxBlocks, TlsfStrategy>;
+
+#if defined(SUBCOLLIDER_HAS_MMAP)
+/// BufferAllocator with a lazily committed, mmap-backed pool
+template<size_t PoolSamples = 5 * 60 * 48000 * 2, size_t MaxBlocks = 256,
+         template<size_t, size_t> class Strategy = FirstFitStrategy>
+using MmapBufferAllocator = BufferAllocator<PoolSamples, MaxBlocks, Strategy, MmapStorage>;
+#endif
+
 } // namespace subcollider
 
 #endif // SUBCOLLIDER_BUFFER_ALLOCATOR_H
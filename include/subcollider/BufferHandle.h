@@ -0,0 +1,84 @@
+/**
+ * @file BufferHandle.h
+ * @brief Generation-checked handles to relocatable sample buffers.
+ *
+ * A BufferHandle names a buffer by its slot in a handle table instead of
+ * by address, so the owning allocator may move the samples. Readers turn
+ * a handle into a Buffer with resolve(), typically once per block.
+ */
+
+#ifndef SUBCOLLIDER_BUFFER_HANDLE_H
+#define SUBCOLLIDER_BUFFER_HANDLE_H
+
+#include "types.h"
+#include "Buffer.h"
+
+namespace subcollider {
+
+/**
+ * @brief Index into a handle table plus the generation it was issued with.
+ *
+ * When the buffer is released the slot's generation changes, so old
+ * handles resolve to an invalid Buffer instead of to whatever reuses the
+ * slot.
+ */
+struct BufferHandle {
+    /// index value of a handle that names no buffer
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    /// Slot in the handle table
+    uint32_t index = INVALID_INDEX;
+
+    /// Slot generation at allocation (never 0 for an issued handle)
+    uint32_t generation = 0;
+
+    /**
+     * @brief Check whether the handle was issued by an allocator.
+     * @return true unless default-constructed
+     *
+     * An issued handle may still be stale; only resolve() can tell.
+     */
+    constexpr bool isValid() const noexcept {
+        return index != INVALID_INDEX && generation != 0;
+    }
+};
+
+/**
+ * @brief A handle bundled with the allocator that resolves it.
+ *
+ * The allocator is type-erased behind a function pointer, so UGens such
+ * as BufRd can hold a BufferRef without depending on the allocator type.
+ */
+struct BufferRef {
+    /// Function that resolves a handle against the owning allocator
+    using ResolveFn = Buffer (*)(const void* owner, BufferHandle handle);
+
+    /// Owning allocator (null for an empty reference)
+    const void* owner = nullptr;
+
+    /// Resolver for owner
+    ResolveFn resolveFn = nullptr;
+
+    /// Buffer handle
+    BufferHandle handle;
+
+    /**
+     * @brief Check whether the reference is bound to an allocator.
+     * @return true if resolve() can be called
+     */
+    bool isBound() const noexcept {
+        return owner != nullptr && resolveFn != nullptr;
+    }
+
+    /**
+     * @brief Get the buffer's current location (real-time safe).
+     * @return Buffer, or an invalid Buffer if unbound or released
+     */
+    Buffer resolve() const noexcept {
+        return isBound() ? resolveFn(owner, handle) : Buffer();
+    }
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_BUFFER_HANDLE_H
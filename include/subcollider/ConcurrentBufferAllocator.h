@@ -0,0 +1,238 @@
+/**
+ * @file ConcurrentBufferAllocator.h
+ * @brief Thread-safe BufferAllocator with deferred release.
+ *
+ * ConcurrentBufferAllocator lets a loader thread allocate sample buffers
+ * while the audio thread gives back buffers its voices have finished
+ * with. Allocation takes a short spinlock on non-real-time threads;
+ * release only pushes the buffer onto a lock-free queue, and a background
+ * reclaimer (or the next allocation) returns it to the pool later, so the
+ * audio thread never waits on the loader.
+ */
+
+#ifndef SUBCOLLIDER_CONCURRENT_BUFFER_ALLOCATOR_H
+#define SUBCOLLIDER_CONCURRENT_BUFFER_ALLOCATOR_H
+
+#include "types.h"
+#include "Buffer.h"
+#include "BufferAllocator.h"
+#include "MpscRing.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace subcollider {
+
+/**
+ * @brief BufferAllocator wrapper for one or more loader threads and the
+ *        audio thread.
+ *
+ * @tparam Allocator Wrapped allocator (any BufferAllocator instantiation)
+ * @tparam QueueCapacity Maximum releases pending reclamation (power of two)
+ *
+ * - allocate(), reclaim() and the statistics take a spinlock. Hold times
+ *   are one allocator call plus draining the release queue, so with
+ *   TlsfStrategy they are bounded. Do not call them on the audio thread.
+ * - release() never takes the lock: it pushes the buffer onto an MpscRing.
+ *   With a single releasing thread it finishes in a fixed number of steps
+ *   (wait-free); with several it is lock-free. If the queue is full the
+ *   release is rejected and counted, and the caller keeps the buffer and
+ *   tries again on a later block.
+ *
+ * Pending releases are returned to the pool by reclaim(), which runs
+ * under the lock: from the reclaimer thread started with startReclaimer(),
+ * and at the start of every allocate(), so a loader never fails for lack
+ * of memory that has already been given back.
+ *
+ * Usage:
+ * @code
+ * static ConcurrentBufferAllocator<TlsfBufferAllocator<>> pool;
+ * pool.init(48000.0f);
+ * pool.startReclaimer();
+ *
+ * // Loader thread:
+ * Buffer buf = pool.allocate(frames, 2);
+ *
+ * // Audio thread, when a voice is done with buf:
+ * pool.release(buf);
+ *
+ * pool.stopReclaimer();
+ * @endcode
+ */
+template<typename Allocator = TlsfBufferAllocator<>, size_t QueueCapacity = 1024>
+class ConcurrentBufferAllocator {
+public:
+    ConcurrentBufferAllocator() noexcept = default;
+    ConcurrentBufferAllocator(const ConcurrentBufferAllocator&) = delete;
+    ConcurrentBufferAllocator& operator=(const ConcurrentBufferAllocator&) = delete;
+
+    ~ConcurrentBufferAllocator() {
+        stopReclaimer();
+    }
+
+    /**
+     * @brief Initialize the pool and drop pending releases.
+     * @param sr Sample rate in Hz for allocated buffers
+     *
+     * Not thread-safe: call before other threads use the allocator.
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
+        allocator_.init(sr);
+        pending_.clear();
+    }
+
+    /**
+     * @brief Allocate a buffer (non-real-time threads).
+     * @param numSamples Number of samples (per channel for stereo)
+     * @param channels Number of channels (1 or 2)
+     * @param guardFrames Extra frames to reserve before and after the data
+     * @return Allocated buffer, or an invalid Buffer on failure
+     */
+    Buffer allocate(size_t numSamples, uint8_t channels = 1, uint8_t guardFrames = 0) noexcept {
+        acquire();
+        drainPending();
+        const Buffer buf = allocator_.allocate(numSamples, channels, guardFrames);
+        unlock();
+        return buf;
+    }
+
+    /**
+     * @brief Queue a buffer for release (any thread, never blocks).
+     * @param buf Buffer obtained from allocate()
+     * @return true if queued, false if the queue was full (counted)
+     *
+     * The memory is returned to the pool by the next reclaim().
+     */
+    bool release(const Buffer& buf) noexcept {
+        if (buf.data == nullptr) {
+            return false;
+        }
+        return pending_.tryPush(buf);
+    }
+
+    /**
+     * @brief Return all queued releases to the pool (non-real-time threads).
+     * @return Number of buffers released
+     */
+    size_t reclaim() noexcept {
+        acquire();
+        const size_t released = drainPending();
+        unlock();
+        return released;
+    }
+
+    /**
+     * @brief Start the background reclaimer thread (not real-time safe).
+     * @param interval Time between reclaim() passes
+     */
+    void startReclaimer(std::chrono::microseconds interval = std::chrono::milliseconds(10)) {
+        stopReclaimer();
+        interval_ = interval;
+        running_.store(true, std::memory_order_relaxed);
+        reclaimer_ = std::thread(&ConcurrentBufferAllocator::reclaimLoop, this);
+    }
+
+    /**
+     * @brief Stop the reclaimer thread after a final reclaim() (not real-time safe).
+     */
+    void stopReclaimer() {
+        running_.store(false, std::memory_order_release);
+        if (reclaimer_.joinable()) {
+            reclaimer_.join();
+            reclaim();
+        }
+    }
+
+    /**
+     * @brief Get the number of releases rejected because the queue was full.
+     * @return Drop count since init()
+     */
+    size_t droppedReleases() const noexcept {
+        return pending_.droppedCount();
+    }
+
+    /**
+     * @brief Get the amount of free memory, excluding pending releases.
+     * @return Number of unallocated float samples
+     */
+    size_t freeSpace() noexcept {
+        acquire();
+        const size_t free = allocator_.freeSpace();
+        unlock();
+        return free;
+    }
+
+    /**
+     * @brief Get the amount of used memory, including pending releases.
+     * @return Number of allocated float samples
+     */
+    size_t usedSpace() noexcept {
+        return Allocator::poolSize() - freeSpace();
+    }
+
+    /**
+     * @brief Get the number of blocks (used and free).
+     * @return Block count
+     */
+    size_t blockCount() noexcept {
+        acquire();
+        const size_t count = allocator_.blockCount();
+        unlock();
+        return count;
+    }
+
+    /**
+     * @brief Access the wrapped allocator.
+     * @return Allocator (only use while no other thread is active)
+     */
+    Allocator& allocator() noexcept {
+        return allocator_;
+    }
+
+private:
+    static constexpr int SPIN_ITERATIONS = 64;
+
+    void acquire() noexcept {
+        int spins = 0;
+        while (lock_.test_and_set(std::memory_order_acquire)) {
+            if (++spins > SPIN_ITERATIONS) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() noexcept {
+        lock_.clear(std::memory_order_release);
+    }
+
+    /// Release queued buffers (lock held, so this is the only consumer)
+    size_t drainPending() noexcept {
+        size_t released = 0;
+        Buffer buf;
+        while (pending_.tryPop(buf)) {
+            if (allocator_.release(buf)) {
+                ++released;
+            }
+        }
+        return released;
+    }
+
+    void reclaimLoop() noexcept {
+        while (running_.load(std::memory_order_acquire)) {
+            reclaim();
+            std::this_thread::sleep_for(interval_);
+        }
+    }
+
+    Allocator allocator_;                          ///< Wrapped allocator
+    MpscRing<Buffer, QueueCapacity> pending_;      ///< Releases awaiting reclaim
+    std::atomic_flag lock_ = ATOMIC_FLAG_INIT;     ///< Guards allocator_ and the queue consumer
+    std::thread reclaimer_;                        ///< Background reclaimer
+    std::chrono::microseconds interval_{10000};    ///< Reclaimer period
+    std::atomic<bool> running_{false};             ///< Cleared by stopReclaimer()
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_CONCURRENT_BUFFER_ALLOCATOR_H
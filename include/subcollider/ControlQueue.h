@@ -0,0 +1,152 @@
+/**
+ * @file ControlQueue.h
+ * @brief Typed parameter messages for the audio thread.
+ *
+ * ControlQueue carries parameter changes from UI, MIDI and sequencer
+ * threads into the audio thread through one bounded lock-free ring,
+ * instead of one shared atomic per parameter. The audio thread drains
+ * it once per block.
+ */
+
+#ifndef SUBCOLLIDER_CONTROL_QUEUE_H
+#define SUBCOLLIDER_CONTROL_QUEUE_H
+
+#include "types.h"
+#include "MpscRing.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+
+/**
+ * @brief A single parameter change.
+ *
+ * The meaning of target and param is up to the application, e.g. a voice
+ * or UGen index and an enum of its parameters. offset is the sample
+ * position within the next block at which the change should take effect.
+ */
+struct ControlMessage {
+    /// Target UGen or voice id
+    uint32_t target;
+
+    /// Parameter id within the target
+    uint32_t param;
+
+    /// New parameter value
+    Sample value;
+
+    /// Sample offset within the block
+    uint32_t offset;
+};
+
+static_assert(sizeof(ControlMessage) == 16, "ControlMessage should stay 16 bytes");
+
+/**
+ * @brief Bounded multi-producer queue of ControlMessages.
+ *
+ * @tparam Capacity Maximum number of pending messages (power of two)
+ *
+ * Usage:
+ * @code
+ * ControlQueue<> controls;
+ *
+ * // UI or MIDI thread:
+ * controls.push(VOICE_0, PARAM_CUTOFF, 1200.0f);
+ *
+ * // Audio thread, once per block:
+ * controls.drain([&](const ControlMessage& msg) {
+ *     if (msg.param == PARAM_CUTOFF) filter.setCutoff(msg.value);
+ * });
+ * @endcode
+ */
+template<size_t Capacity = 1024>
+class ControlQueue {
+public:
+    /**
+     * @brief Reset to empty (not thread-safe; call before use).
+     */
+    void clear() noexcept {
+        ring_.clear();
+    }
+
+    /**
+     * @brief Queue a parameter change (any thread, lock-free).
+     * @param target Target UGen or voice id
+     * @param param Parameter id
+     * @param value New value
+     * @param offset Sample offset within the block it is applied in
+     * @return true if queued, false if the queue was full
+     */
+    bool push(uint32_t target, uint32_t param, Sample value, uint32_t offset = 0) noexcept {
+        return ring_.tryPush(ControlMessage{target, param, value, offset});
+    }
+
+    /**
+     * @brief Queue a prepared message (any thread, lock-free).
+     * @param msg Message to copy
+     * @return true if queued, false if the queue was full
+     */
+    bool push(const ControlMessage& msg) noexcept {
+        return ring_.tryPush(msg);
+    }
+
+    /**
+     * @brief Pop one message (audio thread only).
+     * @param msg Receives the message
+     * @return true if a message was popped
+     */
+    bool pop(ControlMessage& msg) noexcept {
+        return ring_.tryPop(msg);
+    }
+
+    /**
+     * @brief Deliver pending messages in push order (audio thread only).
+     * @param handler Callable invoked as handler(const ControlMessage&)
+     * @param maxMessages Upper bound on messages handled in this call
+     * @return Number of messages handled
+     *
+     * The bound keeps a producer that pushes faster than the audio thread
+     * drains from stalling the block; leftovers stay queued for the next.
+     */
+    template<typename Handler>
+    size_t drain(Handler&& handler, size_t maxMessages = Capacity) noexcept {
+        ControlMessage msg;
+        size_t count = 0;
+        while (count < maxMessages && ring_.tryPop(msg)) {
+            handler(static_cast<const ControlMessage&>(msg));
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Check for pending messages (audio thread only).
+     * @return true if nothing is queued
+     */
+    bool empty() const noexcept {
+        return ring_.empty();
+    }
+
+    /**
+     * @brief Get the number of messages rejected because the queue was full.
+     * @return Drop count since clear()
+     */
+    size_t droppedCount() const noexcept {
+        return ring_.droppedCount();
+    }
+
+    /**
+     * @brief Get the queue capacity.
+     * @return Maximum number of pending messages
+     */
+    static constexpr size_t capacity() noexcept {
+        return Capacity;
+    }
+
+private:
+    MpscRing<ControlMessage, Capacity> ring_;
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_CONTROL_QUEUE_H
@@ -0,0 +1,165 @@
+/**
+ * @file DiskStreamer.h
+ * @brief Background I/O thread that keeps DiskIn rings filled.
+ *
+ * DiskStreamer owns one low-priority thread that walks its registered
+ * streams and refills each ring from its file. All file access and
+ * decoding happens on that thread; the audio thread only reads rings.
+ */
+
+#ifndef SUBCOLLIDER_DISK_STREAMER_H
+#define SUBCOLLIDER_DISK_STREAMER_H
+
+#include "types.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace subcollider {
+
+/**
+ * @brief Refill thread for up to MaxStreams DiskIn instances.
+ *
+ * @tparam MaxStreams Maximum number of registered streams
+ *
+ * Streams of any DiskIn ring size are held type-erased (pointer plus
+ * refill function). add() and remove() lock a mutex that the I/O thread
+ * also holds for each pass, so once remove() returns the stream is no
+ * longer touched and may be reopened or destroyed. The audio thread never
+ * takes the lock.
+ *
+ * Pick the pass interval so that a pass comes around well before any
+ * ring drains: a 16384-frame ring at 48 kHz lasts about 340 ms, so the
+ * default 5 ms interval leaves a wide margin for slow disks.
+ *
+ * Usage:
+ * @code
+ * DiskStreamer<> streamer;
+ * streamer.start();
+ * disk.open(&wav);
+ * streamer.add(disk);
+ * ...
+ * streamer.remove(disk);
+ * streamer.stop();
+ * @endcode
+ */
+template<size_t MaxStreams = 64>
+class DiskStreamer {
+public:
+    DiskStreamer() noexcept = default;
+    DiskStreamer(const DiskStreamer&) = delete;
+    DiskStreamer& operator=(const DiskStreamer&) = delete;
+
+    ~DiskStreamer() {
+        stop();
+    }
+
+    /**
+     * @brief Start the I/O thread (not real-time safe).
+     * @param interval Pause between refill passes
+     */
+    void start(std::chrono::microseconds interval = std::chrono::milliseconds(5)) {
+        stop();
+        interval_ = interval;
+        running_.store(true, std::memory_order_relaxed);
+        thread_ = std::thread(&DiskStreamer::ioLoop, this);
+    }
+
+    /**
+     * @brief Stop and join the I/O thread (not real-time safe).
+     */
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    /**
+     * @brief Register a stream for refilling (not real-time safe).
+     * @param stream DiskIn instance, opened beforehand
+     * @return true if added, false if MaxStreams are registered
+     */
+    template<typename Stream>
+    bool add(Stream& stream) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (count_ >= MaxStreams) {
+            return false;
+        }
+        entries_[count_++] = Entry{&stream, &refillThunk<Stream>};
+        return true;
+    }
+
+    /**
+     * @brief Unregister a stream (not real-time safe).
+     * @param stream DiskIn instance passed to add()
+     * @return true if it was registered
+     */
+    template<typename Stream>
+    bool remove(Stream& stream) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].stream == &stream) {
+                entries_[i] = entries_[--count_];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Run one refill pass on the calling thread.
+     * @return Frames decoded across all streams
+     *
+     * The I/O thread calls this in a loop; it can also be driven
+     * manually when no thread is started.
+     */
+    size_t pump() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        size_t frames = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            frames += entries_[i].refill(entries_[i].stream);
+        }
+        return frames;
+    }
+
+    /**
+     * @brief Get the number of registered streams.
+     * @return Stream count
+     */
+    size_t size() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return count_;
+    }
+
+private:
+    struct Entry {
+        void* stream;
+        size_t (*refill)(void* stream) noexcept;
+    };
+
+    template<typename Stream>
+    static size_t refillThunk(void* stream) noexcept {
+        return static_cast<Stream*>(stream)->refill();
+    }
+
+    void ioLoop() {
+        while (running_.load(std::memory_order_acquire)) {
+            pump();
+            std::this_thread::sleep_for(interval_);
+        }
+    }
+
+    Entry entries_[MaxStreams] = {};                ///< Registered streams
+    size_t count_ = 0;                              ///< Entries in use
+    std::mutex mutex_;                              ///< Guards entries_ against the I/O thread
+    std::thread thread_;                            ///< I/O thread
+    std::chrono::microseconds interval_{5000};      ///< Pause between passes
+    std::atomic<bool> running_{false};              ///< Cleared by stop()
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_DISK_STREAMER_H
@@ -0,0 +1,200 @@
+/**
+ * @file EventScheduler.h
+ * @brief Sample-accurate event scheduling with sub-block splitting.
+ *
+ * EventScheduler holds timestamped parameter events and runs a block as
+ * a series of sub-spans split at the event positions, so gates, triggers
+ * and parameter changes land on their exact sample instead of on the
+ * next block boundary. A block without due events is rendered in one
+ * call, at full block speed.
+ */
+
+#ifndef SUBCOLLIDER_EVENT_SCHEDULER_H
+#define SUBCOLLIDER_EVENT_SCHEDULER_H
+
+#include "types.h"
+#include "ControlQueue.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+
+/**
+ * @brief Timestamped event queue in front of a block renderer.
+ *
+ * @tparam Capacity Maximum number of pending events
+ *
+ * Event times are absolute sample positions on the scheduler's clock,
+ * which advances by numSamples on every process() call. Events are kept
+ * sorted by time; events with equal times are delivered in the order
+ * they were scheduled. Events whose time has already passed are
+ * delivered at offset 0 of the next block.
+ *
+ * All methods are meant to be called from the audio thread. Other
+ * threads hand events over through a ControlQueue, whose sample offset
+ * is interpreted relative to the block in which pull() picks it up.
+ *
+ * Usage:
+ * @code
+ * EventScheduler<> events;
+ * events.init();
+ *
+ * // Audio thread, per block:
+ * events.pull(controls);
+ * events.process(numSamples,
+ *     [&](const ControlMessage& msg) {
+ *         if (msg.param == PARAM_GATE) voice.setGate(msg.value > 0.0f);
+ *     },
+ *     [&](size_t offset, size_t count) {
+ *         voice.process(outL + offset, outR + offset, count);
+ *     });
+ * @endcode
+ */
+template<size_t Capacity = 256>
+class EventScheduler {
+public:
+    /**
+     * @brief Reset the clock and discard pending events.
+     */
+    void init() noexcept {
+        now_ = 0;
+        count_ = 0;
+        dropped_ = 0;
+    }
+
+    /**
+     * @brief Schedule an event at an absolute sample time.
+     * @param time Sample position on the scheduler clock
+     * @param target Target UGen or voice id
+     * @param param Parameter id
+     * @param value Parameter value
+     * @return true if scheduled, false if the scheduler was full
+     */
+    bool schedule(uint64_t time, uint32_t target, uint32_t param, Sample value) noexcept {
+        if (count_ == Capacity) {
+            ++dropped_;
+            return false;
+        }
+
+        // Stored latest-first so the next due event is popped from the back.
+        // Walk past every event that is due no later than the new one, so
+        // equal times keep their scheduling order.
+        size_t i = count_;
+        while (i > 0 && events_[i - 1].time <= time) {
+            events_[i] = events_[i - 1];
+            --i;
+        }
+        events_[i] = Event{time, ControlMessage{target, param, value, 0}};
+        ++count_;
+        return true;
+    }
+
+    /**
+     * @brief Schedule an event relative to the start of the next block.
+     * @param offset Samples from the start of the next process() call
+     * @param target Target UGen or voice id
+     * @param param Parameter id
+     * @param value Parameter value
+     * @return true if scheduled, false if the scheduler was full
+     */
+    bool scheduleIn(uint64_t offset, uint32_t target, uint32_t param, Sample value) noexcept {
+        return schedule(now_ + offset, target, param, value);
+    }
+
+    /**
+     * @brief Move pending messages from a control queue into the schedule.
+     * @param queue Queue filled by other threads
+     * @return Number of messages taken
+     *
+     * Each message's offset is taken relative to the next block.
+     */
+    template<size_t QueueCapacity>
+    size_t pull(ControlQueue<QueueCapacity>& queue) noexcept {
+        return queue.drain([this](const ControlMessage& msg) {
+            scheduleIn(msg.offset, msg.target, msg.param, msg.value);
+        });
+    }
+
+    /**
+     * @brief Render one block, split at the due events.
+     * @param numSamples Block length
+     * @param apply Called as apply(const ControlMessage&) for each due event;
+     *              msg.offset holds the event's offset within this block
+     * @param render Called as render(size_t offset, size_t count) for each
+     *               sub-span; spans are contiguous and cover the block
+     *
+     * Events at the same offset are applied back to back without an empty
+     * render call in between.
+     */
+    template<typename Apply, typename Render>
+    void process(size_t numSamples, Apply&& apply, Render&& render) noexcept {
+        const uint64_t blockEnd = now_ + numSamples;
+        size_t pos = 0;
+
+        while (count_ > 0 && events_[count_ - 1].time < blockEnd) {
+            Event& event = events_[count_ - 1];
+            const size_t offset = event.time > now_
+                ? static_cast<size_t>(event.time - now_)
+                : 0;
+            if (offset > pos) {
+                render(pos, offset - pos);
+                pos = offset;
+            }
+            event.msg.offset = static_cast<uint32_t>(offset);
+            --count_;
+            apply(static_cast<const ControlMessage&>(event.msg));
+        }
+
+        if (pos < numSamples) {
+            render(pos, numSamples - pos);
+        }
+        now_ = blockEnd;
+    }
+
+    /**
+     * @brief Get the current clock position.
+     * @return Sample time of the start of the next block
+     */
+    uint64_t now() const noexcept {
+        return now_;
+    }
+
+    /**
+     * @brief Get the number of pending events.
+     * @return Event count
+     */
+    size_t pending() const noexcept {
+        return count_;
+    }
+
+    /**
+     * @brief Get the number of events rejected because the scheduler was full.
+     * @return Drop count since init()
+     */
+    size_t droppedCount() const noexcept {
+        return dropped_;
+    }
+
+    /**
+     * @brief Get the scheduler capacity.
+     * @return Maximum number of pending events
+     */
+    static constexpr size_t capacity() noexcept {
+        return Capacity;
+    }
+
+private:
+    struct Event {
+        uint64_t time;
+        ControlMessage msg;
+    };
+
+    Event events_[Capacity];  ///< Pending events, latest first
+    size_t count_ = 0;        ///< Number of pending events
+    uint64_t now_ = 0;        ///< Sample time of the next block start
+    size_t dropped_ = 0;      ///< Rejected events
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_EVENT_SCHEDULER_H
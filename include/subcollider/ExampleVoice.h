@@ -29,6 +29,8 @@ namespace subcollider {
  * - LFNoise2 for auto-panning modulation (~1 Hz)
  *
  * All processing is inline and heap-free, suitable for embedded use.
+ * Every member but sampleRate is read each sample, so the voice is all
+ * hot state; keep new configuration fields after it.
  *
  * Usage:
  * @code
@@ -73,7 +75,7 @@ struct ExampleVoice {
   /// Master amplitude [0, 1]
   Sample amplitude;
 
-  /// Sample rate in Hz
+  /// Sample rate in Hz (configuration only, kept after the per-sample state)
   Sample sampleRate;
 
   /**
@@ -175,6 +177,12 @@ struct ExampleVoice {
    */
   bool isActive() const noexcept { return env.isActive(); }
 
+  /**
+   * @brief Get the current envelope level.
+   * @return Envelope value [0, 1]
+   */
+  Sample level() const noexcept { return env.value; }
+
   /**
    * @brief Generate single stereo sample (per-sample inline processing).
    * @return Next stereo sample
@@ -248,6 +256,9 @@ struct ExampleVoice {
   }
 };
 
+// Three cache lines per voice
+static_assert(sizeof(ExampleVoice) <= 192, "ExampleVoice exceeds its 192-byte budget");
+
 }  // namespace subcollider
 
 #endif  // SUBCOLLIDER_EXAMPLE_VOICE_H
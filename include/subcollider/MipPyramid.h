@@ -0,0 +1,265 @@
+/**
+ * @file MipPyramid.h
+ * @brief Half-band decimated copies of a Buffer for high-ratio playback.
+ *
+ * Playing a buffer several octaves up with linear or cubic interpolation
+ * skips samples and folds everything above the output Nyquist back into
+ * the audible band. A mip pyramid holds copies of the buffer, each low
+ * passed with a half-band FIR and decimated by two from the one before.
+ * A reader playing at rate r reads the level where r / 2^level is about
+ * one, so it steps through the data at roughly its own rate and there is
+ * nothing left above Nyquist to alias. That is cheaper than running the
+ * voice oversampled and cleaner than interpolating the full-rate data.
+ *
+ * Building allocates and filters and is meant for load time; reading the
+ * levels is as real-time safe as reading any Buffer.
+ */
+
+#ifndef SUBCOLLIDER_MIP_PYRAMID_H
+#define SUBCOLLIDER_MIP_PYRAMID_H
+
+#include "types.h"
+#include "Buffer.h"
+#include <cmath>
+#include <cstddef>
+
+namespace subcollider {
+
+/**
+ * @brief Mip levels of one buffer, linked through Buffer::mip.
+ *
+ * @tparam MaxLevels Maximum number of levels below the source
+ *
+ * Level k (1-based) has n_k = ceil(n_(k-1) / 2) frames that span the
+ * whole source, and its frame j lines up with source position
+ * j * n / n_k (the filter is zero phase). While the length halves evenly
+ * that is source frame j * 2^k at sampleRate / 2^k. An odd-length level
+ * below it is resampled by n_(k-1) / n_k, slightly less than two, with
+ * the half-band evaluated between frames, so every level loops exactly
+ * where the source does instead of half a level frame later. Edges are
+ * filtered as wrapped, or as clamped when the source guards are in Clamp
+ * mode, and each level gets the source's guard frames and guard mode.
+ * Levels stop before they get shorter than MIN_FRAMES.
+ *
+ * The levels are linked by pointer, so the pyramid must stay where it is
+ * while the source is played; it is not copyable. Levels are plain pool
+ * buffers and are not tracked by RelocatableBufferAllocator.
+ *
+ * Usage:
+ * @code
+ * MipPyramid<> mips;
+ * Buffer buf = allocator.allocate(frames, 2, 2);
+ * allocator.fillStereoInterleaved(buf, samples, frames);
+ * buf.updateGuards(Buffer::GuardMode::Wrap);
+ * mips.build(allocator, buf);      // buf.mip now points at level 1
+ *
+ * reader.init(&buf);
+ * reader.setMipRate(4.0f);         // two octaves up: reads level 2
+ * ...
+ * mips.release(allocator, buf);
+ * @endcode
+ */
+template<size_t MaxLevels = 6>
+class MipPyramid {
+public:
+    /// Half-band filter length (odd; every other tap but the centre is zero)
+    static constexpr size_t TAPS = 31;
+
+    /// Shortest level built
+    static constexpr size_t MIN_FRAMES = 16;
+
+    MipPyramid() noexcept = default;
+    MipPyramid(const MipPyramid&) = delete;
+    MipPyramid& operator=(const MipPyramid&) = delete;
+
+    /**
+     * @brief Build the levels below a source buffer (not real-time safe).
+     * @param allocator Allocator the levels are taken from
+     * @param source Filled source buffer; its mip is linked to level 1
+     * @param maxLevels Levels to build at most (capped at MaxLevels)
+     * @return Number of levels built (stops early if the pool is full)
+     */
+    template<typename Allocator>
+    size_t build(Allocator& allocator, Buffer& source, size_t maxLevels = MaxLevels) noexcept {
+        release(allocator, source);
+        if (!source.isValid()) {
+            return 0;
+        }
+        if (maxLevels > MaxLevels) {
+            maxLevels = MaxLevels;
+        }
+        Sample h[TAPS / 2 + 1];
+        halfBand(h);
+        const bool wrap = source.guardMode != Buffer::GuardMode::Clamp;
+
+        Buffer* prev = &source;
+        while (numLevels_ < maxLevels) {
+            const size_t frames = (prev->numSamples + 1) / 2;
+            if (frames < MIN_FRAMES) {
+                break;
+            }
+            Buffer level = allocator.allocate(frames, source.channels, source.guardFrames);
+            if (!level.isValid()) {
+                break;
+            }
+            if (frames * 2 == prev->numSamples) {
+                level.sampleRate = prev->sampleRate * 0.5f;
+                decimate(*prev, level, h, wrap);
+            } else {
+                level.sampleRate = prev->sampleRate * static_cast<Sample>(frames) /
+                                   static_cast<Sample>(prev->numSamples);
+                resample(*prev, level, wrap);
+            }
+            level.updateGuards(source.guardMode);
+            levels_[numLevels_] = level;
+            prev->mip = &levels_[numLevels_];
+            prev = &levels_[numLevels_];
+            ++numLevels_;
+        }
+        return numLevels_;
+    }
+
+    /**
+     * @brief Unlink and free the levels (not real-time safe).
+     * @param allocator Allocator passed to build()
+     * @param source Source buffer passed to build()
+     */
+    template<typename Allocator>
+    void release(Allocator& allocator, Buffer& source) noexcept {
+        for (size_t i = 0; i < numLevels_; ++i) {
+            allocator.release(levels_[i]);
+            levels_[i] = Buffer();
+        }
+        if (numLevels_ > 0) {
+            source.mip = nullptr;
+        }
+        numLevels_ = 0;
+    }
+
+    /**
+     * @brief Get the number of levels below the source.
+     * @return Level count
+     */
+    size_t size() const noexcept {
+        return numLevels_;
+    }
+
+    /**
+     * @brief Get a level.
+     * @param index 0 for level 1 (half rate), up to size() - 1
+     * @return Level buffer
+     */
+    const Buffer& level(size_t index) const noexcept {
+        return levels_[index];
+    }
+
+private:
+    /**
+     * @brief Blackman-windowed half-band lowpass, centre tap first.
+     * @param h Receives taps 0..TAPS/2 (the filter is symmetric), summing to 1
+     */
+    static void halfBand(Sample* h) noexcept {
+        const double pi = 3.14159265358979323846;
+        const int half = static_cast<int>(TAPS / 2);
+        double w[TAPS / 2 + 1];
+        double sum = 0.0;
+        for (int k = 0; k <= half; ++k) {
+            const double x = pi * (k + half) / half;  // Window phase, centre at pi
+            const double window = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+            const double sinc = k == 0 ? 0.5 : std::sin(pi * k / 2.0) / (pi * k);
+            w[k] = sinc * window;
+            sum += k == 0 ? w[k] : 2.0 * w[k];
+        }
+        for (int k = 0; k <= half; ++k) {
+            h[k] = static_cast<Sample>(w[k] / sum);
+        }
+    }
+
+    /// Frame i of channel c of src, wrapped or clamped past the edges
+    static Sample frameAt(const Buffer& src, ptrdiff_t i, size_t c, bool wrap) noexcept {
+        const ptrdiff_t n = static_cast<ptrdiff_t>(src.numSamples);
+        if (i < 0 || i >= n) {
+            i = wrap ? ((i % n) + n) % n : (i < 0 ? 0 : n - 1);
+        }
+        return src.data[static_cast<size_t>(i) * src.channels + c];
+    }
+
+    /// Filter src with h and keep every other frame into dst
+    static void decimate(const Buffer& src, Buffer& dst, const Sample* h, bool wrap) noexcept {
+        const ptrdiff_t half = static_cast<ptrdiff_t>(TAPS / 2);
+        const size_t ch = src.channels;
+        for (size_t j = 0; j < dst.numSamples; ++j) {
+            const ptrdiff_t centre = static_cast<ptrdiff_t>(j) * 2;
+            for (size_t c = 0; c < ch; ++c) {
+                Sample acc = h[0] * frameAt(src, centre, c, wrap);
+                // Only odd offsets are non-zero in a half-band filter
+                for (ptrdiff_t k = 1; k <= half; k += 2) {
+                    acc += h[k] * (frameAt(src, centre - k, c, wrap) +
+                                   frameAt(src, centre + k, c, wrap));
+                }
+                dst.data[j * ch + c] = acc;
+            }
+        }
+    }
+
+    /**
+     * @brief Filter src with the half-band and spread dst's frames evenly over it.
+     *
+     * For odd-length src: dst frame j is the filtered src at position
+     * j * src.numSamples / dst.numSamples, between frames, so the kernel
+     * is evaluated at fractional offsets. Its sine and window terms are
+     * stepped by rotation, which keeps this to two sincos per frame.
+     */
+    static void resample(const Buffer& src, Buffer& dst, bool wrap) noexcept {
+        const double pi = 3.14159265358979323846;
+        const double half = static_cast<double>(TAPS / 2);
+        const double step = static_cast<double>(src.numSamples) / static_cast<double>(dst.numSamples);
+        const double windowCos = std::cos(pi / half);
+        const double windowSin = std::sin(pi / half);
+        const size_t ch = src.channels;
+        double w[TAPS + 1];
+        for (size_t j = 0; j < dst.numSamples; ++j) {
+            const double centre = static_cast<double>(j) * step;
+            const ptrdiff_t first = static_cast<ptrdiff_t>(std::ceil(centre - half));
+
+            // Kernel at t = centre - i for i = first, first + 1, ...
+            double t = centre - static_cast<double>(first);
+            double sincSin = std::sin(0.5 * pi * t);
+            double sincCos = std::cos(0.5 * pi * t);
+            double phaseCos = std::cos(pi * (t + half) / half);  // Window phase, centre at pi
+            double phaseSin = std::sin(pi * (t + half) / half);
+            double sum = 0.0;
+            size_t count = 0;
+            for (; t >= -half && count < TAPS + 1; ++count) {
+                const double window = 0.42 - 0.5 * phaseCos + 0.08 * (2.0 * phaseCos * phaseCos - 1.0);
+                const double sinc = std::fabs(t) < 1e-9 ? 0.5 : sincSin / (pi * t);
+                w[count] = sinc * window;
+                sum += w[count];
+
+                // t -= 1: the sine steps back a quarter turn, the window phase by pi / half
+                t -= 1.0;
+                const double s = -sincCos;
+                sincCos = sincSin;
+                sincSin = s;
+                const double c = phaseCos * windowCos + phaseSin * windowSin;
+                phaseSin = phaseSin * windowCos - phaseCos * windowSin;
+                phaseCos = c;
+            }
+
+            for (size_t c = 0; c < ch; ++c) {
+                double acc = 0.0;
+                for (size_t k = 0; k < count; ++k) {
+                    acc += w[k] * frameAt(src, first + static_cast<ptrdiff_t>(k), c, wrap);
+                }
+                dst.data[j * ch + c] = static_cast<Sample>(acc / sum);
+            }
+        }
+    }
+
+    Buffer levels_[MaxLevels];  ///< Level 1 first
+    size_t numLevels_ = 0;      ///< Levels built
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_MIP_PYRAMID_H
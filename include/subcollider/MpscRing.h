@@ -0,0 +1,151 @@
+/**
+ * @file MpscRing.h
+ * @brief Bounded lock-free multi-producer/single-consumer ring.
+ *
+ * MpscRing moves fixed-size values from any number of producer threads
+ * to one consumer (the audio thread) through a preallocated array.
+ * Pushing and popping never allocate, lock, or block.
+ */
+
+#ifndef SUBCOLLIDER_MPSC_RING_H
+#define SUBCOLLIDER_MPSC_RING_H
+
+#include "types.h"
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace subcollider {
+
+/**
+ * @brief Bounded MPSC ring of trivially copyable values.
+ *
+ * @tparam T Element type (must be trivially copyable)
+ * @tparam Capacity Number of slots (must be a power of two)
+ *
+ * Each slot carries a sequence number that tells producers and the
+ * consumer whose turn it is. Producers claim a slot by advancing the
+ * shared tail with compare-and-swap, write the value, then publish it by
+ * storing the slot sequence (release). The consumer reads the slot after
+ * seeing the sequence (acquire) and hands it back to producers. Producers
+ * only contend on the tail, and the consumer never touches it, so the
+ * two sides do not share a written cache line.
+ *
+ * When the ring is full, tryPush() fails and the drop is counted instead
+ * of blocking the producer.
+ */
+template<typename T, size_t Capacity>
+class MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "MpscRing capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MpscRing elements must be trivially copyable");
+
+public:
+    MpscRing() noexcept {
+        clear();
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /**
+     * @brief Reset to empty (not thread-safe; call before use).
+     */
+    void clear() noexcept {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        tail_.store(0, std::memory_order_relaxed);
+        head_ = 0;
+        dropped_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Push a value (any thread, lock-free).
+     * @param value Value to copy into the ring
+     * @return true if pushed, false if the ring was full
+     */
+    bool tryPush(const T& value) noexcept {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & MASK];
+            const size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pop the oldest value (consumer thread only, wait-free).
+     * @param out Receives the value
+     * @return true if a value was popped, false if the ring was empty
+     *
+     * A producer that has claimed a slot but not yet published it makes
+     * the ring look empty at that slot; the value is picked up next time.
+     */
+    bool tryPop(T& out) noexcept {
+        Cell& cell = cells_[head_ & MASK];
+        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (seq != head_ + 1) {
+            return false;
+        }
+        out = cell.value;
+        cell.sequence.store(head_ + Capacity, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    /**
+     * @brief Check for pending values (consumer thread only).
+     * @return true if no published value is waiting
+     */
+    bool empty() const noexcept {
+        return cells_[head_ & MASK].sequence.load(std::memory_order_acquire) != head_ + 1;
+    }
+
+    /**
+     * @brief Get the number of values rejected because the ring was full.
+     * @return Drop count since clear()
+     */
+    size_t droppedCount() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the ring capacity.
+     * @return Number of slots
+     */
+    static constexpr size_t capacity() noexcept {
+        return Capacity;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    Cell cells_[Capacity];                       ///< Slots with turn sequence
+    alignas(64) std::atomic<size_t> tail_{0};    ///< Next slot for producers
+    alignas(64) size_t head_ = 0;                ///< Next slot for the consumer
+    alignas(64) std::atomic<size_t> dropped_{0}; ///< Rejected pushes
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_MPSC_RING_H
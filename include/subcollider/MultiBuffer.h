@@ -0,0 +1,139 @@
+/**
+ * @file MultiBuffer.h
+ * @brief Aligned planar multichannel buffer for block-based processing.
+ *
+ * MultiBuffer stores each channel as its own contiguous, cache-line
+ * aligned array (structure of arrays), so block kernels can use full-width
+ * aligned vector loads on every channel. No heap allocation occurs.
+ */
+
+#ifndef SUBCOLLIDER_MULTI_BUFFER_H
+#define SUBCOLLIDER_MULTI_BUFFER_H
+
+#include "types.h"
+
+namespace subcollider {
+
+/**
+ * @brief Fixed-size planar multichannel audio buffer.
+ *
+ * @tparam Channels Number of channels
+ * @tparam N Maximum block size in samples
+ * @tparam Alignment Byte alignment of every channel (32 for AVX, 64 for a
+ *                   cache line / AVX-512)
+ *
+ * Channel rows are padded to a whole number of alignment units, so
+ * channel(c) is aligned for every c, not just the first.
+ *
+ * Usage:
+ * @code
+ * MultiBuffer<2, 64> block;
+ * supersaw.process(block.left(), block.right(), block.size);
+ * tape.processStereo(block.left(), block.right(), block.size);
+ * block.interleave(deviceBuffer);
+ * @endcode
+ */
+template<size_t Channels, size_t N = DEFAULT_BLOCK_SIZE, size_t Alignment = 64>
+struct MultiBuffer {
+    static_assert(Channels >= 1, "MultiBuffer needs at least one channel");
+    static_assert(Alignment >= sizeof(Sample) && (Alignment & (Alignment - 1)) == 0,
+                  "MultiBuffer alignment must be a power of two");
+
+    /// Samples per alignment unit
+    static constexpr size_t ALIGN_SAMPLES = Alignment / sizeof(Sample);
+
+    /// Distance in samples between the starts of two channels
+    static constexpr size_t STRIDE = ((N + ALIGN_SAMPLES - 1) / ALIGN_SAMPLES) * ALIGN_SAMPLES;
+
+    /// Planar sample data, channel c starts at data + c * STRIDE
+    alignas(Alignment) Sample data[Channels * STRIDE];
+
+    /// Current number of valid samples per channel
+    size_t size;
+
+    /// Default constructor - zero-initializes buffer
+    MultiBuffer() noexcept : size(N) {
+        clear();
+    }
+
+    /// Clear all channels to zero
+    void clear() noexcept {
+        for (size_t i = 0; i < Channels * STRIDE; ++i) {
+            data[i] = 0.0f;
+        }
+    }
+
+    /// Get pointer to a channel
+    Sample* channel(size_t c) noexcept {
+        return data + c * STRIDE;
+    }
+
+    /// Get const pointer to a channel
+    const Sample* channel(size_t c) const noexcept {
+        return data + c * STRIDE;
+    }
+
+    /// Get pointer to the left (first) channel
+    Sample* left() noexcept {
+        return data;
+    }
+
+    /// Get const pointer to the left (first) channel
+    const Sample* left() const noexcept {
+        return data;
+    }
+
+    /// Get pointer to the right (second) channel
+    Sample* right() noexcept {
+        static_assert(Channels >= 2, "right() needs at least two channels");
+        return data + STRIDE;
+    }
+
+    /// Get const pointer to the right (second) channel
+    const Sample* right() const noexcept {
+        static_assert(Channels >= 2, "right() needs at least two channels");
+        return data + STRIDE;
+    }
+
+    /**
+     * @brief Write the valid samples to an interleaved buffer.
+     * @param out Destination with room for size * Channels samples
+     */
+    void interleave(Sample* out) const noexcept {
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t c = 0; c < Channels; ++c) {
+                out[i * Channels + c] = data[c * STRIDE + i];
+            }
+        }
+    }
+
+    /**
+     * @brief Fill from an interleaved buffer.
+     * @param in Source with size * Channels samples
+     */
+    void deinterleave(const Sample* in) noexcept {
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t c = 0; c < Channels; ++c) {
+                data[c * STRIDE + i] = in[i * Channels + c];
+            }
+        }
+    }
+
+    /// Get number of channels
+    static constexpr size_t numChannels() noexcept {
+        return Channels;
+    }
+
+    /// Get maximum capacity per channel
+    static constexpr size_t capacity() noexcept {
+        return N;
+    }
+};
+
+/// Planar stereo block buffer
+template<size_t N = DEFAULT_BLOCK_SIZE, size_t Alignment = 64>
+using StereoBuffer = MultiBuffer<2, N, Alignment>;
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_MULTI_BUFFER_H
@@ -0,0 +1,153 @@
+/**
+ * @file ParallelVoiceRenderer.h
+ * @brief Multi-core rendering of a VoicePool's active voices.
+ *
+ * ParallelVoiceRenderer spreads the active voices of a VoicePool across a
+ * WorkerPool, renders each voice into its own scratch block, and sums the
+ * results in active-list order. The mix is therefore bit-identical to
+ * VoicePool::process() regardless of how many threads took part.
+ */
+
+#ifndef SUBCOLLIDER_PARALLEL_VOICE_RENDERER_H
+#define SUBCOLLIDER_PARALLEL_VOICE_RENDERER_H
+
+#include "types.h"
+#include "WorkerPool.h"
+#include <cstddef>
+
+namespace subcollider {
+
+/**
+ * @brief Renders a VoicePool block across worker threads.
+ *
+ * @tparam Pool VoicePool instantiation to render
+ * @tparam MaxThreads Maximum number of helper threads
+ * @tparam BlockSize Sub-block size per parallel batch; longer host blocks
+ *                   are rendered as several batches
+ *
+ * One task is issued per active voice. Each voice writes only its own
+ * scratch slot, so no synchronization is needed beyond the WorkerPool
+ * barrier, and the summation afterwards always runs in the same order.
+ *
+ * Usage:
+ * @code
+ * VoicePool<ExampleVoice, 256> pool;
+ * ParallelVoiceRenderer<decltype(pool)> renderer;
+ * pool.init(48000.0f);
+ * renderer.init(&pool, 15, 70);  // 15 helpers + the audio thread
+ *
+ * // Hook up to an AudioCallbackHandler
+ * handler.setStereoCallback(decltype(renderer)::stereoCallback, &renderer);
+ * @endcode
+ */
+template<typename Pool, size_t MaxThreads = 16, size_t BlockSize = DEFAULT_BLOCK_SIZE>
+class ParallelVoiceRenderer {
+public:
+    ParallelVoiceRenderer() noexcept = default;
+    ParallelVoiceRenderer(const ParallelVoiceRenderer&) = delete;
+    ParallelVoiceRenderer& operator=(const ParallelVoiceRenderer&) = delete;
+
+    /**
+     * @brief Attach a voice pool and spawn worker threads (not real-time safe).
+     * @param pool Voice pool to render
+     * @param numThreads Helper threads in addition to the calling thread
+     * @param rtPriority SCHED_FIFO priority for helpers (0 = default policy)
+     */
+    void init(Pool* pool, size_t numThreads, int rtPriority = 0) {
+        pool_ = pool;
+        workers_.start(numThreads, rtPriority);
+    }
+
+    /**
+     * @brief Stop the worker threads (not real-time safe).
+     */
+    void shutdown() {
+        workers_.stop();
+    }
+
+    /**
+     * @brief Render all active voices into a stereo block.
+     * @param outL Left channel output buffer (overwritten)
+     * @param outR Right channel output buffer (overwritten)
+     * @param numSamples Number of samples to generate
+     */
+    void process(Sample* outL, Sample* outR, size_t numSamples) noexcept {
+        if (pool_ == nullptr) {
+            for (size_t i = 0; i < numSamples; ++i) {
+                outL[i] = 0.0f;
+                outR[i] = 0.0f;
+            }
+            return;
+        }
+
+        size_t done = 0;
+        while (done < numSamples) {
+            size_t chunk = numSamples - done;
+            if (chunk > BlockSize) {
+                chunk = BlockSize;
+            }
+            renderChunk(outL + done, outR + done, chunk);
+            done += chunk;
+        }
+
+        pool_->mixStealTails(outL, outR, numSamples);
+        pool_->reapInactive();
+    }
+
+    /**
+     * @brief Stereo callback for AudioCallbackHandler.
+     * @param left Left output buffer
+     * @param right Right output buffer
+     * @param numSamples Number of samples
+     * @param userData Pointer to the ParallelVoiceRenderer
+     */
+    static void stereoCallback(Sample* left, Sample* right, size_t numSamples, void* userData) {
+        static_cast<ParallelVoiceRenderer*>(userData)->process(left, right, numSamples);
+    }
+
+    /**
+     * @brief Get the number of helper threads.
+     * @return Thread count (excluding the caller)
+     */
+    size_t numThreads() const noexcept {
+        return workers_.numThreads();
+    }
+
+private:
+    static void renderTask(void* context, size_t task) noexcept {
+        auto* self = static_cast<ParallelVoiceRenderer*>(context);
+        Pool& pool = *self->pool_;
+        pool.voice(pool.activeSlot(task))
+            .process(self->voiceL_[task], self->voiceR_[task], self->chunkSize_);
+    }
+
+    void renderChunk(Sample* outL, Sample* outR, size_t numSamples) noexcept {
+        const size_t numVoices = pool_->activeCount();
+        chunkSize_ = numSamples;
+        workers_.run(&ParallelVoiceRenderer::renderTask, this, numVoices);
+
+        // Deterministic summation in active-list order
+        for (size_t i = 0; i < numSamples; ++i) {
+            outL[i] = 0.0f;
+            outR[i] = 0.0f;
+        }
+        for (size_t k = 0; k < numVoices; ++k) {
+            const Sample* vl = voiceL_[k];
+            const Sample* vr = voiceR_[k];
+            for (size_t i = 0; i < numSamples; ++i) {
+                outL[i] += vl[i];
+                outR[i] += vr[i];
+            }
+        }
+    }
+
+    Pool* pool_ = nullptr;
+    WorkerPool<MaxThreads> workers_;
+    size_t chunkSize_ = 0;
+    alignas(64) Sample voiceL_[Pool::capacity()][BlockSize];
+    alignas(64) Sample voiceR_[Pool::capacity()][BlockSize];
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_PARALLEL_VOICE_RENDERER_H
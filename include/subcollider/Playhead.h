@@ -0,0 +1,176 @@
+/**
+ * @file Playhead.h
+ * @brief 32.32 fixed-point buffer position for long-buffer playback.
+ *
+ * A float phase has 24 significant bits: past 2^24 frames (about 5.8
+ * minutes at 48 kHz) it can no longer hold a fractional position, and
+ * interpolated playback degrades into stepping. Playhead stores a frame
+ * position as a signed 64-bit integer with 32 fraction bits, so every
+ * frame of a buffer of up to 2^31 frames keeps the same sub-sample
+ * resolution, adding an increment is exact, and wrapping is an integer
+ * subtraction. The integer part is a shift and the fraction converts to
+ * a float in [0, 1) exactly.
+ */
+
+#ifndef SUBCOLLIDER_PLAYHEAD_H
+#define SUBCOLLIDER_PLAYHEAD_H
+
+#include "types.h"
+#include <cstdint>
+
+namespace subcollider {
+
+/**
+ * @brief Signed 32.32 fixed-point frame position or increment.
+ *
+ * Usage:
+ * @code
+ * Playhead pos;                          // frame 0
+ * const Playhead inc(44100.0 / 48000.0); // resampling increment
+ * const Playhead length = Playhead::fromIndex(buf.numSamples);
+ *
+ * pos += inc;
+ * pos = pos.wrap(length);                // exact, stays in [0, length)
+ * size_t index = pos.index();
+ * Sample frac = pos.frac();
+ * @endcode
+ */
+struct Playhead {
+    /// Fraction bits
+    static constexpr int FRACTION_BITS = 32;
+
+    /// Raw value of one frame
+    static constexpr int64_t ONE = int64_t(1) << FRACTION_BITS;
+
+    /// Position in 1/2^32 frames
+    int64_t raw;
+
+    /// Frame 0
+    constexpr Playhead() noexcept : raw(0) {}
+
+    /**
+     * @brief Convert a frame position, rounding to the nearest step.
+     * @param frames Position in frames (|frames| < 2^31)
+     *
+     * Float phases convert exactly unless they carry fraction bits
+     * below 2^-32.
+     */
+    explicit constexpr Playhead(double frames) noexcept
+        : raw(static_cast<int64_t>(frames * static_cast<double>(ONE) + (frames < 0.0 ? -0.5 : 0.5))) {}
+
+    /**
+     * @brief Build from a raw 32.32 value.
+     * @param value Position in 1/2^32 frames
+     */
+    static constexpr Playhead fromRaw(int64_t value) noexcept {
+        Playhead p;
+        p.raw = value;
+        return p;
+    }
+
+    /**
+     * @brief Build from a whole frame index and a fraction.
+     * @param index Frame index
+     * @param fraction Fraction in 1/2^32 frames
+     */
+    static constexpr Playhead fromIndex(int64_t index, uint32_t fraction = 0) noexcept {
+        return fromRaw(index * ONE + static_cast<int64_t>(fraction));
+    }
+
+    /**
+     * @brief Get the whole frame index (rounded toward minus infinity).
+     * @return Integer part
+     */
+    constexpr int64_t index() const noexcept {
+        return raw >> FRACTION_BITS;
+    }
+
+    /**
+     * @brief Get the fractional position for interpolation.
+     * @return Fraction in [0, 1), exact to 24 bits
+     */
+    constexpr Sample frac() const noexcept {
+        return static_cast<Sample>(static_cast<uint32_t>(raw) >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /// Position in frames as a double (exact below 2^21 frames)
+    constexpr double toDouble() const noexcept {
+        return static_cast<double>(raw) * (1.0 / static_cast<double>(ONE));
+    }
+
+    /// Position in frames as a float (loses the fraction on long buffers)
+    constexpr Sample toSample() const noexcept {
+        return static_cast<Sample>(toDouble());
+    }
+
+    /**
+     * @brief Wrap into [0, length).
+     * @param length Positive wrap length
+     * @return Wrapped position
+     *
+     * One compare-and-subtract for positions within a length of the
+     * range, an integer modulo only for larger jumps.
+     */
+    constexpr Playhead wrap(Playhead length) const noexcept {
+        int64_t r = raw;
+        if (r >= length.raw) {
+            r -= length.raw;
+            if (r >= length.raw) {
+                r %= length.raw;
+            }
+        } else if (r < 0) {
+            r += length.raw;
+            if (r < 0) {
+                r %= length.raw;
+                if (r < 0) {
+                    r += length.raw;
+                }
+            }
+        }
+        return fromRaw(r);
+    }
+
+    /**
+     * @brief Clamp into [low, high].
+     * @param low Lower bound
+     * @param high Upper bound
+     * @return Clamped position
+     */
+    constexpr Playhead clamp(Playhead low, Playhead high) const noexcept {
+        return raw < low.raw ? low : (raw > high.raw ? high : *this);
+    }
+
+    constexpr Playhead operator-() const noexcept { return fromRaw(-raw); }
+    constexpr Playhead& operator+=(Playhead b) noexcept { raw += b.raw; return *this; }
+    constexpr Playhead& operator-=(Playhead b) noexcept { raw -= b.raw; return *this; }
+};
+
+constexpr Playhead operator+(Playhead a, Playhead b) noexcept { return Playhead::fromRaw(a.raw + b.raw); }
+constexpr Playhead operator-(Playhead a, Playhead b) noexcept { return Playhead::fromRaw(a.raw - b.raw); }
+
+/// Scale by a real factor (rounded to the nearest step)
+constexpr Playhead operator*(Playhead a, double s) noexcept { return Playhead(a.toDouble() * s); }
+
+/// Divide by a real factor (rounded to the nearest step)
+constexpr Playhead operator/(Playhead a, double s) noexcept { return Playhead(a.toDouble() / s); }
+
+constexpr bool operator==(Playhead a, Playhead b) noexcept { return a.raw == b.raw; }
+constexpr bool operator!=(Playhead a, Playhead b) noexcept { return a.raw != b.raw; }
+constexpr bool operator<(Playhead a, Playhead b) noexcept { return a.raw < b.raw; }
+constexpr bool operator<=(Playhead a, Playhead b) noexcept { return a.raw <= b.raw; }
+constexpr bool operator>(Playhead a, Playhead b) noexcept { return a.raw > b.raw; }
+constexpr bool operator>=(Playhead a, Playhead b) noexcept { return a.raw >= b.raw; }
+
+/**
+ * @brief Truncated remainder with the sign of a, like std::fmod.
+ *
+ * Found by argument-dependent lookup, so code written against
+ * `using std::fmod; fmod(x, y)` works for both Sample and Playhead.
+ */
+constexpr Playhead fmod(Playhead a, Playhead b) noexcept {
+    return Playhead::fromRaw(a.raw % b.raw);
+}
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_PLAYHEAD_H
@@ -0,0 +1,300 @@
+/**
+ * @file PoolStorage.h
+ * @brief Backing-store policies for the BufferAllocator sample pool.
+ *
+ * EmbeddedStorage keeps the pool inside the allocator object, as before.
+ * MmapStorage reserves it with an anonymous memory mapping instead, so
+ * the allocator object stays small, pages are zero-filled by the kernel
+ * only when first touched, and exactly the regions in use can be
+ * prefaulted and locked before going real-time.
+ */
+
+#ifndef SUBCOLLIDER_POOL_STORAGE_H
+#define SUBCOLLIDER_POOL_STORAGE_H
+
+#include "types.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#ifndef SUBCOLLIDER_HAS_MMAP
+#define SUBCOLLIDER_HAS_MMAP 1
+#endif
+#endif
+
+namespace subcollider {
+
+/**
+ * @brief Pool embedded in the allocator object.
+ *
+ * @tparam PoolSamples Pool size in floats
+ *
+ * The memory is part of the object (static or stack storage), so there
+ * is nothing to reserve; discard() zeroes the whole pool. prefault(),
+ * lock() and unlock() have nothing to do and succeed.
+ */
+template<size_t PoolSamples>
+class EmbeddedStorage {
+public:
+    /// Make the pool usable (always succeeds)
+    bool reserve() noexcept {
+        return true;
+    }
+
+    /// Reset the pool contents to zero
+    void discard() noexcept {
+        std::fill(pool_, pool_ + PoolSamples, 0.0f);
+    }
+
+    /// Fault in a range (no-op)
+    bool prefault(size_t, size_t) noexcept {
+        return true;
+    }
+
+    /// Pin a range in RAM (no-op)
+    bool lock(size_t, size_t) noexcept {
+        return true;
+    }
+
+    /// Unpin a range (no-op)
+    bool unlock(size_t, size_t) noexcept {
+        return true;
+    }
+
+    /// Get the pool base pointer
+    Sample* data() noexcept {
+        return pool_;
+    }
+
+    /// Get the pool base pointer (const)
+    const Sample* data() const noexcept {
+        return pool_;
+    }
+
+private:
+    Sample pool_[PoolSamples];  ///< Pre-allocated sample memory
+};
+
+#if defined(SUBCOLLIDER_HAS_MMAP)
+
+/**
+ * @brief Pool reserved with an anonymous mmap and committed lazily.
+ *
+ * @tparam PoolSamples Pool size in floats
+ *
+ * reserve() maps address space only; the kernel backs a page with zeroed
+ * RAM the first time it is written, so startup cost and resident memory
+ * follow what is actually loaded rather than the pool size. discard()
+ * hands all pages back (MADV_DONTNEED), after which they read as zero
+ * again.
+ *
+ * Before going real-time, call prefault() on the ranges the audio thread
+ * will touch, or lock() them to also keep them out of swap; otherwise the
+ * first access to a page can fault on the audio thread.
+ *
+ * With setHugePages(true) the pool is mapped with MAP_HUGETLB where
+ * available, falling back to a normal mapping with transparent huge pages
+ * requested through madvise().
+ *
+ * Not real-time safe: reserve(), discard(), prefault(), lock() and
+ * unlock() make system calls.
+ */
+template<size_t PoolSamples>
+class MmapStorage {
+public:
+    MmapStorage() noexcept = default;
+    MmapStorage(const MmapStorage&) = delete;
+    MmapStorage& operator=(const MmapStorage&) = delete;
+
+    ~MmapStorage() {
+        unmap();
+    }
+
+    /**
+     * @brief Request huge pages for the next reserve().
+     * @param enable true to try MAP_HUGETLB / transparent huge pages
+     */
+    void setHugePages(bool enable) noexcept {
+        hugePages_ = enable;
+    }
+
+    /// Map the pool if not yet mapped
+    bool reserve() noexcept {
+        if (data_ != nullptr) {
+            return true;
+        }
+
+        void* p = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+        if (hugePages_) {
+            mappedBytes_ = roundUp(POOL_BYTES, HUGE_PAGE_BYTES);
+            p = mmap(nullptr, mappedBytes_, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        if (p == MAP_FAILED) {
+            mappedBytes_ = roundUp(POOL_BYTES, pageBytes());
+            p = mmap(nullptr, mappedBytes_, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p == MAP_FAILED) {
+                mappedBytes_ = 0;
+                return false;
+            }
+#if defined(MADV_HUGEPAGE)
+            if (hugePages_) {
+                madvise(p, mappedBytes_, MADV_HUGEPAGE);
+            }
+#endif
+        }
+        data_ = static_cast<Sample*>(p);
+        return true;
+    }
+
+    /// Release all pages; they read as zero on next access
+    void discard() noexcept {
+        if (data_ != nullptr) {
+            madvise(data_, mappedBytes_, MADV_DONTNEED);
+        }
+    }
+
+    /**
+     * @brief Commit the pages of a range without changing their contents.
+     * @param offset Range start in floats
+     * @param count Range length in floats
+     * @return true if the range is mapped
+     */
+    bool prefault(size_t offset, size_t count) noexcept {
+        size_t begin = 0;
+        size_t end = 0;
+        if (!pageRange(offset, count, begin, end)) {
+            return false;
+        }
+        auto* bytes = reinterpret_cast<volatile unsigned char*>(data_);
+        const size_t page = pageBytes();
+        for (size_t b = begin; b < end; b += page) {
+            bytes[b] = bytes[b];  // write fault commits the page, value unchanged
+        }
+        return true;
+    }
+
+    /**
+     * @brief Commit and pin the pages of a range (mlock).
+     * @param offset Range start in floats
+     * @param count Range length in floats
+     * @return true on success (may fail under RLIMIT_MEMLOCK)
+     */
+    bool lock(size_t offset, size_t count) noexcept {
+        size_t begin = 0;
+        size_t end = 0;
+        if (!prefault(offset, count) || !pageRange(offset, count, begin, end)) {
+            return false;
+        }
+        return mlock(reinterpret_cast<char*>(data_) + begin, end - begin) == 0;
+    }
+
+    /**
+     * @brief Unpin the pages of a range (munlock).
+     * @param offset Range start in floats
+     * @param count Range length in floats
+     * @return true on success
+     */
+    bool unlock(size_t offset, size_t count) noexcept {
+        size_t begin = 0;
+        size_t end = 0;
+        if (!pageRange(offset, count, begin, end)) {
+            return false;
+        }
+        return munlock(reinterpret_cast<char*>(data_) + begin, end - begin) == 0;
+    }
+
+    /**
+     * @brief Count resident bytes in a range (mincore).
+     * @param offset Range start in floats
+     * @param count Range length in floats
+     * @return Bytes of the covering pages that are resident
+     */
+    size_t residentBytes(size_t offset, size_t count) const noexcept {
+        size_t begin = 0;
+        size_t end = 0;
+        if (!pageRange(offset, count, begin, end)) {
+            return 0;
+        }
+        const size_t page = pageBytes();
+        size_t resident = 0;
+        unsigned char vec[256];
+        for (size_t b = begin; b < end; b += page * sizeof(vec)) {
+            const size_t chunk = std::min(end - b, page * sizeof(vec));
+            if (mincore(reinterpret_cast<char*>(data_) + b, chunk, vecArg(vec)) != 0) {
+                return resident;
+            }
+            for (size_t i = 0; i < (chunk + page - 1) / page; ++i) {
+                if (vec[i] & 1u) {
+                    resident += page;
+                }
+            }
+        }
+        return resident;
+    }
+
+    /// Get the pool base pointer (nullptr before reserve())
+    Sample* data() noexcept {
+        return data_;
+    }
+
+    /// Get the pool base pointer (const)
+    const Sample* data() const noexcept {
+        return data_;
+    }
+
+private:
+    static constexpr size_t POOL_BYTES = PoolSamples * sizeof(Sample);
+    static constexpr size_t HUGE_PAGE_BYTES = size_t(2) << 20;
+
+    static size_t pageBytes() noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    static size_t roundUp(size_t bytes, size_t unit) noexcept {
+        return (bytes + unit - 1) / unit * unit;
+    }
+
+    // mincore() takes unsigned char* on Linux and char* on macOS/BSD
+#if defined(__linux__)
+    static unsigned char* vecArg(unsigned char* v) noexcept { return v; }
+#else
+    static char* vecArg(unsigned char* v) noexcept { return reinterpret_cast<char*>(v); }
+#endif
+
+    /// Page-aligned byte range covering [offset, offset + count) floats
+    bool pageRange(size_t offset, size_t count, size_t& begin, size_t& end) const noexcept {
+        if (data_ == nullptr || count == 0 || offset + count > PoolSamples) {
+            return false;
+        }
+        const size_t page = pageBytes();
+        begin = offset * sizeof(Sample) / page * page;
+        end = roundUp((offset + count) * sizeof(Sample), page);
+        return true;
+    }
+
+    void unmap() noexcept {
+        if (data_ != nullptr) {
+            munmap(data_, mappedBytes_);
+            data_ = nullptr;
+            mappedBytes_ = 0;
+        }
+    }
+
+    Sample* data_ = nullptr;    ///< Mapped pool
+    size_t mappedBytes_ = 0;    ///< Length of the mapping
+    bool hugePages_ = false;    ///< Try huge pages on reserve()
+};
+
+#endif // SUBCOLLIDER_HAS_MMAP
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_POOL_STORAGE_H
@@ -0,0 +1,505 @@
+/**
+ * @file RelocatableBufferAllocator.h
+ * @brief Handle-based buffer allocation with background compaction.
+ *
+ * RelocatableBufferAllocator hands out BufferHandles instead of raw
+ * pointers. Because readers re-resolve handles once per block, a
+ * compactor can move buffers towards the bottom of the pool and
+ * republish their addresses, so a long-running pool that has seen many
+ * loads and unloads of different sizes can still satisfy large requests.
+ */
+
+#ifndef SUBCOLLIDER_RELOCATABLE_BUFFER_ALLOCATOR_H
+#define SUBCOLLIDER_RELOCATABLE_BUFFER_ALLOCATOR_H
+
+#include "types.h"
+#include "Buffer.h"
+#include "BufferHandle.h"
+#include "BufferAllocator.h"
+#include "MpscRing.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace subcollider {
+
+/**
+ * @brief BufferAllocator wrapper whose buffers can be moved while in use.
+ *
+ * @tparam Allocator Wrapped allocator (any BufferAllocator instantiation)
+ * @tparam MaxHandles Size of the handle table
+ * @tparam QueueCapacity Maximum releases pending reclamation (power of two)
+ *
+ * Each handle table slot publishes the buffer's address and format in
+ * atomics; resolve() reads them without locking and checks the slot's
+ * generation against the handle, so it is real-time safe and a released
+ * handle resolves to an invalid Buffer.
+ *
+ * Compaction moves one sealed buffer at a time: it allocates a copy (for
+ * FirstFitStrategy, the lowest hole that fits), keeps it only if it lies
+ * below the original, copies the samples and republishes the address.
+ * The old memory is retired rather than freed, because the audio thread
+ * may still be reading it through a Buffer resolved earlier in the block.
+ * The audio thread calls endBlock() after each block; retired memory is
+ * returned to the pool once a block has ended after the move, and that
+ * memory then merges with its free neighbours.
+ *
+ * Rules for users:
+ * - Fill a buffer through resolve() after allocate(), then call seal().
+ *   Only sealed buffers are moved, so writes are never lost to a copy.
+ *   seal() also writes and publishes the guard frames, if any; guards
+ *   move with the samples.
+ * - On the audio thread, resolve each handle at most once per block
+ *   (BufRd and XPlay do this in process()) and call endBlock() afterwards.
+ *   When no audio thread is running, call endBlock() from the control
+ *   thread so retired memory can be reclaimed.
+ * - release() may be called from any thread, including the audio thread.
+ *
+ * allocate(), seal(), compact(), collect() and the statistics take a
+ * spinlock and are for non-real-time threads only.
+ *
+ * Usage:
+ * @code
+ * static RelocatableBufferAllocator<BufferAllocator<>> pool;
+ * pool.init(48000.0f);
+ * pool.startCompactor();
+ *
+ * // Loader thread:
+ * BufferHandle h = pool.allocate(frames, 2, 2);
+ * Buffer buf = pool.resolve(h);
+ * BufferAllocator<>::fillStereo(buf, left, right, frames);
+ * pool.seal(h, Buffer::GuardMode::Wrap);
+ * xplay.setBuffer(pool.ref(h));
+ *
+ * // Audio thread:
+ * xplay.process(left, right, 64);
+ * pool.endBlock();
+ * @endcode
+ */
+template<typename Allocator = BufferAllocator<>, size_t MaxHandles = 256,
+         size_t QueueCapacity = 1024>
+class RelocatableBufferAllocator {
+    static_assert(MaxHandles >= 1 && MaxHandles < BufferHandle::INVALID_INDEX,
+                  "MaxHandles out of range");
+
+public:
+    RelocatableBufferAllocator() noexcept = default;
+    RelocatableBufferAllocator(const RelocatableBufferAllocator&) = delete;
+    RelocatableBufferAllocator& operator=(const RelocatableBufferAllocator&) = delete;
+
+    ~RelocatableBufferAllocator() {
+        stopCompactor();
+    }
+
+    /**
+     * @brief Initialize the pool and empty the handle table.
+     * @param sr Sample rate in Hz for allocated buffers
+     *
+     * Not thread-safe: call before other threads use the allocator.
+     * Handles from before init() resolve as invalid afterwards.
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
+        allocator_.init(sr);
+        pending_.clear();
+        for (Slot& slot : slots_) {
+            slot.generation.store(slot.generation.load(std::memory_order_relaxed) + 1,
+                                  std::memory_order_relaxed);
+            slot.data.store(nullptr, std::memory_order_relaxed);
+            slot.owned = Buffer();
+            slot.stale = Buffer();
+            slot.guardMode.store(Buffer::GuardMode::Off, std::memory_order_relaxed);
+            slot.state = SlotState::Free;
+            slot.sealed = false;
+        }
+        epoch_.store(0, std::memory_order_relaxed);
+        moves_ = 0;
+    }
+
+    /**
+     * @brief Allocate a buffer (non-real-time threads).
+     * @param numSamples Number of samples (per channel for stereo)
+     * @param channels Number of channels (1 or 2)
+     * @param guardFrames Extra frames to reserve before and after the data
+     * @return Handle, or an invalid handle if memory or slots ran out
+     *
+     * The guards start unused (GuardMode::Off) until seal() writes them.
+     */
+    BufferHandle allocate(size_t numSamples, uint8_t channels = 1,
+                          uint8_t guardFrames = 0) noexcept {
+        acquire();
+        reclaimLocked();
+        BufferHandle handle;
+        for (uint32_t i = 0; i < MaxHandles; ++i) {
+            Slot& slot = slots_[i];
+            if (slot.state != SlotState::Free) {
+                continue;
+            }
+            const Buffer buf = allocator_.allocate(numSamples, channels, guardFrames);
+            if (!buf.isValid()) {
+                break;
+            }
+            slot.owned = buf;
+            slot.sealed = false;
+            slot.state = SlotState::Live;
+            slot.numSamples.store(buf.numSamples, std::memory_order_relaxed);
+            slot.channels.store(buf.channels, std::memory_order_relaxed);
+            slot.sampleRate.store(buf.sampleRate, std::memory_order_relaxed);
+            slot.guardFrames.store(buf.guardFrames, std::memory_order_relaxed);
+            slot.guardMode.store(Buffer::GuardMode::Off, std::memory_order_relaxed);
+            slot.data.store(buf.data, std::memory_order_release);
+            handle.index = i;
+            handle.generation = slot.generation.load(std::memory_order_relaxed);
+            break;
+        }
+        unlock();
+        return handle;
+    }
+
+    /**
+     * @brief Mark a buffer's contents as complete so it may be moved.
+     * @param handle Handle from allocate()
+     * @param guards Contents to write into the guard frames, if any
+     * @return true if the handle is live
+     */
+    bool seal(BufferHandle handle, Buffer::GuardMode guards = Buffer::GuardMode::Off) noexcept {
+        acquire();
+        Slot* slot = liveSlot(handle);
+        if (slot != nullptr) {
+            slot->owned.updateGuards(guards);
+            slot->guardMode.store(slot->owned.guardMode, std::memory_order_release);
+            slot->sealed = true;
+        }
+        unlock();
+        return slot != nullptr;
+    }
+
+    /**
+     * @brief Queue a buffer for release (any thread, never blocks).
+     * @param handle Handle from allocate()
+     * @return true if queued, false if the queue was full (counted)
+     *
+     * The handle stops resolving at the next reclaim; the memory returns
+     * to the pool once the audio thread has ended a block after that.
+     */
+    bool release(BufferHandle handle) noexcept {
+        if (!handle.isValid()) {
+            return false;
+        }
+        return pending_.tryPush(handle);
+    }
+
+    /**
+     * @brief Get a handle's current buffer (any thread, real-time safe).
+     * @param handle Handle from allocate()
+     * @return Buffer, or an invalid Buffer if the handle is stale
+     *
+     * The returned pointer stays readable until the calling audio thread
+     * next calls endBlock().
+     */
+    Buffer resolve(BufferHandle handle) const noexcept {
+        if (handle.index >= MaxHandles || handle.generation == 0) {
+            return Buffer();
+        }
+        const Slot& slot = slots_[handle.index];
+        if (slot.generation.load(std::memory_order_seq_cst) != handle.generation) {
+            return Buffer();
+        }
+        Sample* data = slot.data.load(std::memory_order_seq_cst);
+        Buffer buf(data, slot.channels.load(std::memory_order_relaxed),
+                   slot.sampleRate.load(std::memory_order_relaxed),
+                   slot.numSamples.load(std::memory_order_relaxed), Buffer::NO_BLOCK,
+                   slot.guardFrames.load(std::memory_order_relaxed));
+        buf.guardMode = slot.guardMode.load(std::memory_order_acquire);
+        if (slot.generation.load(std::memory_order_seq_cst) != handle.generation) {
+            return Buffer();
+        }
+        return buf;
+    }
+
+    /**
+     * @brief Bundle a handle with this allocator for BufRd/XPlay.
+     * @param handle Handle from allocate()
+     * @return Reference that resolves through this allocator
+     */
+    BufferRef ref(BufferHandle handle) const noexcept {
+        BufferRef r;
+        r.owner = this;
+        r.resolveFn = &resolveThunk;
+        r.handle = handle;
+        return r;
+    }
+
+    /**
+     * @brief Mark the end of an audio block (audio thread, wait-free).
+     *
+     * After this call the audio thread holds no Buffer resolved earlier,
+     * so memory retired before it may be reused.
+     */
+    void endBlock() noexcept {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Move up to maxMoves buffers towards the bottom of the pool.
+     * @param maxMoves Maximum number of buffers to move
+     * @return Number of buffers moved
+     *
+     * Not real-time safe; runs under the allocator lock, including the
+     * sample copy.
+     */
+    size_t compact(size_t maxMoves = 1) noexcept {
+        acquire();
+        reclaimLocked();
+        size_t moved = 0;
+        while (moved < maxMoves && moveOneLocked()) {
+            ++moved;
+        }
+        unlock();
+        return moved;
+    }
+
+    /**
+     * @brief Apply queued releases and free retired memory.
+     * @return Number of retired blocks returned to the pool
+     */
+    size_t collect() noexcept {
+        acquire();
+        const size_t freed = reclaimLocked();
+        unlock();
+        return freed;
+    }
+
+    /**
+     * @brief Start the background compactor thread (not real-time safe).
+     * @param interval Time between passes
+     * @param movesPerPass Maximum buffers moved per pass
+     */
+    void startCompactor(std::chrono::microseconds interval = std::chrono::milliseconds(50),
+                        size_t movesPerPass = 1) {
+        stopCompactor();
+        interval_ = interval;
+        movesPerPass_ = movesPerPass;
+        running_.store(true, std::memory_order_relaxed);
+        compactor_ = std::thread(&RelocatableBufferAllocator::compactLoop, this);
+    }
+
+    /**
+     * @brief Stop the compactor thread (not real-time safe).
+     */
+    void stopCompactor() {
+        running_.store(false, std::memory_order_release);
+        if (compactor_.joinable()) {
+            compactor_.join();
+        }
+    }
+
+    /**
+     * @brief Get the amount of free memory, excluding retired blocks.
+     * @return Number of unallocated float samples
+     */
+    size_t freeSpace() noexcept {
+        acquire();
+        const size_t free = allocator_.freeSpace();
+        unlock();
+        return free;
+    }
+
+    /**
+     * @brief Get the number of blocks (used and free) in the pool.
+     * @return Block count; 1 + live buffers when fully compacted
+     */
+    size_t blockCount() noexcept {
+        acquire();
+        const size_t count = allocator_.blockCount();
+        unlock();
+        return count;
+    }
+
+    /**
+     * @brief Get the number of buffers moved since init().
+     * @return Move count
+     */
+    size_t moveCount() noexcept {
+        acquire();
+        const size_t moves = moves_;
+        unlock();
+        return moves;
+    }
+
+    /**
+     * @brief Get the number of releases rejected because the queue was full.
+     * @return Drop count since init()
+     */
+    size_t droppedReleases() const noexcept {
+        return pending_.droppedCount();
+    }
+
+private:
+    static constexpr int SPIN_ITERATIONS = 64;
+
+    enum class SlotState : uint8_t { Free, Live, Released };
+
+    struct Slot {
+        // Published to resolve()
+        std::atomic<uint32_t> generation{1};   ///< Bumped on release
+        std::atomic<Sample*> data{nullptr};    ///< Current address
+        std::atomic<size_t> numSamples{0};     ///< Frames
+        std::atomic<uint8_t> channels{1};      ///< Channel count
+        std::atomic<Sample> sampleRate{DEFAULT_SAMPLE_RATE};  ///< Sample rate
+        std::atomic<uint8_t> guardFrames{0};   ///< Guard frames on each side
+        std::atomic<Buffer::GuardMode> guardMode{Buffer::GuardMode::Off};  ///< Set by seal()
+
+        // Owner side, guarded by lock_
+        Buffer owned;                          ///< Current allocation
+        Buffer stale;                          ///< Moved-from allocation awaiting an epoch
+        uint64_t staleEpoch = 0;               ///< Epoch when stale was retired
+        uint64_t releaseEpoch = 0;             ///< Epoch when the slot was released
+        SlotState state = SlotState::Free;     ///< Lifecycle
+        bool sealed = false;                   ///< Contents final, may be moved
+    };
+
+    static Buffer resolveThunk(const void* owner, BufferHandle handle) noexcept {
+        return static_cast<const RelocatableBufferAllocator*>(owner)->resolve(handle);
+    }
+
+    void acquire() noexcept {
+        int spins = 0;
+        while (lock_.test_and_set(std::memory_order_acquire)) {
+            if (++spins > SPIN_ITERATIONS) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() noexcept {
+        lock_.clear(std::memory_order_release);
+    }
+
+    Slot* liveSlot(BufferHandle handle) noexcept {
+        if (handle.index >= MaxHandles) {
+            return nullptr;
+        }
+        Slot& slot = slots_[handle.index];
+        if (slot.state != SlotState::Live ||
+            slot.generation.load(std::memory_order_relaxed) != handle.generation) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    /// Memory retired at epoch e is unreachable once a block has ended since
+    bool retiredLongEnough(uint64_t retiredAt) const noexcept {
+        return epoch_.load(std::memory_order_seq_cst) > retiredAt;
+    }
+
+    /// Apply queued releases, then free retired memory (lock held)
+    size_t reclaimLocked() noexcept {
+        BufferHandle handle;
+        while (pending_.tryPop(handle)) {
+            Slot* slot = liveSlot(handle);
+            if (slot == nullptr) {
+                continue;
+            }
+            uint32_t next = handle.generation + 1;
+            if (next == 0) {
+                next = 1;
+            }
+            slot->generation.store(next, std::memory_order_seq_cst);
+            slot->releaseEpoch = epoch_.load(std::memory_order_seq_cst);
+            slot->state = SlotState::Released;
+        }
+
+        size_t freed = 0;
+        for (Slot& slot : slots_) {
+            if (slot.stale.data != nullptr && retiredLongEnough(slot.staleEpoch)) {
+                allocator_.release(slot.stale);
+                slot.stale = Buffer();
+                ++freed;
+            }
+            if (slot.state == SlotState::Released && slot.stale.data == nullptr &&
+                retiredLongEnough(slot.releaseEpoch)) {
+                allocator_.release(slot.owned);
+                slot.owned = Buffer();
+                slot.data.store(nullptr, std::memory_order_relaxed);
+                slot.state = SlotState::Free;
+                ++freed;
+            }
+        }
+        return freed;
+    }
+
+    /// Move the highest sealed buffer that has a lower hole (lock held)
+    bool moveOneLocked() noexcept {
+        const Sample* ceiling = nullptr;
+        for (;;) {
+            Slot* victim = nullptr;
+            for (Slot& slot : slots_) {
+                if (slot.state != SlotState::Live || !slot.sealed ||
+                    slot.stale.data != nullptr) {
+                    continue;
+                }
+                if (ceiling != nullptr && slot.owned.data >= ceiling) {
+                    continue;
+                }
+                if (victim == nullptr || slot.owned.data > victim->owned.data) {
+                    victim = &slot;
+                }
+            }
+            if (victim == nullptr) {
+                return false;
+            }
+            ceiling = victim->owned.data;
+
+            Buffer target = allocator_.allocate(victim->owned.numSamples,
+                                                victim->owned.channels,
+                                                victim->owned.guardFrames);
+            if (!target.isValid()) {
+                continue;
+            }
+            if (target.data > victim->owned.data) {
+                allocator_.release(target);
+                continue;
+            }
+
+            // Copy the guard frames along with the samples
+            const size_t lead = static_cast<size_t>(target.guardFrames) * target.channels;
+            const size_t floats = victim->owned.allocatedFloats();
+            const Sample* from = victim->owned.data - lead;
+            Sample* to = target.data - lead;
+            for (size_t i = 0; i < floats; ++i) {
+                to[i] = from[i];
+            }
+            target.guardMode = victim->owned.guardMode;
+            victim->data.store(target.data, std::memory_order_seq_cst);
+            victim->stale = victim->owned;
+            victim->staleEpoch = epoch_.load(std::memory_order_seq_cst);
+            victim->owned = target;
+            ++moves_;
+            return true;
+        }
+    }
+
+    void compactLoop() noexcept {
+        while (running_.load(std::memory_order_acquire)) {
+            compact(movesPerPass_);
+            std::this_thread::sleep_for(interval_);
+        }
+    }
+
+    Allocator allocator_;                           ///< Wrapped allocator
+    Slot slots_[MaxHandles];                        ///< Handle table
+    MpscRing<BufferHandle, QueueCapacity> pending_; ///< Releases awaiting reclaim
+    alignas(64) std::atomic<uint64_t> epoch_{0};    ///< Blocks ended by the audio thread
+    std::atomic_flag lock_ = ATOMIC_FLAG_INIT;      ///< Guards allocator_ and owner-side slot state
+    size_t moves_ = 0;                              ///< Buffers moved
+    std::thread compactor_;                         ///< Background compactor
+    std::chrono::microseconds interval_{50000};     ///< Compactor period
+    size_t movesPerPass_ = 1;                       ///< Compactor moves per pass
+    std::atomic<bool> running_{false};              ///< Cleared by stopCompactor()
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_RELOCATABLE_BUFFER_ALLOCATOR_H
@@ -0,0 +1,157 @@
+/**
+ * @file SincTable.h
+ * @brief Polyphase windowed-sinc table and dot-product kernels for
+ *        high-quality fractional reads.
+ *
+ * A windowed-sinc interpolator weights Taps neighbouring frames with a
+ * sinc centred on the fractional position. Evaluating sin() per tap per
+ * sample is far too slow, so the kernel is tabulated once for PHASES + 1
+ * fractional positions; a read picks the two rows around its fraction,
+ * blends them linearly and takes the dot product with the frames, four
+ * taps at a time using simd::Frames2.
+ *
+ * Table sizes: 8 taps 8 KB, 16 taps 16 KB, 32 taps 32 KB, small enough
+ * to stay in L1/L2 while a voice plays.
+ */
+
+#ifndef SUBCOLLIDER_SINC_TABLE_H
+#define SUBCOLLIDER_SINC_TABLE_H
+
+#include "types.h"
+#include "simd.h"
+#include <cmath>
+#include <cstddef>
+
+namespace subcollider {
+
+/**
+ * @brief Blackman-Harris windowed sinc, tabulated by fractional phase.
+ *
+ * @tparam Taps Kernel length (multiple of 4, at least 8)
+ *
+ * Tap k of a read at frame i + frac weights frame i - (Taps/2 - 1) + k.
+ * Every row is normalized to unity DC gain, and row 0 is a unit impulse,
+ * so integer phases return the frame itself.
+ *
+ * The table is built on first use of instance() (not real-time safe: it
+ * evaluates Taps * (PHASES + 1) sines and may take a lock). Touch it from
+ * a control thread first; BufRd::setInterpolation() does.
+ */
+template<size_t Taps>
+struct SincTable {
+    static_assert(Taps >= 8 && Taps % 4 == 0, "SincTable needs a multiple of 4 taps");
+
+    /// Kernel length
+    static constexpr size_t TAPS = Taps;
+
+    /// Fractional positions tabulated (plus one row for frac = 1)
+    static constexpr size_t PHASES = 256;
+
+    /// Frames read before the integer frame
+    static constexpr size_t BEFORE = Taps / 2 - 1;
+
+    /// Frames read after the integer frame
+    static constexpr size_t AFTER = Taps / 2;
+
+    /// Rows of Taps coefficients, row r for frac = r / PHASES
+    alignas(16) Sample coeffs[(PHASES + 1) * Taps];
+
+    /**
+     * @brief Get the shared table, building it on first use.
+     * @return Table for this tap count
+     */
+    static const SincTable& instance() noexcept {
+        static const SincTable table;
+        return table;
+    }
+
+    /**
+     * @brief Interpolate contiguous mono frames.
+     * @param x First frame of the kernel (frame i - BEFORE)
+     * @param frac Fractional phase [0, 1)
+     * @return Interpolated sample
+     */
+    inline Sample apply(const Sample* x, Sample frac) const noexcept {
+        const Sample* a;
+        Sample w;
+        rows(frac, a, w);
+        const Sample* b = a + Taps;
+        const simd::Frames2 wv = simd::splat(w);
+        simd::Frames2 acc = simd::splat(0.0f);
+        for (size_t k = 0; k < Taps; k += 4) {
+            const simd::Frames2 ca = simd::load(a + k, a + k + 2);
+            const simd::Frames2 cb = simd::load(b + k, b + k + 2);
+            acc = acc + (ca + wv * (cb - ca)) * simd::load(x + k, x + k + 2);
+        }
+        Sample lo[2];
+        Sample hi[2];
+        simd::storeSplit(acc, lo, hi);
+        return (lo[0] + lo[1]) + (hi[0] + hi[1]);
+    }
+
+    /**
+     * @brief Interpolate interleaved stereo frames.
+     * @param x First frame of the kernel (frame i - BEFORE, L/R interleaved)
+     * @param frac Fractional phase [0, 1)
+     * @return Interpolated stereo sample
+     */
+    inline Stereo applyStereo(const Sample* x, Sample frac) const noexcept {
+        const Sample* a;
+        Sample w;
+        rows(frac, a, w);
+        const Sample* b = a + Taps;
+        simd::Frames2 acc = simd::splat(0.0f);
+        for (size_t k = 0; k < Taps; k += 2) {
+            // Coefficients [ck ck ck+1 ck+1] against frames [Lk Rk Lk+1 Rk+1]
+            const Sample c0 = a[k] + w * (b[k] - a[k]);
+            const Sample c1 = a[k + 1] + w * (b[k + 1] - a[k + 1]);
+            acc = acc + simd::pair(c0, c1) * simd::load(x + 2 * k, x + 2 * k + 2);
+        }
+        Sample left[2];
+        Sample right[2];
+        simd::storeSplit(acc, left, right);
+        return Stereo(left[0] + left[1], right[0] + right[1]);
+    }
+
+private:
+    SincTable() noexcept {
+        const double pi = 3.14159265358979323846;
+        const double half = static_cast<double>(Taps) / 2.0;
+        for (size_t r = 0; r <= PHASES; ++r) {
+            const double frac = static_cast<double>(r) / static_cast<double>(PHASES);
+            double row[Taps];
+            double sum = 0.0;
+            for (size_t k = 0; k < Taps; ++k) {
+                // Distance of this tap's frame from the read position
+                const double d = static_cast<double>(k) - static_cast<double>(BEFORE) - frac;
+                // Exact zeros on whole-frame rows, so those rows are unit impulses
+                const double sinc = d == 0.0 ? 1.0
+                                  : (r == 0 || r == PHASES) ? 0.0
+                                  : std::sin(pi * d) / (pi * d);
+                const double x = 2.0 * pi * (d + half) / (2.0 * half);  // Window phase, centre at pi
+                const double window = 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2.0 * x) -
+                                      0.01168 * std::cos(3.0 * x);
+                row[k] = sinc * window;
+                sum += row[k];
+            }
+            for (size_t k = 0; k < Taps; ++k) {
+                coeffs[r * Taps + k] = static_cast<Sample>(row[k] / sum);
+            }
+        }
+    }
+
+    /// Row below frac and the weight of the row after it
+    inline void rows(Sample frac, const Sample*& row, Sample& weight) const noexcept {
+        const Sample pos = frac * static_cast<Sample>(PHASES);
+        size_t r = static_cast<size_t>(pos);
+        if (r >= PHASES) {
+            r = PHASES - 1;
+        }
+        weight = pos - static_cast<Sample>(r);
+        row = coeffs + r * Taps;
+    }
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_SINC_TABLE_H
@@ -0,0 +1,342 @@
+/**
+ * @file TlsfStrategy.h
+ * @brief Two-level segregated fit (TLSF) block management for BufferAllocator.
+ *
+ * TlsfStrategy hands out ranges of a sample pool in O(1): free blocks are
+ * binned by size into a two-level table of free lists with bitmaps, so
+ * finding, splitting and coalescing a block never scans other blocks.
+ * Every operation has a fixed worst-case cost independent of how many
+ * buffers are live.
+ */
+
+#ifndef SUBCOLLIDER_TLSF_STRATEGY_H
+#define SUBCOLLIDER_TLSF_STRATEGY_H
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+
+namespace detail {
+
+/// Index of the highest set bit (x must be non-zero)
+inline unsigned highestBit(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(x));
+#else
+    unsigned bit = 0;
+    while (x >>= 1) {
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+/// Index of the lowest set bit (x must be non-zero)
+inline unsigned lowestBit(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+    unsigned bit = 0;
+    while ((x & 1u) == 0) {
+        x >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+/// Compile-time floor(log2(x)) for x >= 1
+constexpr unsigned floorLog2(size_t x) noexcept {
+    return x <= 1 ? 0 : 1 + floorLog2(x >> 1);
+}
+
+} // namespace detail
+
+/**
+ * @brief TLSF block manager over a pool of PoolSamples floats.
+ *
+ * @tparam PoolSamples Pool size in floats
+ * @tparam MaxBlocks Maximum number of blocks (used and free) tracked
+ *
+ * Block metadata lives outside the pool in a fixed array of records, so
+ * every float of the pool is usable and freeSpace() is exact. Each block
+ * keeps links to its physical neighbours for O(1) coalescing, and the id
+ * of the record is returned to the caller so release() needs no search.
+ *
+ * Sizes below 16 floats get one free list each; larger sizes are split
+ * into power-of-two ranges with 16 linear sub-ranges. A request first
+ * tries the head of its own sub-range, which reuses same-size holes and
+ * lets an exactly matching block (e.g. the whole pool) be found. Failing
+ * that, it is rounded up to the next sub-range boundary and the bitmaps
+ * give the smallest non-empty sub-range above it, whose blocks are all
+ * large enough, so no list is ever walked.
+ *
+ * If all records are in use a block is handed out whole instead of being
+ * split, the same as the first-fit strategy.
+ */
+template<size_t PoolSamples, size_t MaxBlocks>
+class TlsfStrategy {
+    static_assert(MaxBlocks >= 1 && MaxBlocks < 0xFFFFFFFFu, "MaxBlocks out of range");
+
+public:
+    /// Id returned when a block has no stable id
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    /**
+     * @brief Reset to a single free block spanning the pool.
+     */
+    void init() noexcept {
+        flBitmap_ = 0;
+        for (size_t fl = 0; fl < FL_COUNT; ++fl) {
+            slBitmap_[fl] = 0;
+            for (size_t sl = 0; sl < SL_COUNT; ++sl) {
+                heads_[fl][sl] = NONE;
+            }
+        }
+        for (size_t i = 0; i < MaxBlocks; ++i) {
+            unused_[i] = static_cast<uint32_t>(MaxBlocks - 1 - i);
+            blocks_[i].used = false;
+        }
+        unusedCount_ = MaxBlocks;
+        free_ = 0;
+
+        const uint32_t id = popRecord();
+        blocks_[id] = Block{0, PoolSamples, NONE, NONE, NONE, NONE, false};
+        insertFree(id);
+        free_ = PoolSamples;
+    }
+
+    /**
+     * @brief Allocate a range of floats.
+     * @param size Number of floats
+     * @param offset Receives the range start within the pool
+     * @param id Receives the block id for release()
+     * @return true on success
+     */
+    bool allocate(size_t size, size_t& offset, uint32_t& id) noexcept {
+        if (size == 0 || size > PoolSamples) {
+            return false;
+        }
+
+        // The first block of the request's own sub-range is taken if it
+        // fits (O(1), reuses same-size holes); otherwise the next non-empty
+        // sub-range at or above the rounded-up size.
+        size_t fl = 0;
+        size_t sl = 0;
+        mapping(size, fl, sl);
+        uint32_t found = heads_[fl][sl];
+        if (found == NONE || blocks_[found].size < size) {
+            mapping(roundUp(size), fl, sl);
+            found = findSuitable(fl, sl);
+            if (found == NONE) {
+                return false;
+            }
+        }
+
+        removeFree(found);
+        Block& block = blocks_[found];
+        if (block.size > size && unusedCount_ > 0) {
+            const uint32_t rest = popRecord();
+            blocks_[rest] = Block{block.offset + size, block.size - size,
+                                  found, block.nextPhys, NONE, NONE, false};
+            if (block.nextPhys != NONE) {
+                blocks_[block.nextPhys].prevPhys = rest;
+            }
+            block.nextPhys = rest;
+            block.size = size;
+            insertFree(rest);
+        }
+
+        block.used = true;
+        free_ -= block.size;
+        offset = block.offset;
+        id = found;
+        return true;
+    }
+
+    /**
+     * @brief Release a range and coalesce it with free neighbours.
+     * @param offset Range start as returned by allocate()
+     * @param id Block id as returned by allocate(), or NONE to look it up
+     * @return true if a used block was released
+     *
+     * Looking up a block without its id scans the records; buffers
+     * handed out by BufferAllocator always carry their id.
+     */
+    bool release(size_t offset, uint32_t id) noexcept {
+        if (id == NONE) {
+            id = findUsed(offset);
+        }
+        if (id >= MaxBlocks || !blocks_[id].used || blocks_[id].offset != offset) {
+            return false;
+        }
+
+        blocks_[id].used = false;
+        free_ += blocks_[id].size;
+
+        const uint32_t prev = blocks_[id].prevPhys;
+        if (prev != NONE && !blocks_[prev].used) {
+            removeFree(prev);
+            absorbNext(prev);
+            id = prev;
+        }
+        const uint32_t next = blocks_[id].nextPhys;
+        if (next != NONE && !blocks_[next].used) {
+            removeFree(next);
+            absorbNext(id);
+        }
+        insertFree(id);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of blocks (used and free).
+     * @return Block count
+     */
+    size_t blockCount() const noexcept {
+        return MaxBlocks - unusedCount_;
+    }
+
+    /**
+     * @brief Get the number of free floats.
+     * @return Free space
+     */
+    size_t freeSpace() const noexcept {
+        return free_;
+    }
+
+private:
+    static constexpr size_t SL_LOG2 = 4;
+    static constexpr size_t SL_COUNT = size_t(1) << SL_LOG2;
+    static constexpr size_t FL_COUNT =
+        PoolSamples < SL_COUNT ? 1 : detail::floorLog2(PoolSamples) - (SL_LOG2 - 1) + 1;
+
+    static_assert(FL_COUNT <= 64, "first-level bitmap is 64 bits");
+
+    struct Block {
+        size_t offset;      ///< Start within the pool
+        size_t size;        ///< Size in floats
+        uint32_t prevPhys;  ///< Block just below in the pool
+        uint32_t nextPhys;  ///< Block just above in the pool
+        uint32_t prevFree;  ///< Previous block in the free list
+        uint32_t nextFree;  ///< Next block in the free list
+        bool used;          ///< Allocated (false for free blocks and spare records)
+    };
+
+    static void mapping(size_t size, size_t& fl, size_t& sl) noexcept {
+        if (size < SL_COUNT) {
+            fl = 0;
+            sl = size;
+        } else {
+            const unsigned msb = detail::highestBit(size);
+            sl = (size >> (msb - SL_LOG2)) ^ SL_COUNT;
+            fl = msb - (SL_LOG2 - 1);
+        }
+    }
+
+    static size_t roundUp(size_t size) noexcept {
+        if (size < SL_COUNT) {
+            return size;
+        }
+        const unsigned msb = detail::highestBit(size);
+        return size + (size_t(1) << (msb - SL_LOG2)) - 1;
+    }
+
+    uint32_t findSuitable(size_t fl, size_t sl) const noexcept {
+        if (fl >= FL_COUNT) {
+            return NONE;
+        }
+        uint32_t slMap = slBitmap_[fl] & (~0u << sl);
+        if (slMap == 0) {
+            const uint64_t flMap = fl + 1 < 64 ? flBitmap_ & (~uint64_t(0) << (fl + 1)) : 0;
+            if (flMap == 0) {
+                return NONE;
+            }
+            fl = detail::lowestBit(flMap);
+            slMap = slBitmap_[fl];
+        }
+        sl = detail::lowestBit(slMap);
+        return heads_[fl][sl];
+    }
+
+    void insertFree(uint32_t id) noexcept {
+        size_t fl = 0;
+        size_t sl = 0;
+        mapping(blocks_[id].size, fl, sl);
+        const uint32_t head = heads_[fl][sl];
+        blocks_[id].prevFree = NONE;
+        blocks_[id].nextFree = head;
+        if (head != NONE) {
+            blocks_[head].prevFree = id;
+        }
+        heads_[fl][sl] = id;
+        slBitmap_[fl] |= 1u << sl;
+        flBitmap_ |= uint64_t(1) << fl;
+    }
+
+    void removeFree(uint32_t id) noexcept {
+        const Block& block = blocks_[id];
+        if (block.prevFree != NONE) {
+            blocks_[block.prevFree].nextFree = block.nextFree;
+        }
+        if (block.nextFree != NONE) {
+            blocks_[block.nextFree].prevFree = block.prevFree;
+        }
+
+        size_t fl = 0;
+        size_t sl = 0;
+        mapping(block.size, fl, sl);
+        if (heads_[fl][sl] == id) {
+            heads_[fl][sl] = block.nextFree;
+            if (block.nextFree == NONE) {
+                slBitmap_[fl] &= ~(1u << sl);
+                if (slBitmap_[fl] == 0) {
+                    flBitmap_ &= ~(uint64_t(1) << fl);
+                }
+            }
+        }
+    }
+
+    /// Merge the physical successor of id into id and recycle its record
+    void absorbNext(uint32_t id) noexcept {
+        const uint32_t next = blocks_[id].nextPhys;
+        blocks_[id].size += blocks_[next].size;
+        blocks_[id].nextPhys = blocks_[next].nextPhys;
+        if (blocks_[id].nextPhys != NONE) {
+            blocks_[blocks_[id].nextPhys].prevPhys = id;
+        }
+        pushRecord(next);
+    }
+
+    uint32_t findUsed(size_t offset) const noexcept {
+        for (uint32_t i = 0; i < MaxBlocks; ++i) {
+            if (blocks_[i].used && blocks_[i].offset == offset) {
+                return i;
+            }
+        }
+        return NONE;
+    }
+
+    uint32_t popRecord() noexcept {
+        return unused_[--unusedCount_];
+    }
+
+    void pushRecord(uint32_t id) noexcept {
+        blocks_[id].used = false;
+        unused_[unusedCount_++] = id;
+    }
+
+    Block blocks_[MaxBlocks];               ///< Block records
+    uint32_t unused_[MaxBlocks];            ///< Stack of spare record ids
+    size_t unusedCount_ = 0;                ///< Spare records
+    uint32_t heads_[FL_COUNT][SL_COUNT];    ///< Free list heads
+    uint32_t slBitmap_[FL_COUNT];           ///< Non-empty second-level lists
+    uint64_t flBitmap_ = 0;                 ///< Non-empty first-level rows
+    size_t free_ = 0;                       ///< Free floats
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_TLSF_STRATEGY_H
@@ -0,0 +1,402 @@
+/**
+ * @file VoicePool.h
+ * @brief Fixed-capacity polyphonic voice pool with voice stealing.
+ *
+ * VoicePool owns N instances of a voice type, hands them out on note-on,
+ * steals voices when the pool is exhausted, and keeps a compact list of
+ * active voices so block processing only touches voices that are sounding.
+ * No heap allocation occurs after construction.
+ */
+
+#ifndef SUBCOLLIDER_VOICE_POOL_H
+#define SUBCOLLIDER_VOICE_POOL_H
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+
+/**
+ * @brief Fixed-capacity polyphonic voice pool.
+ *
+ * @tparam Voice Voice type. Must provide:
+ *               - `void init(Sample sampleRate)`
+ *               - `bool isActive() const`
+ *               - `Sample level() const` (current envelope level, used by StealMode::Quietest)
+ *               - `void reset()`
+ *               - `void process(Sample* left, Sample* right, size_t numSamples)`
+ * @tparam N Maximum number of simultaneous voices
+ * @tparam FadeSamples Length of the fade-out applied to stolen voices
+ *
+ * Voices are addressed by a caller-chosen note id (e.g. a MIDI note number
+ * or a sequencer event id). noteOn() returns the voice to configure and
+ * trigger; noteOff() returns the voice to release. The pool never triggers
+ * or releases voices itself, so any voice type with its own gate API fits.
+ *
+ * When all voices are busy, noteOn() steals one. Released voices are always
+ * preferred over held ones; among equals the victim is picked by the steal
+ * mode (oldest note, or lowest envelope level). The remaining output of the
+ * stolen voice is rendered ahead with a linear fade of FadeSamples and mixed
+ * into the following blocks, so the voice can be reused immediately without
+ * a click.
+ *
+ * Usage:
+ * @code
+ * VoicePool<ExampleVoice, 64> pool;
+ * pool.init(48000.0f);
+ *
+ * // Note on
+ * ExampleVoice* v = pool.noteOn(60);
+ * v->setFrequency(261.63f);
+ * v->trigger();
+ *
+ * // Note off
+ * if (ExampleVoice* r = pool.noteOff(60)) {
+ *     r->release();
+ * }
+ *
+ * // Audio callback: only active voices are processed
+ * pool.process(outL, outR, 64);
+ * @endcode
+ */
+template<typename Voice, size_t N, size_t FadeSamples = 64>
+class VoicePool {
+    static_assert(N > 0, "VoicePool needs at least one voice");
+    static_assert(N <= 65535, "VoicePool slot indices are 16-bit");
+    static_assert(FadeSamples > 0, "FadeSamples must be positive");
+
+public:
+    /// Victim selection when every voice is busy
+    enum class StealMode : uint8_t {
+        Oldest = 0,    ///< Steal the voice with the oldest note-on
+        Quietest = 1   ///< Steal the voice with the lowest envelope level
+    };
+
+    /// Note id stored for voices that are not bound to a held note
+    static constexpr uint32_t NO_NOTE = 0xFFFFFFFFu;
+
+    /**
+     * @brief Initialize the pool and every voice.
+     * @param sr Sample rate in Hz
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
+        sampleRate_ = sr;
+        stealMode_ = StealMode::Oldest;
+        clock_ = 0;
+        stealCount_ = 0;
+        activeCount_ = 0;
+        freeCount_ = N;
+        for (size_t i = 0; i < N; ++i) {
+            voices_[i].init(sr);
+            noteIds_[i] = NO_NOTE;
+            ages_[i] = 0;
+            // Fill the free stack so slot 0 is handed out first
+            freeSlots_[i] = static_cast<uint16_t>(N - 1 - i);
+        }
+        for (size_t i = 0; i < FadeSamples; ++i) {
+            tailL_[i] = 0.0f;
+            tailR_[i] = 0.0f;
+        }
+        tailPos_ = 0;
+        tailRemaining_ = 0;
+    }
+
+    /**
+     * @brief Set the voice stealing strategy.
+     * @param mode Steal mode
+     */
+    void setStealMode(StealMode mode) noexcept {
+        stealMode_ = mode;
+    }
+
+    /**
+     * @brief Allocate a voice for a note, stealing one if necessary.
+     * @param noteId Caller-chosen note identifier
+     * @return Voice to configure and trigger (never nullptr)
+     */
+    Voice* noteOn(uint32_t noteId) noexcept {
+        size_t slot;
+        if (freeCount_ > 0) {
+            slot = freeSlots_[--freeCount_];
+            activeSlots_[activeCount_++] = static_cast<uint16_t>(slot);
+        } else {
+            slot = findVictim();
+            fadeOutVoice(slot);
+            ++stealCount_;
+        }
+
+        noteIds_[slot] = noteId;
+        ages_[slot] = ++clock_;
+        return &voices_[slot];
+    }
+
+    /**
+     * @brief Detach the voice playing a note so it can be released.
+     * @param noteId Note identifier passed to noteOn()
+     * @return Voice to release, or nullptr if no voice holds the note
+     *
+     * The voice keeps sounding (e.g. through its release stage) until its
+     * isActive() returns false, after which process() returns it to the pool.
+     */
+    Voice* noteOff(uint32_t noteId) noexcept {
+        const size_t slot = findSlot(noteId);
+        if (slot == N) {
+            return nullptr;
+        }
+        noteIds_[slot] = NO_NOTE;
+        return &voices_[slot];
+    }
+
+    /**
+     * @brief Find the voice holding a note.
+     * @param noteId Note identifier passed to noteOn()
+     * @return Voice, or nullptr if no voice holds the note
+     */
+    Voice* find(uint32_t noteId) noexcept {
+        const size_t slot = findSlot(noteId);
+        return slot == N ? nullptr : &voices_[slot];
+    }
+
+    /**
+     * @brief Render all active voices into a stereo block.
+     * @param outL Left channel output buffer (overwritten)
+     * @param outR Right channel output buffer (overwritten)
+     * @param numSamples Number of samples to generate
+     *
+     * Voices that became inactive during the block are returned to the pool.
+     */
+    void process(Sample* outL, Sample* outR, size_t numSamples) noexcept {
+        for (size_t i = 0; i < numSamples; ++i) {
+            outL[i] = 0.0f;
+            outR[i] = 0.0f;
+        }
+
+        for (size_t k = 0; k < activeCount_; ++k) {
+            Voice& voice = voices_[activeSlots_[k]];
+            size_t done = 0;
+            while (done < numSamples) {
+                size_t chunk = numSamples - done;
+                if (chunk > SCRATCH_SIZE) {
+                    chunk = SCRATCH_SIZE;
+                }
+                voice.process(scratchL_, scratchR_, chunk);
+                for (size_t i = 0; i < chunk; ++i) {
+                    outL[done + i] += scratchL_[i];
+                    outR[done + i] += scratchR_[i];
+                }
+                done += chunk;
+            }
+        }
+
+        mixStealTails(outL, outR, numSamples);
+        reapInactive();
+    }
+
+    /**
+     * @brief Add pending fade-outs of stolen voices to a block.
+     * @param outL Left channel buffer to add to
+     * @param outR Right channel buffer to add to
+     * @param numSamples Number of samples in the block
+     *
+     * Called by process(); exposed for renderers that mix voices themselves.
+     */
+    void mixStealTails(Sample* outL, Sample* outR, size_t numSamples) noexcept {
+        const size_t count = numSamples < tailRemaining_ ? numSamples : tailRemaining_;
+        for (size_t i = 0; i < count; ++i) {
+            outL[i] += tailL_[tailPos_];
+            outR[i] += tailR_[tailPos_];
+            tailL_[tailPos_] = 0.0f;
+            tailR_[tailPos_] = 0.0f;
+            tailPos_ = tailPos_ + 1 == FadeSamples ? 0 : tailPos_ + 1;
+        }
+        tailRemaining_ -= count;
+    }
+
+    /**
+     * @brief Return voices that are no longer active to the free list.
+     *
+     * Called by process(); exposed for renderers that mix voices themselves.
+     */
+    void reapInactive() noexcept {
+        size_t k = 0;
+        while (k < activeCount_) {
+            const uint16_t slot = activeSlots_[k];
+            if (voices_[slot].isActive()) {
+                ++k;
+                continue;
+            }
+            noteIds_[slot] = NO_NOTE;
+            freeSlots_[freeCount_++] = slot;
+            // Swap-remove keeps the active list compact
+            activeSlots_[k] = activeSlots_[--activeCount_];
+        }
+    }
+
+    /**
+     * @brief Get a voice by slot index.
+     * @param slot Slot index [0, N)
+     * @return Voice reference
+     */
+    Voice& voice(size_t slot) noexcept {
+        return voices_[slot];
+    }
+
+    /// @copydoc voice(size_t)
+    const Voice& voice(size_t slot) const noexcept {
+        return voices_[slot];
+    }
+
+    /**
+     * @brief Get the slot index of the k-th active voice.
+     * @param k Position in the active list [0, activeCount())
+     * @return Slot index
+     */
+    size_t activeSlot(size_t k) const noexcept {
+        return activeSlots_[k];
+    }
+
+    /**
+     * @brief Get the number of voices currently in the active list.
+     * @return Active voice count
+     */
+    size_t activeCount() const noexcept {
+        return activeCount_;
+    }
+
+    /**
+     * @brief Get the number of voices available without stealing.
+     * @return Free voice count
+     */
+    size_t freeCount() const noexcept {
+        return freeCount_;
+    }
+
+    /**
+     * @brief Get the number of voices stolen since init().
+     * @return Steal count
+     */
+    uint32_t stealCount() const noexcept {
+        return stealCount_;
+    }
+
+    /**
+     * @brief Get the note id bound to a slot.
+     * @param slot Slot index [0, N)
+     * @return Note id, or NO_NOTE if the voice is released or free
+     */
+    uint32_t noteId(size_t slot) const noexcept {
+        return noteIds_[slot];
+    }
+
+    /**
+     * @brief Get the maximum number of voices.
+     * @return Pool capacity
+     */
+    static constexpr size_t capacity() noexcept {
+        return N;
+    }
+
+    /**
+     * @brief Get the sample rate the voices were initialized with.
+     * @return Sample rate in Hz
+     */
+    Sample sampleRate() const noexcept {
+        return sampleRate_;
+    }
+
+private:
+    /// Scratch size for per-voice rendering
+    static constexpr size_t SCRATCH_SIZE = DEFAULT_BLOCK_SIZE;
+
+    /// Locate the active slot holding a note (N if none)
+    size_t findSlot(uint32_t noteId) const noexcept {
+        if (noteId == NO_NOTE) {
+            return N;
+        }
+        for (size_t k = 0; k < activeCount_; ++k) {
+            const uint16_t slot = activeSlots_[k];
+            if (noteIds_[slot] == noteId) {
+                return slot;
+            }
+        }
+        return N;
+    }
+
+    /// Pick the voice to steal (pool must be full)
+    size_t findVictim() const noexcept {
+        size_t best = activeSlots_[0];
+        for (size_t k = 1; k < activeCount_; ++k) {
+            const size_t slot = activeSlots_[k];
+            if (isBetterVictim(slot, best)) {
+                best = slot;
+            }
+        }
+        return best;
+    }
+
+    /// True if slot a should be stolen before slot b
+    bool isBetterVictim(size_t a, size_t b) const noexcept {
+        const bool releasedA = noteIds_[a] == NO_NOTE;
+        const bool releasedB = noteIds_[b] == NO_NOTE;
+        if (releasedA != releasedB) {
+            return releasedA;
+        }
+        if (stealMode_ == StealMode::Quietest) {
+            const Sample levelA = voices_[a].level();
+            const Sample levelB = voices_[b].level();
+            if (levelA != levelB) {
+                return levelA < levelB;
+            }
+        }
+        return ages_[a] < ages_[b];
+    }
+
+    /// Render the stolen voice's fade-out into the tail ring, then reset it
+    void fadeOutVoice(size_t slot) noexcept {
+        Voice& voice = voices_[slot];
+        const Sample step = 1.0f / static_cast<Sample>(FadeSamples);
+        size_t pos = tailPos_;
+        size_t done = 0;
+        while (done < FadeSamples) {
+            size_t chunk = FadeSamples - done;
+            if (chunk > SCRATCH_SIZE) {
+                chunk = SCRATCH_SIZE;
+            }
+            voice.process(scratchL_, scratchR_, chunk);
+            for (size_t i = 0; i < chunk; ++i) {
+                const Sample gain = 1.0f - static_cast<Sample>(done + i) * step;
+                tailL_[pos] += scratchL_[i] * gain;
+                tailR_[pos] += scratchR_[i] * gain;
+                pos = pos + 1 == FadeSamples ? 0 : pos + 1;
+            }
+            done += chunk;
+        }
+        tailRemaining_ = FadeSamples;
+        voice.reset();
+    }
+
+    Voice voices_[N];                  ///< Voice storage
+    uint32_t noteIds_[N];              ///< Note bound to each slot
+    uint64_t ages_[N];                 ///< Note-on stamp per slot
+    uint16_t activeSlots_[N];          ///< Compact list of active slots
+    uint16_t freeSlots_[N];            ///< Stack of free slots
+    size_t activeCount_ = 0;           ///< Entries in activeSlots_
+    size_t freeCount_ = 0;             ///< Entries in freeSlots_
+    uint64_t clock_ = 0;               ///< Note-on counter
+    uint32_t stealCount_ = 0;          ///< Voices stolen since init()
+    StealMode stealMode_ = StealMode::Oldest;
+    Sample sampleRate_ = DEFAULT_SAMPLE_RATE;
+
+    Sample tailL_[FadeSamples];        ///< Pending stolen-voice fade (left)
+    Sample tailR_[FadeSamples];        ///< Pending stolen-voice fade (right)
+    size_t tailPos_ = 0;               ///< Next tail sample to output
+    size_t tailRemaining_ = 0;         ///< Tail samples still pending
+
+    Sample scratchL_[SCRATCH_SIZE];    ///< Per-voice render scratch (left)
+    Sample scratchR_[SCRATCH_SIZE];    ///< Per-voice render scratch (right)
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_VOICE_POOL_H
@@ -0,0 +1,392 @@
+/**
+ * @file WavFile.h
+ * @brief Memory-mapped WAV/RIFF reader producing Buffers.
+ *
+ * WavFile maps a WAV file into memory and parses its header in place.
+ * For 32-bit float files the Buffer points straight at the mapped sample
+ * data, so loading costs one page-in and no copy. Integer PCM (8/16/24/32
+ * bit) and 64-bit float files are converted to float in a single pass
+ * into a buffer from a BufferAllocator. No external libraries are needed.
+ */
+
+#ifndef SUBCOLLIDER_WAV_FILE_H
+#define SUBCOLLIDER_WAV_FILE_H
+
+#include "types.h"
+#include "Buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef SUBCOLLIDER_HAS_MMAP
+#define SUBCOLLIDER_HAS_MMAP 1
+#endif
+#endif
+
+namespace subcollider {
+
+/**
+ * @brief Sample format and data location of a parsed WAV file.
+ */
+struct WavInfo {
+    /// Sample encoding
+    enum class Format : uint8_t {
+        Invalid = 0,
+        PCM8,     ///< Unsigned 8-bit
+        PCM16,    ///< Signed 16-bit
+        PCM24,    ///< Signed 24-bit, packed
+        PCM32,    ///< Signed 32-bit
+        Float32,  ///< IEEE float
+        Float64   ///< IEEE double
+    };
+
+    Format format = Format::Invalid;  ///< Sample encoding
+    uint16_t channels = 0;            ///< Channels in the file
+    uint32_t sampleRate = 0;          ///< Sample rate in Hz
+    uint16_t bytesPerSample = 0;      ///< Bytes per sample of one channel
+    size_t frames = 0;                ///< Complete frames in the data chunk
+    size_t dataOffset = 0;            ///< Byte offset of the data chunk payload
+
+    /// Check whether the header was understood
+    bool isValid() const noexcept {
+        return format != Format::Invalid && channels > 0 && frames > 0;
+    }
+
+    /**
+     * @brief Parse a RIFF/WAVE header.
+     * @param bytes File contents
+     * @param size Length of bytes
+     * @return Parsed info; format is Invalid if the file is not supported
+     *
+     * Handles PCM, IEEE float and WAVE_FORMAT_EXTENSIBLE, skips unknown
+     * chunks, and clips the data chunk to the file length (for files
+     * written by a recorder that never patched the sizes).
+     */
+    static WavInfo parse(const void* bytes, size_t size) noexcept {
+        WavInfo info;
+        const uint8_t* p = static_cast<const uint8_t*>(bytes);
+        if (p == nullptr || size < 12 || std::memcmp(p, "RIFF", 4) != 0 ||
+            std::memcmp(p + 8, "WAVE", 4) != 0) {
+            return info;
+        }
+
+        uint16_t tag = 0;
+        uint16_t bits = 0;
+        bool haveFmt = false;
+        size_t pos = 12;
+        while (pos + 8 <= size) {
+            const uint8_t* chunk = p + pos;
+            const size_t chunkSize = readU32(chunk + 4);
+            const size_t body = pos + 8;
+            if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && body + 16 <= size) {
+                tag = readU16(p + body);
+                info.channels = readU16(p + body + 2);
+                info.sampleRate = readU32(p + body + 4);
+                bits = readU16(p + body + 14);
+                if (tag == 0xFFFE && chunkSize >= 40 && body + 40 <= size) {
+                    tag = readU16(p + body + 24);  // SubFormat GUID starts with the tag
+                }
+                haveFmt = true;
+            } else if (std::memcmp(chunk, "data", 4) == 0) {
+                if (!haveFmt) {
+                    return WavInfo();
+                }
+                info.format = formatOf(tag, bits);
+                info.bytesPerSample = static_cast<uint16_t>(bits / 8);
+                const size_t available = size - body;
+                const size_t dataSize = chunkSize < available ? chunkSize : available;
+                const size_t frameBytes = static_cast<size_t>(info.channels) * info.bytesPerSample;
+                info.frames = frameBytes > 0 ? dataSize / frameBytes : 0;
+                info.dataOffset = body;
+                if (info.format == Format::Invalid || info.frames == 0) {
+                    return WavInfo();
+                }
+                return info;
+            }
+            pos = body + chunkSize + (chunkSize & 1u);  // chunks are word aligned
+        }
+        return WavInfo();
+    }
+
+    /**
+     * @brief Convert frames to float, interleaved, in a single pass.
+     * @param bytes File contents the info was parsed from
+     * @param out Destination with room for frames * outChannels floats
+     * @param outChannels 1 or 2; extra file channels are dropped, a mono
+     *                    file is duplicated into both sides of stereo
+     * @param frames Number of frames to convert
+     * @param firstFrame First frame to convert (firstFrame + frames must
+     *                   not exceed this->frames)
+     */
+    void convert(const void* bytes, Sample* out, uint8_t outChannels, size_t frames,
+                 size_t firstFrame = 0) const noexcept {
+        const uint8_t* data = static_cast<const uint8_t*>(bytes) + dataOffset +
+                              firstFrame * channels * bytesPerSample;
+        switch (format) {
+            case Format::PCM8:    convertFrames<&decodePCM8>(data, out, outChannels, frames); break;
+            case Format::PCM16:   convertFrames<&decodePCM16>(data, out, outChannels, frames); break;
+            case Format::PCM24:   convertFrames<&decodePCM24>(data, out, outChannels, frames); break;
+            case Format::PCM32:   convertFrames<&decodePCM32>(data, out, outChannels, frames); break;
+            case Format::Float32: convertFrames<&decodeFloat32>(data, out, outChannels, frames); break;
+            case Format::Float64: convertFrames<&decodeFloat64>(data, out, outChannels, frames); break;
+            default: break;
+        }
+    }
+
+private:
+    static uint16_t readU16(const uint8_t* b) noexcept {
+        return static_cast<uint16_t>(b[0] | (b[1] << 8));
+    }
+
+    static uint32_t readU32(const uint8_t* b) noexcept {
+        return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+               (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+    }
+
+    static Format formatOf(uint16_t tag, uint16_t bits) noexcept {
+        if (tag == 1) {
+            switch (bits) {
+                case 8:  return Format::PCM8;
+                case 16: return Format::PCM16;
+                case 24: return Format::PCM24;
+                case 32: return Format::PCM32;
+                default: return Format::Invalid;
+            }
+        }
+        if (tag == 3) {
+            return bits == 32 ? Format::Float32 : bits == 64 ? Format::Float64 : Format::Invalid;
+        }
+        return Format::Invalid;
+    }
+
+    static Sample decodePCM8(const uint8_t* b) noexcept {
+        return (static_cast<Sample>(b[0]) - 128.0f) * (1.0f / 128.0f);
+    }
+
+    static Sample decodePCM16(const uint8_t* b) noexcept {
+        return static_cast<Sample>(static_cast<int16_t>(readU16(b))) * (1.0f / 32768.0f);
+    }
+
+    static Sample decodePCM24(const uint8_t* b) noexcept {
+        const int32_t v = static_cast<int32_t>(static_cast<uint32_t>(b[0]) << 8 |
+                                               static_cast<uint32_t>(b[1]) << 16 |
+                                               static_cast<uint32_t>(b[2]) << 24) >> 8;
+        return static_cast<Sample>(v) * (1.0f / 8388608.0f);
+    }
+
+    static Sample decodePCM32(const uint8_t* b) noexcept {
+        return static_cast<Sample>(static_cast<int32_t>(readU32(b))) * (1.0f / 2147483648.0f);
+    }
+
+    static Sample decodeFloat32(const uint8_t* b) noexcept {
+        const uint32_t bitsLE = readU32(b);
+        float v;
+        std::memcpy(&v, &bitsLE, sizeof(v));
+        return v;
+    }
+
+    static Sample decodeFloat64(const uint8_t* b) noexcept {
+        const uint64_t bitsLE = static_cast<uint64_t>(readU32(b)) |
+                                (static_cast<uint64_t>(readU32(b + 4)) << 32);
+        double v;
+        std::memcpy(&v, &bitsLE, sizeof(v));
+        return static_cast<Sample>(v);
+    }
+
+    template<Sample (*Decode)(const uint8_t*)>
+    void convertFrames(const uint8_t* data, Sample* out, uint8_t outChannels,
+                       size_t count) const noexcept {
+        const size_t stride = static_cast<size_t>(channels) * bytesPerSample;
+        const size_t rightOffset = channels >= 2 ? bytesPerSample : 0;
+        if (outChannels == 1) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Decode(data + i * stride);
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                const uint8_t* frame = data + i * stride;
+                out[i * 2] = Decode(frame);
+                out[i * 2 + 1] = Decode(frame + rightOffset);
+            }
+        }
+    }
+};
+
+#if defined(SUBCOLLIDER_HAS_MMAP)
+
+/**
+ * @brief Read-only view of a memory-mapped WAV file.
+ *
+ * The file is mapped privately (copy-on-write), so writing through a
+ * zero-copy Buffer never modifies the file. The mapping lives as long as
+ * the WavFile; Buffers from buffer() must not outlive it.
+ *
+ * Usage:
+ * @code
+ * WavFile wav;
+ * if (wav.open("data/amen_16_48000.wav")) {
+ *     Buffer buf = wav.buffer();           // float32: no copy at all
+ *     if (!buf.isValid()) {
+ *         buf = wav.load(allocator);       // integer PCM: one conversion pass
+ *     }
+ *     reader.setBuffer(&buf);
+ * }
+ * @endcode
+ *
+ * Not real-time safe: open() and load() touch the file system and the
+ * page cache.
+ */
+class WavFile {
+public:
+    WavFile() noexcept = default;
+    WavFile(const WavFile&) = delete;
+    WavFile& operator=(const WavFile&) = delete;
+
+    ~WavFile() {
+        close();
+    }
+
+    /**
+     * @brief Map and parse a WAV file.
+     * @param path File path
+     * @return true if the file is a supported WAV file
+     */
+    bool open(const char* path) noexcept {
+        close();
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        const size_t size = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // the mapping keeps the file referenced
+        if (p == MAP_FAILED) {
+            return false;
+        }
+        map_ = static_cast<uint8_t*>(p);
+        size_ = size;
+        info_ = WavInfo::parse(map_, size_);
+        if (!info_.isValid()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Unmap the file.
+     */
+    void close() noexcept {
+        if (map_ != nullptr) {
+            munmap(map_, size_);
+            map_ = nullptr;
+            size_ = 0;
+        }
+        info_ = WavInfo();
+    }
+
+    /**
+     * @brief Check whether buffer() can point into the mapping.
+     * @return true for mono/stereo float32 data at a float-aligned offset
+     *         on a little-endian host
+     */
+    bool isZeroCopy() const noexcept {
+        return info_.isValid() && info_.format == WavInfo::Format::Float32 &&
+               (info_.channels == 1 || info_.channels == 2) &&
+               info_.dataOffset % alignof(Sample) == 0 && hostIsLittleEndian();
+    }
+
+    /**
+     * @brief Get a Buffer over the mapped samples without copying.
+     * @return Buffer into the mapping, or an invalid Buffer unless isZeroCopy()
+     */
+    Buffer buffer() const noexcept {
+        if (!isZeroCopy()) {
+            return Buffer();
+        }
+        return Buffer(reinterpret_cast<Sample*>(map_ + info_.dataOffset),
+                      static_cast<uint8_t>(info_.channels),
+                      static_cast<Sample>(info_.sampleRate), info_.frames);
+    }
+
+    /**
+     * @brief Convert the file into a buffer from an allocator.
+     * @param allocator Any allocator with allocate(numSamples, channels, guardFrames)
+     * @param guardFrames Guard frames to reserve on each side (written in
+     *                    GuardMode::Wrap; see Buffer::updateGuards())
+     * @return Allocated and filled Buffer (mono, or stereo for files with
+     *         two or more channels), or an invalid Buffer on failure
+     *
+     * The mapped file is read once, front to back, and each sample is
+     * written once; there is no intermediate copy. The buffer's sample
+     * rate is the file's.
+     */
+    template<typename Allocator>
+    Buffer load(Allocator& allocator, uint8_t guardFrames = 0) const noexcept {
+        if (!info_.isValid()) {
+            return Buffer();
+        }
+        const uint8_t channels = info_.channels >= 2 ? 2 : 1;
+        Buffer buf = allocator.allocate(info_.frames, channels, guardFrames);
+        if (!buf.isValid()) {
+            return Buffer();
+        }
+        madvise(map_, size_, MADV_SEQUENTIAL);
+        info_.convert(map_, buf.data, channels, info_.frames);
+        buf.sampleRate = static_cast<Sample>(info_.sampleRate);
+        buf.updateGuards(Buffer::GuardMode::Wrap);
+        return buf;
+    }
+
+    /**
+     * @brief Ask the kernel to read the sample data ahead (not real-time safe).
+     */
+    void willNeed() const noexcept {
+        if (map_ != nullptr) {
+            madvise(map_, size_, MADV_WILLNEED);
+        }
+    }
+
+    /// Get the parsed header
+    const WavInfo& info() const noexcept {
+        return info_;
+    }
+
+    /// Get the mapped file contents (nullptr when closed)
+    const uint8_t* bytes() const noexcept {
+        return map_;
+    }
+
+    /// Check whether a file is open
+    bool isOpen() const noexcept {
+        return map_ != nullptr;
+    }
+
+private:
+    static bool hostIsLittleEndian() noexcept {
+        const uint16_t probe = 1;
+        uint8_t first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    uint8_t* map_ = nullptr;  ///< Mapped file
+    size_t size_ = 0;         ///< Mapping length
+    WavInfo info_;            ///< Parsed header
+};
+
+#endif // SUBCOLLIDER_HAS_MMAP
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_WAV_FILE_H
@@ -0,0 +1,294 @@
+/**
+ * @file WorkerPool.h
+ * @brief Pre-spawned real-time worker threads with work stealing.
+ *
+ * WorkerPool runs a batch of independent tasks across a fixed set of
+ * threads that are created once, outside the audio thread. The audio
+ * thread publishes a batch, works on it itself, and returns once every
+ * task has completed. Publishing and completing a batch never allocates
+ * or locks, and the audio thread makes no system call unless a task is
+ * still running on a descheduled worker after a long spin.
+ */
+
+#ifndef SUBCOLLIDER_WORKER_POOL_H
+#define SUBCOLLIDER_WORKER_POOL_H
+
+#include "types.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+namespace subcollider {
+
+/**
+ * @brief Fixed pool of worker threads executing task batches.
+ *
+ * @tparam MaxThreads Maximum number of background worker threads
+ *
+ * Each batch of numTasks tasks is split into one contiguous range per
+ * participant (the calling thread plus every worker). A participant takes
+ * tasks from the front of its own range; once it is empty it steals from
+ * the back of the other ranges. Each range is a single packed 64-bit word
+ * (batch epoch, next, end) updated by compare-and-swap, so owners and
+ * thieves never take the same task and a thread that wakes up late for an
+ * old batch cannot claim anything from a new one.
+ *
+ * Idle workers spin, then yield, for the hot time passed to start() after
+ * their last batch, so between audio blocks they are awake when the next
+ * batch is published; give it at least one block period. Only after that
+ * do they back off to short sleeps, so a pool that is not being used does
+ * not burn whole cores. The caller always participates, so a batch
+ * completes even if no worker wakes up.
+ *
+ * Usage:
+ * @code
+ * WorkerPool<> workers;
+ * workers.start(3, 70);  // 3 helper threads at SCHED_FIFO priority 70
+ *
+ * // In the audio callback:
+ * workers.run([](void* ctx, size_t task) { ... }, &state, numVoices);
+ *
+ * workers.stop();
+ * @endcode
+ */
+template<size_t MaxThreads = 16>
+class WorkerPool {
+public:
+    /// Task function: called once per task index in [0, numTasks)
+    using TaskFn = void (*)(void* context, size_t taskIndex);
+
+    /// Largest batch accepted by run()
+    static constexpr size_t MAX_TASKS = (1u << 20) - 1;
+
+    WorkerPool() noexcept = default;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        stop();
+    }
+
+    /**
+     * @brief Spawn the worker threads (not real-time safe).
+     * @param numThreads Number of helper threads (clamped to MaxThreads)
+     * @param rtPriority SCHED_FIFO priority for the workers, or 0 to keep
+     *                   the default policy. Failure to raise the priority
+     *                   (e.g. missing permissions) is not an error.
+     * @param hotTime How long idle workers keep spinning and yielding after
+     *                a batch before they fall back to sleeping (default
+     *                10 ms, two 256-frame blocks at 48 kHz)
+     * @return Number of threads started
+     */
+    size_t start(size_t numThreads, int rtPriority = 0,
+                 std::chrono::microseconds hotTime = std::chrono::microseconds(10000)) {
+        stop();
+        if (numThreads > MaxThreads) {
+            numThreads = MaxThreads;
+        }
+        hotTime_ = hotTime;
+        running_.store(true, std::memory_order_relaxed);
+        for (size_t i = 0; i < numThreads; ++i) {
+            threads_[i] = std::thread(&WorkerPool::workerLoop, this, i + 1);
+            setRealtimePriority(threads_[i], rtPriority);
+        }
+        numThreads_ = numThreads;
+        return numThreads;
+    }
+
+    /**
+     * @brief Stop and join all worker threads (not real-time safe).
+     */
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        for (size_t i = 0; i < numThreads_; ++i) {
+            if (threads_[i].joinable()) {
+                threads_[i].join();
+            }
+        }
+        numThreads_ = 0;
+    }
+
+    /**
+     * @brief Execute a batch of tasks and wait for all of them.
+     * @param fn Task function
+     * @param context Pointer passed to every task
+     * @param numTasks Number of tasks (at most MAX_TASKS)
+     *
+     * Must only be called from one thread at a time (the audio thread).
+     * The caller executes tasks too and returns once all have finished.
+     */
+    void run(TaskFn fn, void* context, size_t numTasks) noexcept {
+        if (numTasks == 0) {
+            return;
+        }
+        if (numTasks > MAX_TASKS) {
+            numTasks = MAX_TASKS;
+        }
+
+        const size_t participants = numThreads_ + 1;
+        const uint64_t epoch = (epoch_.load(std::memory_order_relaxed) + 1) & EPOCH_MASK;
+
+        fn_.store(fn, std::memory_order_relaxed);
+        context_.store(context, std::memory_order_relaxed);
+        participants_.store(participants, std::memory_order_relaxed);
+        completed_.store(0, std::memory_order_relaxed);
+        for (size_t p = 0; p < participants; ++p) {
+            const uint64_t begin = numTasks * p / participants;
+            const uint64_t end = numTasks * (p + 1) / participants;
+            ranges_[p].word.store(pack(epoch, begin, end), std::memory_order_relaxed);
+        }
+        epoch_.store(epoch, std::memory_order_release);
+
+        work(0, epoch, fn, context, participants);
+
+        // Block barrier: wait for tasks still running on other threads. A
+        // worker preempted mid-task (more threads than cores) would keep
+        // a pure spin waiting for a whole time slice, so yield after a
+        // long spin
+        int spins = 0;
+        while (completed_.load(std::memory_order_acquire) < numTasks) {
+            if (++spins > BARRIER_SPIN_ITERATIONS) {
+                std::this_thread::yield();
+            } else {
+                cpuRelax();
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of running worker threads.
+     * @return Thread count (excluding the caller)
+     */
+    size_t numThreads() const noexcept {
+        return numThreads_;
+    }
+
+private:
+    static constexpr uint64_t FIELD_MASK = (1u << 20) - 1;
+    static constexpr uint64_t EPOCH_MASK = (1u << 24) - 1;
+    static constexpr int SPIN_ITERATIONS = 2000;
+    static constexpr int BARRIER_SPIN_ITERATIONS = 100000;
+
+    /// One participant's task range, padded to its own cache line
+    struct alignas(64) Range {
+        std::atomic<uint64_t> word{0};
+    };
+
+    static constexpr uint64_t pack(uint64_t epoch, uint64_t next, uint64_t end) noexcept {
+        return (epoch << 40) | (next << 20) | end;
+    }
+
+    static constexpr uint64_t epochOf(uint64_t w) noexcept { return w >> 40; }
+    static constexpr uint64_t nextOf(uint64_t w) noexcept { return (w >> 20) & FIELD_MASK; }
+    static constexpr uint64_t endOf(uint64_t w) noexcept { return w & FIELD_MASK; }
+
+    /// Claim one task from a range: front for the owner, back for thieves
+    bool claim(size_t rangeIndex, bool fromFront, uint64_t epoch, size_t& task) noexcept {
+        std::atomic<uint64_t>& word = ranges_[rangeIndex].word;
+        uint64_t w = word.load(std::memory_order_acquire);
+        for (;;) {
+            const uint64_t next = nextOf(w);
+            const uint64_t end = endOf(w);
+            if (epochOf(w) != epoch || next >= end) {
+                return false;
+            }
+            const uint64_t desired = fromFront ? pack(epoch, next + 1, end)
+                                               : pack(epoch, next, end - 1);
+            if (word.compare_exchange_weak(w, desired, std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                task = static_cast<size_t>(fromFront ? next : end - 1);
+                return true;
+            }
+        }
+    }
+
+    /// Drain own range, then steal from the others
+    void work(size_t self, uint64_t epoch, TaskFn fn, void* context, size_t participants) noexcept {
+        size_t task = 0;
+        for (size_t k = 0; k < participants; ++k) {
+            const size_t victim = (self + k) % participants;
+            while (claim(victim, victim == self, epoch, task)) {
+                fn(context, task);
+                completed_.fetch_add(1, std::memory_order_release);
+            }
+        }
+    }
+
+    /// Spin-wait hint: lets the sibling hyperthread run and saves power
+    static inline void cpuRelax() noexcept {
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    void workerLoop(size_t self) noexcept {
+        using Clock = std::chrono::steady_clock;
+        uint64_t seen = epoch_.load(std::memory_order_acquire);
+        Clock::time_point lastBatch = Clock::now();
+        int idle = 0;
+        while (running_.load(std::memory_order_acquire)) {
+            const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+            if (epoch == seen) {
+                // Spin, then yield until hotTime_ after the last batch, then sleep
+                if (++idle <= SPIN_ITERATIONS) {
+                    cpuRelax();
+                } else if (Clock::now() - lastBatch < hotTime_) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+                continue;
+            }
+            seen = epoch;
+            idle = 0;
+            lastBatch = Clock::now();
+            const size_t participants = participants_.load(std::memory_order_relaxed);
+            if (self >= participants) {
+                continue;
+            }
+            work(self, epoch, fn_.load(std::memory_order_relaxed),
+                 context_.load(std::memory_order_relaxed), participants);
+        }
+    }
+
+    static void setRealtimePriority(std::thread& thread, int priority) noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+        if (priority > 0) {
+            sched_param param{};
+            param.sched_priority = priority;
+            pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+        }
+#else
+        (void)thread;
+        (void)priority;
+#endif
+    }
+
+    Range ranges_[MaxThreads + 1];            ///< Task range per participant
+    std::thread threads_[MaxThreads];         ///< Worker threads
+    size_t numThreads_ = 0;                   ///< Running worker threads
+    std::chrono::microseconds hotTime_{10000};  ///< Idle spin/yield time after a batch
+    std::atomic<uint64_t> epoch_{0};          ///< Current batch id
+    std::atomic<TaskFn> fn_{nullptr};         ///< Current batch function
+    std::atomic<void*> context_{nullptr};     ///< Current batch context
+    std::atomic<size_t> participants_{1};     ///< Participants in current batch
+    alignas(64) std::atomic<size_t> completed_{0};  ///< Finished tasks
+    std::atomic<bool> running_{false};        ///< Cleared by stop()
+};
+
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_WORKER_POOL_H
@@ -0,0 +1,338 @@
+/**
+ * @file simd.h
+ * @brief Minimal 4-lane float vector for interleaved stereo frame pairs.
+ *
+ * Provides just enough SIMD for block readers that process two stereo
+ * frames at a time: load two interleaved L/R pairs into one register,
+ * do element-wise arithmetic, and store the result deinterleaved into
+ * separate left/right outputs. A few lane helpers let a reader also keep
+ * the positions of both frames in one register and split them into
+ * indices and fractions. The same register serves structure-of-arrays
+ * code as four independent lanes (loadLanes()/storeLanes()), for kernels
+ * whose selects and divisions the compiler will not vectorize on its own.
+ * Uses SSE2 or NEON when available and a
+ * plain scalar struct otherwise. All operations are element-wise and
+ * unfused, so results match the equivalent scalar expressions exactly.
+ */
+
+#ifndef SUBCOLLIDER_SIMD_H
+#define SUBCOLLIDER_SIMD_H
+
+#include "types.h"
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SUBCOLLIDER_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SUBCOLLIDER_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace subcollider {
+namespace simd {
+
+/**
+ * @brief Four floats laid out as two stereo frames [La Ra Lb Rb].
+ */
+struct Frames2 {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    __m128 v;
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    float32x4_t v;
+#else
+    Sample v[4];
+#endif
+};
+
+/**
+ * @brief Load two interleaved stereo frames from unrelated addresses.
+ * @param a First frame (two samples, any alignment)
+ * @param b Second frame (two samples, any alignment)
+ * @return [a[0] a[1] b[0] b[1]]
+ */
+inline Frames2 load(const Sample* a, const Sample* b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    const __m128 lo = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(a));
+    return Frames2{_mm_loadh_pi(lo, reinterpret_cast<const __m64*>(b))};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vcombine_f32(vld1_f32(a), vld1_f32(b))};
+#else
+    return Frames2{{a[0], a[1], b[0], b[1]}};
+#endif
+}
+
+/**
+ * @brief Broadcast one value per frame.
+ * @param a Value for both channels of the first frame
+ * @param b Value for both channels of the second frame
+ * @return [a a b b]
+ */
+inline Frames2 pair(Sample a, Sample b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_setr_ps(a, a, b, b)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vcombine_f32(vdup_n_f32(a), vdup_n_f32(b))};
+#else
+    return Frames2{{a, a, b, b}};
+#endif
+}
+
+/**
+ * @brief Broadcast one value to all lanes.
+ * @param x Value
+ * @return [x x x x]
+ */
+inline Frames2 splat(Sample x) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_set1_ps(x)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vdupq_n_f32(x)};
+#else
+    return Frames2{{x, x, x, x}};
+#endif
+}
+
+/**
+ * @brief Set four independent lanes.
+ * @return [a b c d]
+ */
+inline Frames2 set(Sample a, Sample b, Sample c, Sample d) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_setr_ps(a, b, c, d)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    const float lanes[4] = {a, b, c, d};
+    return Frames2{vld1q_f32(lanes)};
+#else
+    return Frames2{{a, b, c, d}};
+#endif
+}
+
+/**
+ * @brief Load four contiguous lanes.
+ * @param p Four samples (any alignment)
+ * @return [p[0] p[1] p[2] p[3]]
+ */
+inline Frames2 loadLanes(const Sample* p) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_loadu_ps(p)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vld1q_f32(p)};
+#else
+    return Frames2{{p[0], p[1], p[2], p[3]}};
+#endif
+}
+
+/**
+ * @brief Split non-negative lanes into integer and fractional parts.
+ * @param x Lanes in [0, 2^31)
+ * @param index Receives the four truncated integer parts
+ * @return x - index, lane by lane
+ */
+inline Frames2 split(Frames2 x, int32_t* index) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    const __m128i i = _mm_cvttps_epi32(x.v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(index), i);
+    return Frames2{_mm_sub_ps(x.v, _mm_cvtepi32_ps(i))};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    const int32x4_t i = vcvtq_s32_f32(x.v);
+    vst1q_s32(index, i);
+    return Frames2{vsubq_f32(x.v, vcvtq_f32_s32(i))};
+#else
+    Frames2 r;
+    for (int k = 0; k < 4; ++k) {
+        index[k] = static_cast<int32_t>(x.v[k]);
+        r.v[k] = x.v[k] - static_cast<Sample>(index[k]);
+    }
+    return r;
+#endif
+}
+
+/**
+ * @brief Spread the first two lanes over both frames.
+ * @return [x0 x0 x1 x1]
+ */
+inline Frames2 spreadLow(Frames2 x) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_unpacklo_ps(x.v, x.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vzipq_f32(x.v, x.v).val[0]};
+#else
+    return Frames2{{x.v[0], x.v[0], x.v[1], x.v[1]}};
+#endif
+}
+
+/**
+ * @brief Spread the last two lanes over both frames.
+ * @return [x2 x2 x3 x3]
+ */
+inline Frames2 spreadHigh(Frames2 x) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_unpackhi_ps(x.v, x.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vzipq_f32(x.v, x.v).val[1]};
+#else
+    return Frames2{{x.v[2], x.v[2], x.v[3], x.v[3]}};
+#endif
+}
+
+inline Frames2 operator+(Frames2 a, Frames2 b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_add_ps(a.v, b.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vaddq_f32(a.v, b.v)};
+#else
+    return Frames2{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+#endif
+}
+
+inline Frames2 operator-(Frames2 a, Frames2 b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_sub_ps(a.v, b.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vsubq_f32(a.v, b.v)};
+#else
+    return Frames2{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+#endif
+}
+
+inline Frames2 operator*(Frames2 a, Frames2 b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_mul_ps(a.v, b.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vmulq_f32(a.v, b.v)};
+#else
+    return Frames2{{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+#endif
+}
+
+inline Frames2 operator/(Frames2 a, Frames2 b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_div_ps(a.v, b.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON) && defined(__aarch64__)
+    return Frames2{vdivq_f32(a.v, b.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    // ARMv7 NEON has no exact divide
+    float x[4];
+    float y[4];
+    vst1q_f32(x, a.v);
+    vst1q_f32(y, b.v);
+    for (int k = 0; k < 4; ++k) {
+        x[k] /= y[k];
+    }
+    return Frames2{vld1q_f32(x)};
+#else
+    return Frames2{{a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]}};
+#endif
+}
+
+/**
+ * @brief Lane-wise minimum, a < b ? a : b.
+ */
+inline Frames2 min(Frames2 a, Frames2 b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_min_ps(a.v, b.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vminq_f32(a.v, b.v)};
+#else
+    Frames2 r;
+    for (int k = 0; k < 4; ++k) {
+        r.v[k] = a.v[k] < b.v[k] ? a.v[k] : b.v[k];
+    }
+    return r;
+#endif
+}
+
+/**
+ * @brief Lane-wise maximum, a > b ? a : b.
+ */
+inline Frames2 max(Frames2 a, Frames2 b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    return Frames2{_mm_max_ps(a.v, b.v)};
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    return Frames2{vmaxq_f32(a.v, b.v)};
+#else
+    Frames2 r;
+    for (int k = 0; k < 4; ++k) {
+        r.v[k] = a.v[k] > b.v[k] ? a.v[k] : b.v[k];
+    }
+    return r;
+#endif
+}
+
+/**
+ * @brief Lane-wise tanhApprox(), same result as the scalar form.
+ */
+inline Frames2 tanhApprox(Frames2 x) noexcept {
+    x = min(max(x, splat(-4.97f)), splat(4.97f));
+    const Frames2 x2 = x * x;
+    return x * (splat(135135.0f) + x2 * (splat(17325.0f) + x2 * (splat(378.0f) + x2))) /
+           (splat(135135.0f) + x2 * (splat(62370.0f) + x2 * (splat(3150.0f) + splat(28.0f) * x2)));
+}
+
+/**
+ * @brief Store four contiguous lanes.
+ * @param x Lanes
+ * @param p Receives four samples (any alignment)
+ */
+inline void storeLanes(Frames2 x, Sample* p) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    _mm_storeu_ps(p, x.v);
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    vst1q_f32(p, x.v);
+#else
+    p[0] = x.v[0];
+    p[1] = x.v[1];
+    p[2] = x.v[2];
+    p[3] = x.v[3];
+#endif
+}
+
+/**
+ * @brief Store two interleaved stereo frames to unrelated addresses.
+ * @param x Frames [La Ra Lb Rb]
+ * @param a Receives La, Ra (any alignment)
+ * @param b Receives Lb, Rb (any alignment)
+ */
+inline void store(Frames2 x, Sample* a, Sample* b) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    _mm_storel_pi(reinterpret_cast<__m64*>(a), x.v);
+    _mm_storeh_pi(reinterpret_cast<__m64*>(b), x.v);
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    vst1_f32(a, vget_low_f32(x.v));
+    vst1_f32(b, vget_high_f32(x.v));
+#else
+    a[0] = x.v[0];
+    a[1] = x.v[1];
+    b[0] = x.v[2];
+    b[1] = x.v[3];
+#endif
+}
+
+/**
+ * @brief Store two frames deinterleaved.
+ * @param x Frames [La Ra Lb Rb]
+ * @param left Receives La, Lb
+ * @param right Receives Ra, Rb
+ */
+inline void storeSplit(Frames2 x, Sample* left, Sample* right) noexcept {
+#if defined(SUBCOLLIDER_SIMD_SSE2)
+    const __m128 s = _mm_shuffle_ps(x.v, x.v, _MM_SHUFFLE(3, 1, 2, 0));  // [La Lb Ra Rb]
+    _mm_storel_pi(reinterpret_cast<__m64*>(left), s);
+    _mm_storeh_pi(reinterpret_cast<__m64*>(right), s);
+#elif defined(SUBCOLLIDER_SIMD_NEON)
+    const float32x2x2_t s = vuzp_f32(vget_low_f32(x.v), vget_high_f32(x.v));
+    vst1_f32(left, s.val[0]);
+    vst1_f32(right, s.val[1]);
+#else
+    left[0] = x.v[0];
+    right[0] = x.v[1];
+    left[1] = x.v[2];
+    right[1] = x.v[3];
+#endif
+}
+
+} // namespace simd
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_SIMD_H
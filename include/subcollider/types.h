@@ -9,6 +9,7 @@
 #ifndef SUBCOLLIDER_TYPES_H
 #define SUBCOLLIDER_TYPES_H
 
+#include <cmath>
 #include <cstdint>
 #include <cstddef>
 
@@ -54,6 +55,39 @@ inline constexpr Sample clamp(Sample value, Sample min, Sample max) noexcept {
     return value < min ? min : (value > max ? max : value);
 }
 
+/**
+ * @brief Rational tanh approximation with no libm call, so loops over it
+ *        vectorize.
+ *
+ * Pade (7, 6) approximant with the input clamped to [-4.97, 4.97], where
+ * it meets +/-1; absolute error is below 1e-4 everywhere.
+ *
+ * @param x Input
+ * @return Approximately tanh(x)
+ */
+template<typename T>
+inline constexpr T tanhApprox(T x) noexcept {
+    x = x < T(-4.97) ? T(-4.97) : (x > T(4.97) ? T(4.97) : x);
+    const T x2 = x * x;
+    return x * (T(135135) + x2 * (T(17325) + x2 * (T(378) + x2))) /
+           (T(135135) + x2 * (T(62370) + x2 * (T(3150) + T(28) * x2)));
+}
+
+/**
+ * @brief tanh at a filter's internal precision: std::tanh for double,
+ *        tanhApprox for float, where the libm call would dominate.
+ * @param x Input
+ * @return tanh(x)
+ */
+inline double precisionTanh(double x) noexcept {
+    return std::tanh(x);
+}
+
+/// @copydoc precisionTanh(double)
+inline float precisionTanh(float x) noexcept {
+    return tanhApprox(x);
+}
+
 /**
  * @brief Stereo sample pair for dual-channel audio.
  *
@@ -74,6 +108,37 @@ struct Stereo {
     explicit constexpr Stereo(Sample mono) noexcept : left(mono), right(mono) {}
 };
 
+/**
+ * @brief Small linear congruential PRNG (Numerical Recipes constants).
+ *
+ * Four bytes of state and no heap. LFNoise2 and GrainCloud draw their
+ * random values from it, and it seeds voice phases and the like. Fine
+ * for audio randomness, not for statistics.
+ */
+struct Lcg {
+    uint32_t state;  ///< Current state
+
+    /// Construct with a seed
+    constexpr explicit Lcg(uint32_t seed = 12345u) noexcept : state(seed) {}
+
+    /// Advance and return the raw 32-bit state
+    inline uint32_t next() noexcept {
+        state = state * 1664525u + 1013904223u;
+        return state;
+    }
+
+    /// Next value in [0, 1), from the well-mixed top 24 bits
+    inline Sample nextUnipolar() noexcept {
+        return static_cast<Sample>(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /// Next value in [-1, 1), from the top 24 bits (a float of the whole
+    /// state would round the largest states up to exactly 1)
+    inline Sample nextBipolar() noexcept {
+        return static_cast<Sample>(next() >> 8) * (1.0f / 8388608.0f) - 1.0f;
+    }
+};
+
 } // namespace subcollider
 
 #endif // SUBCOLLIDER_TYPES_H
@@ -45,7 +45,7 @@ struct CombC {
     /// Sample rate in Hz
     Sample sampleRate;
 
-    /// Delay buffer
+    /// Delay buffer (bufferSize samples plus guard samples at each end)
     Sample* buffer;
 
     /// Maximum delay time in seconds
@@ -75,10 +75,11 @@ struct CombC {
         sampleRate = sr;
         maxDelayTime = maxDelay;
 
-        // Allocate buffer (add extra samples for interpolation)
+        // Allocate buffer (add extra samples for interpolation), plus
+        // GUARD_BEFORE + GUARD_AFTER mirrored samples around the line
         bufferSize = static_cast<size_t>(std::ceil(maxDelayTime * sampleRate)) + 4;
-        buffer = new Sample[bufferSize];
-        std::memset(buffer, 0, bufferSize * sizeof(Sample));
+        buffer = new Sample[bufferSize + GUARD_BEFORE + GUARD_AFTER];
+        std::memset(buffer, 0, (bufferSize + GUARD_BEFORE + GUARD_AFTER) * sizeof(Sample));
 
         writePos = 0;
         delayTime = 0.2f;
@@ -135,17 +136,18 @@ struct CombC {
         // Get integer and fractional parts
         size_t readPosInt = static_cast<size_t>(readPosFloat);
         Sample frac = readPosFloat - static_cast<Sample>(readPosInt);
+        if (readPosInt >= bufferSize) {
+            // Rounding can land exactly on bufferSize after the wrap above
+            readPosInt -= bufferSize;
+        }
 
-        // Get 4 samples for cubic interpolation (y0, y1, y2, y3)
-        size_t idx0 = (readPosInt + bufferSize - 1) % bufferSize;
-        size_t idx1 = readPosInt % bufferSize;
-        size_t idx2 = (readPosInt + 1) % bufferSize;
-        size_t idx3 = (readPosInt + 2) % bufferSize;
-
-        Sample y0 = buffer[idx0];
-        Sample y1 = buffer[idx1];
-        Sample y2 = buffer[idx2];
-        Sample y3 = buffer[idx3];
+        // Get 4 samples for cubic interpolation (y0, y1, y2, y3); the
+        // guard samples mirror the other end, so no index wrapping
+        const Sample* line = buffer + GUARD_BEFORE + readPosInt;
+        Sample y0 = line[-1];
+        Sample y1 = line[0];
+        Sample y2 = line[1];
+        Sample y3 = line[2];
 
         // 4-point Hermite interpolation
         Sample c0 = y1;
@@ -157,10 +159,12 @@ struct CombC {
 
         // Apply feedback and write to buffer
         Sample output = input + feedbackCoeff * delayedSample;
-        buffer[writePos] = output;
+        write(output);
 
         // Advance write position
-        writePos = (writePos + 1) % bufferSize;
+        if (++writePos == bufferSize) {
+            writePos = 0;
+        }
 
         return delayedSample;
     }
@@ -181,12 +185,32 @@ struct CombC {
      */
     void reset() noexcept {
         if (buffer) {
-            std::memset(buffer, 0, bufferSize * sizeof(Sample));
+            std::memset(buffer, 0, (bufferSize + GUARD_BEFORE + GUARD_AFTER) * sizeof(Sample));
         }
         writePos = 0;
     }
 
 private:
+    /// Guard samples before the line (copy of its last sample)
+    static constexpr size_t GUARD_BEFORE = 1;
+
+    /// Guard samples after the line (copies of its first samples)
+    static constexpr size_t GUARD_AFTER = 2;
+
+    /**
+     * @brief Write the sample at writePos and its guard copy, if any.
+     * @param value Sample to store
+     */
+    inline void write(Sample value) noexcept {
+        Sample* line = buffer + GUARD_BEFORE;
+        line[writePos] = value;
+        if (writePos < GUARD_AFTER) {
+            line[bufferSize + writePos] = value;
+        } else if (writePos == bufferSize - 1) {
+            line[-1] = value;
+        }
+    }
+
     /**
      * @brief Update feedback coefficient based on delay and decay times.
      *
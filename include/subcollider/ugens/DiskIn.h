@@ -0,0 +1,277 @@
+/**
+ * @file DiskIn.h
+ * @brief Streaming sound file player UGen.
+ *
+ * DiskIn plays a WAV file of any length through a small per-voice ring
+ * buffer. A background I/O thread (DiskStreamer) decodes the file into
+ * the ring ahead of the playhead; the audio thread only reads the ring,
+ * so it never touches the file system. No heap allocation occurs.
+ */
+
+#ifndef SUBCOLLIDER_UGENS_DISKIN_H
+#define SUBCOLLIDER_UGENS_DISKIN_H
+
+#include "../types.h"
+#include "../WavFile.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+namespace ugens {
+
+#if defined(SUBCOLLIDER_HAS_MMAP)
+
+/**
+ * @brief Streaming file player with a lock-free refill ring.
+ *
+ * @tparam RingFrames Ring capacity in frames (power of two). 16384 frames
+ *                    is about 340 ms at 48 kHz.
+ *
+ * The ring is single-producer/single-consumer: refill() runs on the I/O
+ * thread and writes frames in front of the playhead; tick()/process() run
+ * on the audio thread and consume them. Each side publishes its frame
+ * counter with release ordering, so decoded samples are visible before
+ * the audio thread reads them.
+ *
+ * The file plays at its own sample rate (one file frame per output
+ * sample). Mono files produce mono rings; tickStereo() duplicates them.
+ * Files with more than two channels play their first two.
+ *
+ * If the ring runs dry the output is silence and every missing frame is
+ * added to underrunCount(). Once a non-looping file has been played to
+ * the end the output is silence and isDone() is true; that is not an
+ * underrun.
+ *
+ * Usage:
+ * @code
+ * WavFile stem;
+ * stem.open("stems/drums.wav");
+ * DiskIn<> disk;
+ * disk.open(&stem, true);   // prefills the ring on this thread
+ * streamer.add(disk);       // DiskStreamer keeps it topped up
+ *
+ * // Audio thread:
+ * disk.processStereo(left, right, 64);
+ * @endcode
+ */
+template<size_t RingFrames = 16384>
+struct DiskIn {
+    static_assert(RingFrames >= 64 && (RingFrames & (RingFrames - 1)) == 0,
+                  "DiskIn ring size must be a power of two of at least 64 frames");
+
+    /**
+     * @brief Attach a file and prefill the ring (not real-time safe).
+     * @param wav Open WAV file (must outlive playback)
+     * @param loopEnabled true to wrap to the start at end of file
+     * @param startFrame First frame to play
+     *
+     * Call while the stream is not registered with a DiskStreamer.
+     */
+    void open(const WavFile* wav, bool loopEnabled = false, size_t startFrame = 0) noexcept {
+        file = wav;
+        loop = loopEnabled;
+        const bool valid = wav != nullptr && wav->isOpen();
+        channels = valid && wav->info().channels >= 2 ? 2 : 1;
+        fileFrame_ = valid && startFrame < wav->info().frames ? startFrame : 0;
+        written_.store(0, std::memory_order_relaxed);
+        read_.store(0, std::memory_order_relaxed);
+        ended_.store(!valid, std::memory_order_relaxed);
+        underruns_.store(0, std::memory_order_relaxed);
+        available_ = 0;
+        if (valid) {
+            refill();
+        }
+    }
+
+    /**
+     * @brief Decode frames into the free part of the ring (I/O thread).
+     * @return Number of frames written
+     */
+    size_t refill() noexcept {
+        if (file == nullptr || ended_.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        const WavInfo& info = file->info();
+        const size_t writePos = written_.load(std::memory_order_relaxed);
+        size_t space = RingFrames - (writePos - read_.load(std::memory_order_acquire));
+        size_t done = 0;
+        while (space > 0) {
+            if (fileFrame_ >= info.frames) {
+                if (!loop) {
+                    written_.store(writePos + done, std::memory_order_release);
+                    ended_.store(true, std::memory_order_release);
+                    return done;
+                }
+                fileFrame_ = 0;
+            }
+            // Contiguous run: limited by ring wrap, file end and free space
+            const size_t slot = (writePos + done) & MASK;
+            size_t count = RingFrames - slot;
+            if (count > space) {
+                count = space;
+            }
+            if (count > info.frames - fileFrame_) {
+                count = info.frames - fileFrame_;
+            }
+            info.convert(file->bytes(), ring_ + slot * channels, channels, count, fileFrame_);
+            fileFrame_ += count;
+            done += count;
+            space -= count;
+        }
+        written_.store(writePos + done, std::memory_order_release);
+        return done;
+    }
+
+    /**
+     * @brief Read the next mono sample (left channel for stereo files).
+     * @return Sample, or 0 on underrun or after the end
+     */
+    inline Sample tick() noexcept {
+        if (!acquireFrames(1)) {
+            return 0.0f;
+        }
+        const size_t pos = read_.load(std::memory_order_relaxed);
+        const Sample s = ring_[(pos & MASK) * channels];
+        consume(pos, 1);
+        return s;
+    }
+
+    /**
+     * @brief Read the next stereo frame.
+     * @return Frame (mono files duplicated), or silence on underrun or after the end
+     */
+    inline Stereo tickStereo() noexcept {
+        if (!acquireFrames(1)) {
+            return Stereo();
+        }
+        const size_t pos = read_.load(std::memory_order_relaxed);
+        const Sample* frame = ring_ + (pos & MASK) * channels;
+        const Stereo s = channels == 2 ? Stereo(frame[0], frame[1]) : Stereo(frame[0]);
+        consume(pos, 1);
+        return s;
+    }
+
+    /**
+     * @brief Process a block of mono samples.
+     * @param output Output buffer
+     * @param numSamples Number of samples to process
+     */
+    void process(Sample* output, size_t numSamples) noexcept {
+        const size_t n = readable(numSamples);
+        const size_t pos = read_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < n; ++i) {
+            output[i] = ring_[((pos + i) & MASK) * channels];
+        }
+        consume(pos, n);
+        fillSilence(output + n, nullptr, numSamples - n);
+    }
+
+    /**
+     * @brief Process a block of stereo samples.
+     * @param left Output buffer for left channel
+     * @param right Output buffer for right channel
+     * @param numSamples Number of samples to process
+     */
+    void processStereo(Sample* left, Sample* right, size_t numSamples) noexcept {
+        const size_t n = readable(numSamples);
+        const size_t pos = read_.load(std::memory_order_relaxed);
+        const size_t rightOffset = channels == 2 ? 1 : 0;
+        for (size_t i = 0; i < n; ++i) {
+            const Sample* frame = ring_ + ((pos + i) & MASK) * channels;
+            left[i] = frame[0];
+            right[i] = frame[rightOffset];
+        }
+        consume(pos, n);
+        fillSilence(left + n, right + n, numSamples - n);
+    }
+
+    /**
+     * @brief Get the number of frames buffered ahead of the playhead.
+     * @return Frames ready to play (audio thread)
+     */
+    size_t buffered() const noexcept {
+        return written_.load(std::memory_order_acquire) - read_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of output frames lost to an empty ring.
+     * @return Underrun frames since open()
+     */
+    uint32_t underrunCount() const noexcept {
+        return underruns_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check whether a non-looping file has finished playing.
+     * @return true once the last frame has been played
+     */
+    bool isDone() const noexcept {
+        return ended_.load(std::memory_order_acquire) && buffered() == 0;
+    }
+
+    /// Ring capacity in frames
+    static constexpr size_t capacity() noexcept {
+        return RingFrames;
+    }
+
+    /// File being streamed
+    const WavFile* file = nullptr;
+
+    /// Wrap to the start at end of file
+    bool loop = false;
+
+    /// Channels stored in the ring (1 or 2)
+    uint8_t channels = 1;
+
+private:
+    static constexpr size_t MASK = RingFrames - 1;
+
+    /// Frames the audio thread may read now, at most want (counts underruns)
+    size_t readable(size_t want) noexcept {
+        bool ended = false;
+        if (available_ < want) {
+            // Load the flag first: all frames are published before it is set
+            ended = ended_.load(std::memory_order_acquire);
+            available_ = buffered();
+        }
+        const size_t n = available_ < want ? available_ : want;
+        if (n < want && !ended && !ended_.load(std::memory_order_acquire)) {
+            underruns_.fetch_add(static_cast<uint32_t>(want - n), std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    bool acquireFrames(size_t want) noexcept {
+        return readable(want) == want;
+    }
+
+    void consume(size_t pos, size_t n) noexcept {
+        available_ -= n;
+        read_.store(pos + n, std::memory_order_release);
+    }
+
+    static void fillSilence(Sample* a, Sample* b, size_t n) noexcept {
+        for (size_t k = 0; k < n; ++k) {
+            a[k] = 0.0f;
+            if (b != nullptr) {
+                b[k] = 0.0f;
+            }
+        }
+    }
+
+    Sample ring_[RingFrames * 2];                 ///< Interleaved frames, channels wide
+    size_t fileFrame_ = 0;                        ///< Next file frame to decode (I/O thread)
+    size_t available_ = 0;                        ///< Cached readable frames (audio thread)
+    alignas(64) std::atomic<size_t> written_{0};  ///< Frames decoded (I/O thread)
+    alignas(64) std::atomic<size_t> read_{0};     ///< Frames played (audio thread)
+    std::atomic<uint32_t> underruns_{0};          ///< Frames lost to an empty ring
+    std::atomic<bool> ended_{true};               ///< Non-looping file fully decoded
+};
+
+#endif // SUBCOLLIDER_HAS_MMAP
+
+} // namespace ugens
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_UGENS_DISKIN_H
@@ -0,0 +1,561 @@
+/**
+ * @file GrainCloud.h
+ * @brief Granular synthesis UGen: a pool of short windowed grains read
+ *        from one shared Buffer.
+ *
+ * A cloud of hundreds of grains built from XPlay instances pays for an
+ * envelope, a lag, a crossfader and two read heads per grain. GrainCloud
+ * keeps only what a grain needs (read position, rate, window phase, pan
+ * gains, frames left) in a fixed pool and renders all of them into one
+ * interleaved mix buffer per batch. Designed for embedded use with no
+ * heap allocation and no virtual calls.
+ */
+
+#ifndef SUBCOLLIDER_UGENS_GRAINCLOUD_H
+#define SUBCOLLIDER_UGENS_GRAINCLOUD_H
+
+#include "../types.h"
+#include "../Buffer.h"
+#include "../simd.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+namespace ugens {
+
+/**
+ * @brief Hann window table shared by every GrainCloud.
+ *
+ * Every point is stored twice, [w0 w0 w1 w1 ...], so simd::load() of two
+ * points yields a window value per stereo frame, ready to multiply with.
+ * Points 0..SIZE span the window; one zero point after it lets the last
+ * segment (and a phase rounded up to SIZE) interpolate without a check.
+ * Built on first use of instance(), which GrainCloud::init() triggers.
+ */
+struct GrainWindow {
+    /// Window segments
+    static constexpr size_t SIZE = 1024;
+
+    /// Window points, each duplicated; 0 at both ends
+    Sample values[(SIZE + 2) * 2];
+
+    /**
+     * @brief Get the shared table, building it on first use.
+     * @return Window table
+     */
+    static const GrainWindow& instance() noexcept {
+        static const GrainWindow table;
+        return table;
+    }
+
+private:
+    GrainWindow() noexcept {
+        const double twoPi = 6.28318530717958647692;
+        for (size_t i = 0; i <= SIZE; ++i) {
+            const Sample w = static_cast<Sample>(
+                0.5 - 0.5 * std::cos(twoPi * static_cast<double>(i) / static_cast<double>(SIZE)));
+            values[i * 2] = w;
+            values[i * 2 + 1] = w;
+        }
+        values[(SIZE + 1) * 2] = 0.0f;
+        values[(SIZE + 1) * 2 + 1] = 0.0f;
+    }
+};
+
+/**
+ * @brief Granular cloud over one buffer.
+ *
+ * @tparam MaxGrains Grain pool capacity
+ *
+ * This is a static struct with block processing, suitable for embedded
+ * DSP with no heap allocation.
+ *
+ * Grains are spawned either by the built-in scheduler (density grains per
+ * second, each drawing its position, rate and pan around the cloud
+ * settings with random jitter) or explicitly with spawn(). Each grain
+ * reads the buffer with linear interpolation at its own rate, wrapping
+ * around the buffer ends, under a Hann window from the shared table, and
+ * is panned with equal-power gains (a balance for stereo buffers). When
+ * the pool is full new grains are dropped and counted in dropped.
+ *
+ * Grains are rendered one at a time over batches of up to CHUNK frames:
+ * two output frames per step go through one simd::Frames2 register, for
+ * the interpolation, window, pan gain and the accumulation into the
+ * interleaved mix alike, and the read and window positions of both frames
+ * advance together in a second register. Reads near the buffer ends take
+ * a scalar wrapping path. tick() renders a one-frame batch; it matches
+ * process() up to rounding (positions are accumulated per pair rather
+ * than per frame, and grains finishing mid-batch change the mix order).
+ *
+ * Positions are normalized (0 = first frame, 1 = the end of the buffer),
+ * rates are playback ratios (1 = original pitch, adjusted for the buffer
+ * sample rate) and durations are in seconds.
+ *
+ * Usage:
+ * @code
+ * GrainCloud<256> cloud;
+ * cloud.init(48000.0f);
+ * cloud.setBuffer(&buf);
+ * cloud.setDensity(400.0f);          // grains per second
+ * cloud.setDuration(0.08f);          // ~32 grains overlap
+ * cloud.setPosition(0.3f, 0.05f);    // around 30% of the buffer
+ * cloud.setRate(1.0f, 0.01f);
+ * cloud.setPan(0.0f, 0.8f);
+ *
+ * cloud.process(left, right, 64);
+ * @endcode
+ */
+template<size_t MaxGrains = 128>
+struct GrainCloud {
+    static_assert(MaxGrains > 0, "GrainCloud needs at least one grain");
+
+    /// Largest batch rendered at once
+    static constexpr size_t CHUNK = 64;
+
+    /// One sounding grain
+    struct Grain {
+        Sample position;   ///< Read position in frames
+        Sample rate;       ///< Frames advanced per output sample
+        Sample window;     ///< Window table phase [0, GrainWindow::SIZE)
+        Sample windowInc;  ///< Window phase advance per output sample
+        Sample gains[2];   ///< Left/right gain (amplitude and pan)
+        uint32_t remaining;  ///< Output frames left
+        uint32_t delay;      ///< Output frames before the grain starts
+    };
+
+    /// Buffer the grains read from
+    const Buffer* buffer;
+
+    /// Sample rate in Hz
+    Sample sampleRate;
+
+    /// Scheduled grains per second (0 = only explicit spawn())
+    Sample density;
+
+    /// Grain duration in seconds
+    Sample duration;
+
+    /// Normalized read position of scheduled grains
+    Sample position;
+
+    /// Random offset added to position, +/- this much
+    Sample positionJitter;
+
+    /// Playback ratio of scheduled grains
+    Sample rate;
+
+    /// Random rate deviation, +/- this fraction of rate
+    Sample rateJitter;
+
+    /// Pan of scheduled grains [-1, 1]
+    Sample pan;
+
+    /// Random pan offset, +/- this much
+    Sample panSpread;
+
+    /// Grain amplitude
+    Sample amp;
+
+    /// Grains not started because the pool was full
+    uint32_t dropped;
+
+    /// Random state (LCG, as in LFNoise2)
+    Lcg rng;
+
+    /**
+     * @brief Initialize the cloud.
+     * @param sr Sample rate in Hz (default: 48000)
+     * @param initialSeed Random seed (default: 12345)
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE, uint32_t initialSeed = 12345) noexcept {
+        buffer = nullptr;
+        sampleRate = sr;
+        density = 0.0f;
+        duration = 0.05f;
+        position = 0.0f;
+        positionJitter = 0.0f;
+        rate = 1.0f;
+        rateJitter = 0.0f;
+        pan = 0.0f;
+        panSpread = 0.0f;
+        amp = 1.0f;
+        dropped = 0;
+        rng.state = initialSeed;
+        window_ = GrainWindow::instance().values;
+        numActive_ = 0;
+        interval_ = 0.0f;
+        countdown_ = 0.0f;
+    }
+
+    /**
+     * @brief Set the buffer to read from (stops every grain).
+     * @param buf Mono or stereo buffer
+     */
+    void setBuffer(const Buffer* buf) noexcept {
+        buffer = buf;
+        numActive_ = 0;
+    }
+
+    /**
+     * @brief Set the scheduler density.
+     * @param grainsPerSecond Grains started per second (0 stops the scheduler)
+     */
+    void setDensity(Sample grainsPerSecond) noexcept {
+        const bool wasOff = interval_ <= 0.0f;
+        density = grainsPerSecond > 0.0f ? grainsPerSecond : 0.0f;
+        interval_ = density > 0.0f ? sampleRate / density : 0.0f;
+        if (wasOff) {
+            countdown_ = 0.0f;  // First grain on the next sample
+        } else if (countdown_ > interval_) {
+            countdown_ = interval_;
+        }
+    }
+
+    /**
+     * @brief Set the duration of scheduled grains.
+     * @param seconds Grain length
+     */
+    void setDuration(Sample seconds) noexcept {
+        duration = seconds;
+    }
+
+    /**
+     * @brief Set the read position of scheduled grains.
+     * @param pos Normalized position [0, 1)
+     * @param jitter Random offset range (normalized)
+     */
+    void setPosition(Sample pos, Sample jitter = 0.0f) noexcept {
+        position = pos;
+        positionJitter = jitter;
+    }
+
+    /**
+     * @brief Set the playback rate of scheduled grains.
+     * @param ratio Playback ratio (negative plays backwards)
+     * @param jitter Random deviation as a fraction of ratio
+     */
+    void setRate(Sample ratio, Sample jitter = 0.0f) noexcept {
+        rate = ratio;
+        rateJitter = jitter;
+    }
+
+    /**
+     * @brief Set the pan of scheduled grains.
+     * @param panPosition Pan [-1 = left, 1 = right]
+     * @param spread Random offset range
+     */
+    void setPan(Sample panPosition, Sample spread = 0.0f) noexcept {
+        pan = panPosition;
+        panSpread = spread;
+    }
+
+    /**
+     * @brief Set the amplitude of scheduled grains.
+     * @param amplitude Linear gain
+     */
+    void setAmp(Sample amplitude) noexcept {
+        amp = amplitude;
+    }
+
+    /**
+     * @brief Start one grain.
+     * @param pos Normalized read position of the first frame
+     * @param ratio Playback ratio
+     * @param seconds Grain length
+     * @param panPosition Pan [-1, 1]
+     * @param amplitude Linear gain
+     * @param offset Output frames from the next frame rendered to the start
+     * @return false if there is no buffer, the grain is empty or the pool is full
+     */
+    bool spawn(Sample pos, Sample ratio, Sample seconds, Sample panPosition,
+               Sample amplitude = 1.0f, size_t offset = 0) noexcept {
+        if (buffer == nullptr || !buffer->isValid()) {
+            return false;
+        }
+        const Sample frames = seconds * sampleRate;
+        if (!(frames >= 1.0f)) {
+            return false;
+        }
+        if (numActive_ >= MaxGrains) {
+            ++dropped;
+            return false;
+        }
+        const Sample numSamples = static_cast<Sample>(buffer->numSamples);
+        Grain& g = grains_[numActive_++];
+        g.position = wrapPosition(pos * numSamples, numSamples);
+        g.rate = ratio * buffer->sampleRate / sampleRate;
+        g.window = 0.0f;
+        g.remaining = static_cast<uint32_t>(frames + 0.5f);
+        g.windowInc = static_cast<Sample>(GrainWindow::SIZE) / static_cast<Sample>(g.remaining);
+        g.delay = static_cast<uint32_t>(offset);
+
+        // Equal-power pan, as in Pan2
+        const Sample angle = (clamp(panPosition, -1.0f, 1.0f) + 1.0f) * 0.78539816339f;
+        g.gains[0] = amplitude * std::cos(angle);
+        g.gains[1] = amplitude * std::sin(angle);
+        return true;
+    }
+
+    /**
+     * @brief Stop every grain immediately.
+     */
+    void clear() noexcept {
+        numActive_ = 0;
+    }
+
+    /**
+     * @brief Get the number of grains started and not yet finished.
+     * @return Active grain count
+     */
+    size_t activeGrains() const noexcept {
+        return numActive_;
+    }
+
+    /**
+     * @brief Generate one stereo sample.
+     * @return Stereo output
+     */
+    inline Stereo tick() noexcept {
+        Sample left;
+        Sample right;
+        renderChunk(&left, &right, 1);
+        return Stereo(left, right);
+    }
+
+    /**
+     * @brief Process a block of stereo samples.
+     * @param left Output buffer for left channel
+     * @param right Output buffer for right channel
+     * @param numSamples Number of samples to process
+     */
+    void process(Sample* left, Sample* right, size_t numSamples) noexcept {
+        size_t i = 0;
+        while (i < numSamples) {
+            const size_t n = numSamples - i < CHUNK ? numSamples - i : CHUNK;
+            renderChunk(left + i, right + i, n);
+            i += n;
+        }
+    }
+
+private:
+    /**
+     * @brief Schedule, render and mix one batch of at most CHUNK frames.
+     */
+    void renderChunk(Sample* left, Sample* right, size_t n) noexcept {
+        Sample mix[CHUNK * 2];
+        for (size_t i = 0; i < n * 2; ++i) {
+            mix[i] = 0.0f;
+        }
+
+        if (interval_ > 0.0f) {
+            while (countdown_ < static_cast<Sample>(n)) {
+                spawnScheduled(static_cast<size_t>(countdown_));
+                countdown_ += interval_;
+            }
+            countdown_ -= static_cast<Sample>(n);
+        }
+
+        if (buffer != nullptr && buffer->isValid()) {
+            size_t j = 0;
+            while (j < numActive_) {
+                Grain& g = grains_[j];
+                if (g.delay >= n) {
+                    g.delay -= static_cast<uint32_t>(n);
+                    ++j;
+                    continue;
+                }
+                const size_t start = g.delay;
+                const size_t frames = n - start < g.remaining ? n - start : g.remaining;
+                g.delay = 0;
+                if (buffer->channels == 2) {
+                    renderGrain<true>(g, *buffer, mix + start * 2, frames);
+                } else {
+                    renderGrain<false>(g, *buffer, mix + start * 2, frames);
+                }
+                g.remaining -= static_cast<uint32_t>(frames);
+                if (g.remaining == 0) {
+                    grains_[j] = grains_[--numActive_];  // Compact; revisit slot j
+                } else {
+                    ++j;
+                }
+            }
+        } else {
+            numActive_ = 0;
+        }
+
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            simd::storeSplit(simd::load(mix + i * 2, mix + i * 2 + 2), left + i, right + i);
+        }
+        for (; i < n; ++i) {
+            left[i] = mix[i * 2];
+            right[i] = mix[i * 2 + 1];
+        }
+    }
+
+    /// Start a grain from the cloud settings plus jitter
+    void spawnScheduled(size_t offset) noexcept {
+        const Sample pos = position + positionJitter * nextRandom();
+        const Sample ratio = rate * (1.0f + rateJitter * nextRandom());
+        const Sample panPosition = pan + panSpread * nextRandom();
+        spawn(pos, ratio, duration, panPosition, amp, offset);
+    }
+
+    /**
+     * @brief Mix frames of one grain into an interleaved buffer.
+     * @tparam IsStereo Whether buf is a stereo buffer (otherwise mono)
+     * @param mix Interleaved mix at the grain's first frame in this batch
+     */
+    template<bool IsStereo>
+    void renderGrain(Grain& g, const Buffer& buf, Sample* mix, size_t frames) const noexcept {
+        const Sample* data = buf.data;
+        const simd::Frames2 gains = simd::load(g.gains, g.gains);
+        size_t i = 0;
+        while (i < frames) {
+            const size_t run = fastRun(g, buf, frames - i);
+            if (run == 0) {
+                // Near an end: wrap the position and the neighbour
+                const size_t numSamples = buf.numSamples;
+                g.position = wrapPosition(g.position, static_cast<Sample>(numSamples));
+                size_t index0 = static_cast<size_t>(g.position);
+                if (index0 >= numSamples) {
+                    index0 = numSamples - 1;  // Rounded up to the end
+                }
+                const size_t index1 = index0 + 1 < numSamples ? index0 + 1 : 0;
+                mixFrame<IsStereo>(g, data, index0, index1, mix + i * 2);
+                ++i;
+                continue;
+            }
+            const size_t end = i + run;
+            const size_t pairs = run / 2;
+            if (pairs > 0) {
+                // Read and window positions of both frames, [pa pb wa wb]
+                simd::Frames2 ph = simd::set(g.position, g.position + g.rate,
+                                             g.window, g.window + g.windowInc);
+                const Sample span = static_cast<Sample>(pairs * 2);
+                const simd::Frames2 step = simd::set(2.0f * g.rate, 2.0f * g.rate,
+                                                     2.0f * g.windowInc, 2.0f * g.windowInc);
+                g.position += g.rate * span;
+                g.window += g.windowInc * span;
+                for (size_t k = 0; k < pairs; ++k, i += 2) {
+                    int32_t index[4];
+                    const simd::Frames2 frac = simd::split(ph, index);
+                    ph = ph + step;
+                    const size_t ia = static_cast<size_t>(index[0]);
+                    const size_t ib = static_cast<size_t>(index[1]);
+                    simd::Frames2 y0;
+                    simd::Frames2 y1;
+                    if (IsStereo) {
+                        y0 = simd::load(data + ia * 2, data + ib * 2);
+                        y1 = simd::load(data + ia * 2 + 2, data + ib * 2 + 2);
+                    } else {
+                        y0 = simd::pair(data[ia], data[ib]);
+                        y1 = simd::pair(data[ia + 1], data[ib + 1]);
+                    }
+                    const Sample* wa = window_ + index[2] * 2;
+                    const Sample* wb = window_ + index[3] * 2;
+                    const simd::Frames2 w0 = simd::load(wa, wb);
+                    const simd::Frames2 w1 = simd::load(wa + 2, wb + 2);
+                    const simd::Frames2 t = simd::spreadLow(frac);
+                    const simd::Frames2 w = w0 + simd::spreadHigh(frac) * (w1 - w0);
+                    const simd::Frames2 v = (y0 + t * (y1 - y0)) * w * gains;
+                    Sample* m = mix + i * 2;
+                    simd::store(simd::load(m, m + 2) + v, m, m + 2);
+                }
+            }
+            for (; i < end; ++i) {
+                const size_t index0 = static_cast<size_t>(g.position);
+                mixFrame<IsStereo>(g, data, index0, index0 + 1, mix + i * 2);
+            }
+        }
+    }
+
+    /// Mix one frame of a grain and advance it (same operations as a SIMD lane)
+    template<bool IsStereo>
+    inline void mixFrame(Grain& g, const Sample* data, size_t index0, size_t index1,
+                         Sample* m) const noexcept {
+        const Sample t = g.position - static_cast<Sample>(index0);
+        const Sample w = windowAt(g.window);
+        Sample l;
+        Sample r;
+        if (IsStereo) {
+            l = data[index0 * 2] + t * (data[index1 * 2] - data[index0 * 2]);
+            r = data[index0 * 2 + 1] + t * (data[index1 * 2 + 1] - data[index0 * 2 + 1]);
+        } else {
+            l = data[index0] + t * (data[index1] - data[index0]);
+            r = l;
+        }
+        m[0] = m[0] + l * w * g.gains[0];
+        m[1] = m[1] + r * w * g.gains[1];
+        g.position += g.rate;
+        g.window += g.windowInc;
+    }
+
+    /**
+     * @brief Count the frames a grain can read with no wrapping.
+     * @return Run length (0 if the current position needs the wrapping path)
+     *
+     * Keeps one frame of headroom at both ends so rounding in the
+     * accumulated position cannot step past an edge inside a run.
+     */
+    static size_t fastRun(const Grain& g, const Buffer& buf, size_t remaining) noexcept {
+        // Wrap guards hold frame 0 after the end, so the last frame needs no wrap either
+        const Sample top = static_cast<Sample>(buf.numSamples) -
+                           (buf.hasGuards(Buffer::GuardMode::Wrap, 1) ? 0.0f : 1.0f);
+        const Sample low = 1.0f;
+        const Sample high = top - 1.0f;
+        const Sample p = g.position;
+        if (!(p >= low && p <= high)) {
+            return 0;
+        }
+        Sample steps;
+        if (g.rate > 0.0f) {
+            steps = (high - p) / g.rate;
+        } else if (g.rate < 0.0f) {
+            steps = (low - p) / g.rate;
+        } else {
+            return remaining;
+        }
+        if (steps >= static_cast<Sample>(remaining - 1)) {
+            return remaining;
+        }
+        return static_cast<size_t>(steps) + 1;
+    }
+
+    /// Window value at a table phase (linear between points)
+    inline Sample windowAt(Sample phase) const noexcept {
+        const size_t index = static_cast<size_t>(phase);
+        const Sample frac = phase - static_cast<Sample>(index);
+        const Sample* p = window_ + index * 2;
+        return p[0] + frac * (p[2] - p[0]);
+    }
+
+    /// Wrap a frame position into [0, numSamples)
+    static Sample wrapPosition(Sample p, Sample numSamples) noexcept {
+        if (p >= 0.0f && p < numSamples) {
+            return p;
+        }
+        Sample wrapped = std::fmod(p, numSamples);
+        if (wrapped < 0.0f) {
+            wrapped += numSamples;
+        }
+        return wrapped < numSamples ? wrapped : 0.0f;
+    }
+
+    /// Random value [-1, 1)
+    Sample nextRandom() noexcept {
+        return rng.nextBipolar();
+    }
+
+    Grain grains_[MaxGrains];  ///< Active grains first
+    size_t numActive_;         ///< Active grain count
+    const Sample* window_;     ///< Shared window table
+    Sample interval_;          ///< Samples between scheduled grains (0 = off)
+    Sample countdown_;         ///< Samples until the next scheduled grain
+};
+
+} // namespace ugens
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_UGENS_GRAINCLOUD_H
@@ -38,6 +38,10 @@ namespace ugens {
  *
  * References: "An Improved Virtual Analog Model of the Moog Ladder Filter"
  *
+ * @tparam T Internal precision. ImprovedMoogLadder runs in double with
+ *           std::tanh; ImprovedMoogLadderF runs in float with tanhApprox
+ *           for its five tanh calls per sample.
+ *
  * Usage:
  * @code
  * ImprovedMoogLadder filter;
@@ -52,7 +56,8 @@ namespace ugens {
  * filter.process(buffer, 64);
  * @endcode
  */
-struct ImprovedMoogLadder {
+template<typename T>
+struct ImprovedMoogLadderT {
     /// Sample rate in Hz
     Sample sampleRate;
 
@@ -63,7 +68,7 @@ struct ImprovedMoogLadder {
     Sample resonance;
 
     /// Makeup gain to compensate for level loss at low cutoff
-    double makeupGain;
+    T makeupGain;
 
     /**
      * @brief Initialize the filter.
@@ -75,10 +80,11 @@ struct ImprovedMoogLadder {
         std::memset(dV, 0, sizeof(dV));
         std::memset(tV, 0, sizeof(tV));
 
-        drive = 1.0;
+        drive = T(1);
         x = 0.0;
-        g = 0.0;
-        makeupGain = 1.0;
+        g = T(0);
+        makeupGain = T(1);
+        halfStep = static_cast<T>(1.0 / (2.0 * sampleRate));
 
         setCutoff(1000.0f);
         setResonance(0.1f);
@@ -95,15 +101,15 @@ struct ImprovedMoogLadder {
         cutoff = clamp(c, 0.0f, maxCutoff);
 
         x = (PI * cutoff) / sampleRate;
-        g = 4.0 * PI * VT * cutoff * (1.0 - x) / (1.0 + x);
+        g = static_cast<T>(4.0 * PI * VT * cutoff * (1.0 - x) / (1.0 + x));
 
         // Gentle compensation so output loudness stays more consistent at low cutoff
         double nyquist = sampleRate * 0.5;
         double norm = nyquist > 0.0 ? static_cast<double>(cutoff) / nyquist : 0.0;
         norm = norm < 0.0 ? 0.0 : (norm > 1.0 ? 1.0 : norm);
         // Reciprocal curve with floor to avoid extreme boosts
-        makeupGain = 1.0 / (0.2 + norm);
-        if (makeupGain > 8.0) makeupGain = 8.0;
+        makeupGain = static_cast<T>(1.0 / (0.2 + norm));
+        if (makeupGain > T(8)) makeupGain = T(8);
     }
 
     /**
@@ -119,7 +125,7 @@ struct ImprovedMoogLadder {
      * @param d Drive multiplier (1.0 = no drive)
      */
     void setDrive(Sample d) noexcept {
-        drive = d < 0.0 ? 0.0 : static_cast<double>(d);
+        drive = d < 0.0f ? T(0) : static_cast<T>(d);
     }
 
     /**
@@ -128,28 +134,29 @@ struct ImprovedMoogLadder {
      * @return Filtered sample
      */
     inline Sample tick(Sample input) noexcept {
-        double dV0, dV1, dV2, dV3;
-        double res = resonance * 4.0; // Scale resonance to [0, 4]
+        T dV0, dV1, dV2, dV3;
+        const T res = static_cast<T>(resonance) * T(4); // Scale resonance to [0, 4]
+        const T vtInv = T(1.0 / (2.0 * VT));
 
-        dV0 = -g * (std::tanh((drive * input + res * V[3]) / (2.0 * VT)) + tV[0]);
-        V[0] += (dV0 + dV[0]) / (2.0 * sampleRate);
+        dV0 = -g * (precisionTanh((drive * static_cast<T>(input) + res * V[3]) * vtInv) + tV[0]);
+        V[0] += (dV0 + dV[0]) * halfStep;
         dV[0] = dV0;
-        tV[0] = std::tanh(V[0] / (2.0 * VT));
+        tV[0] = precisionTanh(V[0] * vtInv);
 
         dV1 = g * (tV[0] - tV[1]);
-        V[1] += (dV1 + dV[1]) / (2.0 * sampleRate);
+        V[1] += (dV1 + dV[1]) * halfStep;
         dV[1] = dV1;
-        tV[1] = std::tanh(V[1] / (2.0 * VT));
+        tV[1] = precisionTanh(V[1] * vtInv);
 
         dV2 = g * (tV[1] - tV[2]);
-        V[2] += (dV2 + dV[2]) / (2.0 * sampleRate);
+        V[2] += (dV2 + dV[2]) * halfStep;
         dV[2] = dV2;
-        tV[2] = std::tanh(V[2] / (2.0 * VT));
+        tV[2] = precisionTanh(V[2] * vtInv);
 
         dV3 = g * (tV[2] - tV[3]);
-        V[3] += (dV3 + dV[3]) / (2.0 * sampleRate);
+        V[3] += (dV3 + dV[3]) * halfStep;
         dV[3] = dV3;
-        tV[3] = std::tanh(V[3] / (2.0 * VT));
+        tV[3] = precisionTanh(V[3] * vtInv);
 
         return static_cast<Sample>(V[3] * makeupGain);
     }
@@ -175,18 +182,28 @@ struct ImprovedMoogLadder {
     }
 
 private:
+    // LadderBank lanes copy their coefficients from a configured instance
+    template<typename, size_t> friend struct LadderLanes;
+
     // Thermal voltage (26 milliwatts at room temperature)
     static constexpr double VT = 0.312;
 
-    double V[4];
-    double dV[4];
-    double tV[4];
+    T V[4];
+    T dV[4];
+    T tV[4];
 
-    double x;
-    double g;
-    double drive;
+    double x;       // Normalized cutoff (coefficient design only)
+    T g;
+    T drive;
+    T halfStep;     // Trapezoidal step, 1 / (2 * sampleRate)
 };
 
+/// Double-precision improved ladder (reference)
+using ImprovedMoogLadder = ImprovedMoogLadderT<double>;
+
+/// Single-precision improved ladder (fast path)
+using ImprovedMoogLadderF = ImprovedMoogLadderT<float>;
+
 } // namespace ugens
 } // namespace subcollider
 
@@ -25,6 +25,10 @@ namespace ugens {
  * with several improvements including corrections for cutoff and resonance parameters,
  * and a smoothly saturating tanh() function.
  *
+ * @tparam T Internal precision. KrajeskiMoogLadder runs in double with
+ *           std::tanh; KrajeskiMoogLadderF runs in float with tanhApprox,
+ *           which is several times faster on float-only FPUs.
+ *
  * Usage:
  * @code
  * KrajeskiMoogLadder filter;
@@ -39,7 +43,8 @@ namespace ugens {
  * filter.process(buffer, 64);
  * @endcode
  */
-struct KrajeskiMoogLadder {
+template<typename T>
+struct KrajeskiMoogLadderT {
     /// Sample rate in Hz
     Sample sampleRate;
 
@@ -58,11 +63,11 @@ struct KrajeskiMoogLadder {
         std::memset(state, 0, sizeof(state));
         std::memset(delay, 0, sizeof(delay));
 
-        drive = 1.0;
-        gComp = 1.0;
+        drive = T(1);
+        gComp = T(1);
         wc = 0.0;
-        g = 0.0;
-        gRes = 0.0;
+        g = T(0);
+        gRes = T(0);
 
         setCutoff(1000.0f);
         setResonance(0.1f);
@@ -75,7 +80,7 @@ struct KrajeskiMoogLadder {
     void setCutoff(Sample c) noexcept {
         cutoff = c;
         wc = 2.0 * PI * cutoff / sampleRate;
-        g = 0.9892 * wc - 0.4342 * std::pow(wc, 2) + 0.1381 * std::pow(wc, 3) - 0.0202 * std::pow(wc, 4);
+        g = static_cast<T>(0.9892 * wc - 0.4342 * std::pow(wc, 2) + 0.1381 * std::pow(wc, 3) - 0.0202 * std::pow(wc, 4));
     }
 
     /**
@@ -84,7 +89,7 @@ struct KrajeskiMoogLadder {
      */
     void setResonance(Sample r) noexcept {
         resonance = r < 0.0f ? 0.0f : (r > 1.0f ? 1.0f : r);
-        gRes = resonance * (1.0029 + 0.0526 * wc - 0.926 * std::pow(wc, 2) + 0.0218 * std::pow(wc, 3));
+        gRes = static_cast<T>(resonance * (1.0029 + 0.0526 * wc - 0.926 * std::pow(wc, 2) + 0.0218 * std::pow(wc, 3)));
     }
 
     /**
@@ -93,10 +98,12 @@ struct KrajeskiMoogLadder {
      * @return Filtered sample
      */
     inline Sample tick(Sample input) noexcept {
-        state[0] = std::tanh(drive * (input - 4.0 * gRes * (state[4] - gComp * input)));
+        const T in = static_cast<T>(input);
+        state[0] = precisionTanh(drive * (in - T(4) * gRes * (state[4] - gComp * in)));
 
         for (int i = 0; i < 4; i++) {
-            state[i + 1] = fclamp(g * (0.3 / 1.3 * state[i] + 1.0 / 1.3 * delay[i] - state[i + 1]) + state[i + 1], -1e30, 1e30);
+            state[i + 1] = fclamp(g * (T(0.3 / 1.3) * state[i] + T(1.0 / 1.3) * delay[i] - state[i + 1]) + state[i + 1],
+                                  T(-1e30), T(1e30));
             delay[i] = state[i];
         }
 
@@ -123,19 +130,28 @@ struct KrajeskiMoogLadder {
     }
 
 private:
-    double state[5];
-    double delay[5];
-    double wc;      // The angular frequency of the cutoff.
-    double g;       // A derived parameter for the cutoff frequency
-    double gRes;    // A similar derived parameter for resonance.
-    double gComp;   // Compensation factor.
-    double drive;   // A parameter that controls intensity of nonlinearities.
-
-    inline double fclamp(double in, double min, double max) noexcept {
+    // LadderBank lanes copy their coefficients from a configured instance
+    template<typename, size_t> friend struct LadderLanes;
+
+    T state[5];
+    T delay[5];
+    double wc;      // The angular frequency of the cutoff (coefficient design only).
+    T g;            // A derived parameter for the cutoff frequency
+    T gRes;         // A similar derived parameter for resonance.
+    T gComp;        // Compensation factor.
+    T drive;        // A parameter that controls intensity of nonlinearities.
+
+    inline T fclamp(T in, T min, T max) noexcept {
         return std::fmin(std::fmax(in, min), max);
     }
 };
 
+/// Double-precision Krajeski ladder (reference)
+using KrajeskiMoogLadder = KrajeskiMoogLadderT<double>;
+
+/// Single-precision Krajeski ladder (fast path)
+using KrajeskiMoogLadderF = KrajeskiMoogLadderT<float>;
+
 } // namespace ugens
 } // namespace subcollider
 
@@ -55,7 +55,7 @@ struct LFNoise2 {
     Sample sampleRate;
 
     /// Random state (simple LCG PRNG - no heap allocation)
-    uint32_t seed;
+    Lcg rng;
 
     /**
      * @brief Initialize the noise generator.
@@ -64,7 +64,7 @@ struct LFNoise2 {
      */
     void init(Sample sr = DEFAULT_SAMPLE_RATE, uint32_t initialSeed = 12345) noexcept {
         sampleRate = sr;
-        seed = initialSeed;
+        rng.state = initialSeed;
         frequency = 1.0f;
         phase = 0.0f;
         updatePhaseIncrement();
@@ -92,18 +92,15 @@ struct LFNoise2 {
     }
 
     /**
-     * @brief Generate next random value [-1, 1].
+     * @brief Generate next random value [-1, 1).
      *
-     * Uses a Linear Congruential Generator (LCG) for deterministic,
+     * Uses a Linear Congruential Generator (Lcg) for deterministic,
      * heap-free random number generation.
      *
-     * @return Random value in range [-1, 1]
+     * @return Random value in range [-1, 1)
      */
     Sample nextRandom() noexcept {
-        // LCG parameters (Numerical Recipes)
-        seed = seed * 1664525u + 1013904223u;
-        // Convert to float [-1, 1]
-        return (static_cast<Sample>(seed) / LCG_NORM) - 1.0f;
+        return rng.nextBipolar();
     }
 
     /**
@@ -111,7 +108,7 @@ struct LFNoise2 {
      * @param newSeed New seed value
      */
     void setSeed(uint32_t newSeed) noexcept {
-        seed = newSeed;
+        rng.state = newSeed;
     }
 
     /**
@@ -168,7 +165,7 @@ struct LFNoise2 {
      * @param newSeed Optional new seed value
      */
     void reset(uint32_t newSeed = 12345) noexcept {
-        seed = newSeed;
+        rng.state = newSeed;
         phase = 0.0f;
         for (int i = 0; i < 4; ++i) {
             points[i] = nextRandom();
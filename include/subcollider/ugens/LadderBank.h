@@ -0,0 +1,544 @@
+/**
+ * @file LadderBank.h
+ * @brief Banks of independent Moog ladder filters evaluated side by side
+ *        in SIMD lanes.
+ *
+ * One ladder per voice is a long serial chain per sample: every stage
+ * waits on the one before it, and the vector units sit idle. A bank runs
+ * Lanes independent instances of one model in structure-of-arrays form,
+ * so each step of the chain is a single 4- or 8-wide operation across all
+ * instances (SSE/NEON registers, or two of them per step for 8 lanes).
+ */
+
+#ifndef SUBCOLLIDER_UGENS_LADDERBANK_H
+#define SUBCOLLIDER_UGENS_LADDERBANK_H
+
+#include "../types.h"
+#include "../simd.h"
+#include "StilsonMoogLadder.h"
+#include "MicrotrackerMoogLadder.h"
+#include "KrajeskiMoogLadder.h"
+#include "MusicDSPMoogLadder.h"
+#include "OberheimMoogLadder.h"
+#include "ImprovedMoogLadder.h"
+#include "RKSimulationMoogLadder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace subcollider {
+namespace ugens {
+
+/**
+ * @brief Lane-wise kernel of one ladder model, specialized per model.
+ *
+ * A kernel holds Lanes instances' state and coefficients as float arrays.
+ * configure() copies one lane's coefficients from a scalar model that has
+ * already run its own setCutoff()/setResonance(), so the coefficient math
+ * is never duplicated; tick() filters one sample per lane in place.
+ */
+template<typename Model, size_t Lanes>
+struct LadderLanes;
+
+/**
+ * @brief Bank of Lanes independent ladder filters of one model.
+ *
+ * @tparam Model One of the seven *MoogLadder UGens (double or float variant)
+ * @tparam Lanes Number of instances (multiple of 4; 4 or 8 typical)
+ *
+ * Every lane has its own cutoff and resonance. Input and output are
+ * planar: one buffer per lane, as a voice pool renders them.
+ *
+ * Lanes run in float with the models' default drive (and, for the RK
+ * model, no oversampling). std::tanh, which does not vectorize, is
+ * replaced by tanhApprox(); outputs track the scalar double models to
+ * within about 1e-3 at moderate resonance. Models whose step is plain
+ * arithmetic are left to the compiler's vectorizer; those with clamps
+ * and tanh are written with simd::Frames2, four lanes per register.
+ *
+ * Setters evaluate the scalar model's coefficient formulas for the lane,
+ * so they cost about as much as the scalar setters; call them at control
+ * rate.
+ *
+ * Usage:
+ * @code
+ * LadderBank<KrajeskiMoogLadder, 8> filters;
+ * filters.init(48000.0f);
+ * for (size_t v = 0; v < 8; ++v) {
+ *     filters.setCutoff(v, 500.0f + 200.0f * v);
+ *     filters.setResonance(v, 0.3f);
+ * }
+ *
+ * Sample* voices[8] = { ... };   // One buffer per voice
+ * filters.process(voices, 64);   // In place
+ * @endcode
+ */
+template<typename Model, size_t Lanes>
+struct LadderBank {
+    static_assert(Lanes > 0 && Lanes % 4 == 0, "LadderBank needs a multiple of 4 lanes");
+
+    /// Number of filter instances
+    static constexpr size_t LANES = Lanes;
+
+    /// Sample rate in Hz
+    Sample sampleRate;
+
+    /// Cutoff frequency per lane in Hz (as the model clamped it)
+    Sample cutoff[Lanes];
+
+    /// Resonance per lane [0, 1]
+    Sample resonance[Lanes];
+
+    /// Lane state and coefficients
+    LadderLanes<Model, Lanes> lanes;
+
+    /**
+     * @brief Initialize every lane to the model defaults (1000 Hz, 0.1).
+     * @param sr Sample rate in Hz (default: 48000)
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
+        sampleRate = sr;
+        lanes.reset();
+        for (size_t k = 0; k < Lanes; ++k) {
+            setParameters(k, 1000.0f, 0.1f);
+        }
+    }
+
+    /**
+     * @brief Set one lane's cutoff and resonance together.
+     * @param lane Lane index
+     * @param c Cutoff frequency in Hz
+     * @param r Resonance [0, 1]
+     */
+    void setParameters(size_t lane, Sample c, Sample r) noexcept {
+        Model design{};
+        design.init(sampleRate);
+        design.setCutoff(c);
+        design.setResonance(r);
+        cutoff[lane] = design.cutoff;
+        resonance[lane] = design.resonance;
+        lanes.configure(lane, design);
+    }
+
+    /**
+     * @brief Set one lane's cutoff frequency.
+     * @param lane Lane index
+     * @param c Cutoff frequency in Hz
+     */
+    void setCutoff(size_t lane, Sample c) noexcept {
+        setParameters(lane, c, resonance[lane]);
+    }
+
+    /**
+     * @brief Set one lane's resonance.
+     * @param lane Lane index
+     * @param r Resonance [0, 1]
+     */
+    void setResonance(size_t lane, Sample r) noexcept {
+        setParameters(lane, cutoff[lane], r);
+    }
+
+    /**
+     * @brief Set every lane's cutoff frequency.
+     * @param c Cutoff frequency in Hz
+     */
+    void setCutoff(Sample c) noexcept {
+        for (size_t k = 0; k < Lanes; ++k) {
+            setCutoff(k, c);
+        }
+    }
+
+    /**
+     * @brief Set every lane's resonance.
+     * @param r Resonance [0, 1]
+     */
+    void setResonance(Sample r) noexcept {
+        for (size_t k = 0; k < Lanes; ++k) {
+            setResonance(k, r);
+        }
+    }
+
+    /**
+     * @brief Filter one sample per lane.
+     * @param input Lanes input samples
+     * @param output Lanes output samples (may alias input)
+     */
+    inline void tick(const Sample* input, Sample* output) noexcept {
+        alignas(16) Sample x[Lanes];
+        for (size_t k = 0; k < Lanes; ++k) {
+            x[k] = input[k];
+        }
+        lanes.tick(x);
+        for (size_t k = 0; k < Lanes; ++k) {
+            output[k] = x[k];
+        }
+    }
+
+    /**
+     * @brief Process planar buffers in place.
+     * @param channels Lanes buffers, one per instance
+     * @param numSamples Number of samples per buffer
+     */
+    void process(Sample* const* channels, size_t numSamples) noexcept {
+        process(channels, channels, numSamples);
+    }
+
+    /**
+     * @brief Process planar buffers.
+     * @param inputs Lanes input buffers
+     * @param outputs Lanes output buffers (may be the inputs)
+     * @param numSamples Number of samples per buffer
+     */
+    void process(const Sample* const* inputs, Sample* const* outputs, size_t numSamples) noexcept {
+        alignas(16) Sample x[Lanes];
+        for (size_t i = 0; i < numSamples; ++i) {
+            for (size_t k = 0; k < Lanes; ++k) {
+                x[k] = inputs[k][i];
+            }
+            lanes.tick(x);
+            for (size_t k = 0; k < Lanes; ++k) {
+                outputs[k][i] = x[k];
+            }
+        }
+    }
+
+    /**
+     * @brief Reset every lane's filter state.
+     */
+    void reset() noexcept {
+        lanes.reset();
+    }
+};
+
+/// Stilson: four saturated one-poles with a table-compensated feedback gain
+template<size_t Lanes>
+struct LadderLanes<StilsonMoogLadder, Lanes> {
+    alignas(16) Sample p[Lanes];
+    alignas(16) Sample Q[Lanes];
+    alignas(16) Sample state[4][Lanes];
+    alignas(16) Sample output[Lanes];
+
+    void configure(size_t lane, const StilsonMoogLadder& m) noexcept {
+        p[lane] = static_cast<Sample>(m.p);
+        Q[lane] = static_cast<Sample>(m.Q);
+    }
+
+    void reset() noexcept {
+        std::fill(&state[0][0], &state[0][0] + 4 * Lanes, 0.0f);
+        std::fill(output, output + Lanes, 0.0f);
+    }
+
+    inline void tick(Sample* x) noexcept {
+        for (size_t k = 0; k < Lanes; ++k) {
+            Sample out = 0.25f * (x[k] * 0.65f - output[k]);
+            for (int pole = 0; pole < 4; ++pole) {
+                const Sample local = state[pole][k];
+                out = saturate(out + p[k] * (out - local));
+                state[pole][k] = out;
+                out = saturate(out + local);
+            }
+            out = std::abs(out) > 1.0e-8f ? out : 0.0f;
+            x[k] = out;
+            output[k] = out * Q[k];
+        }
+    }
+
+    static inline Sample saturate(Sample v) noexcept {
+        return 0.5f * (std::abs(v + 0.95f) - std::abs(v - 0.95f));
+    }
+};
+
+/// Microtracker: tanh one-poles and an FIR-smoothed feedback tap
+template<size_t Lanes>
+struct LadderLanes<MicrotrackerMoogLadder, Lanes> {
+    alignas(16) Sample cutoffCoeff[Lanes];
+    alignas(16) Sample k4[Lanes];
+    alignas(16) Sample pole[4][Lanes];
+    alignas(16) Sample tap[3][Lanes];
+
+    void configure(size_t lane, const MicrotrackerMoogLadder& m) noexcept {
+        cutoffCoeff[lane] = static_cast<Sample>(m.cutoffCoeff);
+        k4[lane] = m.resonance * 4.0f;
+    }
+
+    void reset() noexcept {
+        std::fill(&pole[0][0], &pole[0][0] + 4 * Lanes, 0.0f);
+        std::fill(&tap[0][0], &tap[0][0] + 3 * Lanes, 0.0f);
+    }
+
+    inline void tick(Sample* x) noexcept {
+        for (size_t k = 0; k < Lanes; ++k) {
+            const Sample out = pole[3][k] * 0.360891f + tap[0][k] * 0.417290f +
+                               tap[1][k] * 0.177896f + tap[2][k] * 0.0439725f;
+            tap[2][k] = tap[1][k];
+            tap[1][k] = tap[0][k];
+            tap[0][k] = pole[3][k];
+
+            const Sample c = cutoffCoeff[k];
+            const Sample t0 = fastTanh(pole[0][k]);
+            const Sample t1 = fastTanh(pole[1][k]);
+            const Sample t2 = fastTanh(pole[2][k]);
+            pole[0][k] += (fastTanh(x[k] - k4[k] * out) - t0) * c;
+            pole[1][k] += (fastTanh(pole[0][k]) - t1) * c;
+            pole[2][k] += (fastTanh(pole[1][k]) - t2) * c;
+            pole[3][k] += (fastTanh(pole[2][k]) - fastTanh(pole[3][k])) * c;
+            x[k] = out;
+        }
+    }
+
+    static inline Sample fastTanh(Sample v) noexcept {
+        const Sample v2 = v * v;
+        return v * (27.0f + v2) / (27.0f + 9.0f * v2);
+    }
+};
+
+/// Krajeski: tanh input stage and four compensated one-poles
+template<typename T, size_t Lanes>
+struct LadderLanes<KrajeskiMoogLadderT<T>, Lanes> {
+    alignas(16) Sample g[Lanes];
+    alignas(16) Sample gRes4[Lanes];
+    alignas(16) Sample state[5][Lanes];
+    alignas(16) Sample delay[4][Lanes];
+
+    void configure(size_t lane, const KrajeskiMoogLadderT<T>& m) noexcept {
+        g[lane] = static_cast<Sample>(m.g);
+        gRes4[lane] = static_cast<Sample>(4.0 * m.gRes);
+    }
+
+    void reset() noexcept {
+        std::fill(&state[0][0], &state[0][0] + 5 * Lanes, 0.0f);
+        std::fill(&delay[0][0], &delay[0][0] + 4 * Lanes, 0.0f);
+    }
+
+    inline void tick(Sample* x) noexcept {
+        const simd::Frames2 a = simd::splat(0.3f / 1.3f);
+        const simd::Frames2 b = simd::splat(1.0f / 1.3f);
+        const simd::Frames2 lo = simd::splat(-1e30f);
+        const simd::Frames2 hi = simd::splat(1e30f);
+        for (size_t k = 0; k < Lanes; k += 4) {
+            // Drive and gain compensation are 1 in the model
+            const simd::Frames2 in = simd::loadLanes(x + k);
+            const simd::Frames2 gk = simd::loadLanes(g + k);
+            simd::Frames2 s = simd::tanhApprox(in - simd::loadLanes(gRes4 + k) *
+                                                   (simd::loadLanes(state[4] + k) - in));
+            simd::storeLanes(s, state[0] + k);
+            for (int i = 0; i < 4; ++i) {
+                const simd::Frames2 next = simd::loadLanes(state[i + 1] + k);
+                const simd::Frames2 stage = gk * (a * s + b * simd::loadLanes(delay[i] + k) - next) + next;
+                simd::storeLanes(s, delay[i] + k);
+                s = simd::min(simd::max(stage, lo), hi);
+                simd::storeLanes(s, state[i + 1] + k);
+            }
+            simd::storeLanes(s, x + k);
+        }
+    }
+};
+
+/// MusicDSP: bilinear one-poles with a cubic clip on the last stage
+template<size_t Lanes>
+struct LadderLanes<MusicDSPMoogLadder, Lanes> {
+    alignas(16) Sample p[Lanes];
+    alignas(16) Sample kc[Lanes];
+    alignas(16) Sample resonanceCoeff[Lanes];
+    alignas(16) Sample stage[4][Lanes];
+    alignas(16) Sample delay[4][Lanes];
+
+    void configure(size_t lane, const MusicDSPMoogLadder& m) noexcept {
+        p[lane] = static_cast<Sample>(m.p);
+        kc[lane] = static_cast<Sample>(m.k);
+        resonanceCoeff[lane] = static_cast<Sample>(m.resonanceCoeff);
+    }
+
+    void reset() noexcept {
+        std::fill(&stage[0][0], &stage[0][0] + 4 * Lanes, 0.0f);
+        std::fill(&delay[0][0], &delay[0][0] + 4 * Lanes, 0.0f);
+    }
+
+    inline void tick(Sample* x) noexcept {
+        for (size_t k = 0; k < Lanes; ++k) {
+            const Sample in = x[k] - resonanceCoeff[k] * stage[3][k];
+            stage[0][k] = in * p[k] + delay[0][k] * p[k] - kc[k] * stage[0][k];
+            stage[1][k] = stage[0][k] * p[k] + delay[1][k] * p[k] - kc[k] * stage[1][k];
+            stage[2][k] = stage[1][k] * p[k] + delay[2][k] * p[k] - kc[k] * stage[2][k];
+            stage[3][k] = stage[2][k] * p[k] + delay[3][k] * p[k] - kc[k] * stage[3][k];
+            stage[3][k] -= (stage[3][k] * stage[3][k] * stage[3][k]) / 6.0f;
+            delay[0][k] = in;
+            delay[1][k] = stage[0][k];
+            delay[2][k] = stage[1][k];
+            delay[3][k] = stage[2][k];
+            x[k] = stage[3][k];
+        }
+    }
+};
+
+/// Oberheim: zero-delay-feedback one-poles resolved by alpha0, LPF4 tap
+template<typename T, size_t Lanes>
+struct LadderLanes<OberheimMoogLadderT<T>, Lanes> {
+    alignas(16) Sample alpha[Lanes];
+    alignas(16) Sample beta[4][Lanes];
+    alignas(16) Sample K[Lanes];
+    alignas(16) Sample alpha0[Lanes];
+    alignas(16) Sample z1[4][Lanes];
+
+    void configure(size_t lane, const OberheimMoogLadderT<T>& m) noexcept {
+        alpha[lane] = static_cast<Sample>(m.lpf[0].alpha);
+        for (int i = 0; i < 4; ++i) {
+            beta[i][lane] = static_cast<Sample>(m.lpf[i].beta);
+        }
+        K[lane] = static_cast<Sample>(m.K);
+        alpha0[lane] = static_cast<Sample>(m.alpha0);
+    }
+
+    void reset() noexcept {
+        std::fill(&z1[0][0], &z1[0][0] + 4 * Lanes, 0.0f);
+    }
+
+    inline void tick(Sample* x) noexcept {
+        // The model's one-pole gamma, delta, epsilon, a0 and feedback are
+        // fixed at 1, 0, 0, 1 and 0, and saturation at 1
+        const simd::Frames2 one = simd::splat(1.0f);
+        for (size_t k = 0; k < Lanes; k += 4) {
+            simd::Frames2 z[4];
+            simd::Frames2 sigma = simd::splat(0.0f);
+            for (int i = 0; i < 4; ++i) {
+                z[i] = simd::loadLanes(z1[i] + k);
+                sigma = sigma + simd::loadLanes(beta[i] + k) * z[i];
+            }
+            const simd::Frames2 kk = simd::loadLanes(K + k);
+            simd::Frames2 s = simd::tanhApprox((simd::loadLanes(x + k) * (one + kk) - kk * sigma) *
+                                               simd::loadLanes(alpha0 + k));
+            const simd::Frames2 a = simd::loadLanes(alpha + k);
+            for (int i = 0; i < 4; ++i) {
+                const simd::Frames2 vn = (s - z[i]) * a;
+                s = vn + z[i];
+                simd::storeLanes(vn + s, z1[i] + k);
+            }
+            simd::storeLanes(s, x + k);
+        }
+    }
+};
+
+/// Improved (D'Angelo/Valimaki): trapezoidal tanh ladder
+template<typename T, size_t Lanes>
+struct LadderLanes<ImprovedMoogLadderT<T>, Lanes> {
+    alignas(16) Sample g[Lanes];
+    alignas(16) Sample res4[Lanes];
+    alignas(16) Sample makeupGain[Lanes];
+    alignas(16) Sample halfStep[Lanes];
+    alignas(16) Sample V[4][Lanes];
+    alignas(16) Sample dV[4][Lanes];
+    alignas(16) Sample tV[4][Lanes];
+
+    void configure(size_t lane, const ImprovedMoogLadderT<T>& m) noexcept {
+        g[lane] = static_cast<Sample>(m.g);
+        res4[lane] = m.resonance * 4.0f;
+        makeupGain[lane] = static_cast<Sample>(m.makeupGain);
+        halfStep[lane] = static_cast<Sample>(m.halfStep);
+    }
+
+    void reset() noexcept {
+        std::fill(&V[0][0], &V[0][0] + 4 * Lanes, 0.0f);
+        std::fill(&dV[0][0], &dV[0][0] + 4 * Lanes, 0.0f);
+        std::fill(&tV[0][0], &tV[0][0] + 4 * Lanes, 0.0f);
+    }
+
+    inline void tick(Sample* x) noexcept {
+        const simd::Frames2 inv2VT = simd::splat(static_cast<Sample>(1.0 / (2.0 * ImprovedMoogLadderT<T>::VT)));
+        for (size_t k = 0; k < Lanes; k += 4) {
+            const simd::Frames2 gk = simd::loadLanes(g + k);
+            const simd::Frames2 h = simd::loadLanes(halfStep + k);
+            simd::Frames2 prev = simd::loadLanes(tV[0] + k);  // tV of the stage before, updated
+            const simd::Frames2 drive = simd::loadLanes(x + k) +
+                                        simd::loadLanes(res4 + k) * simd::loadLanes(V[3] + k);
+            simd::Frames2 d = (simd::splat(0.0f) - gk) * (simd::tanhApprox(drive * inv2VT) + prev);
+            for (int i = 0; i < 4; ++i) {
+                if (i > 0) {
+                    d = gk * (prev - simd::loadLanes(tV[i] + k));
+                }
+                const simd::Frames2 v = simd::loadLanes(V[i] + k) + (d + simd::loadLanes(dV[i] + k)) * h;
+                simd::storeLanes(v, V[i] + k);
+                simd::storeLanes(d, dV[i] + k);
+                prev = simd::tanhApprox(v * inv2VT);
+                simd::storeLanes(prev, tV[i] + k);
+            }
+            simd::storeLanes(simd::loadLanes(V[3] + k) * simd::loadLanes(makeupGain + k), x + k);
+        }
+    }
+};
+
+/// RK simulation: fourth-order Runge-Kutta over a cubic-clipped ladder
+template<typename T, size_t Lanes>
+struct LadderLanes<RKSimulationMoogLadderT<T>, Lanes> {
+    alignas(16) Sample cutoffCoeff[Lanes];
+    alignas(16) Sample res10[Lanes];
+    alignas(16) Sample makeupGain[Lanes];
+    alignas(16) Sample stepSize[Lanes];
+    alignas(16) Sample state[4][Lanes];
+
+    void configure(size_t lane, const RKSimulationMoogLadderT<T>& m) noexcept {
+        cutoffCoeff[lane] = static_cast<Sample>(m.cutoffCoeff);
+        res10[lane] = m.resonance * 10.0f;
+        makeupGain[lane] = static_cast<Sample>(m.makeupGain);
+        stepSize[lane] = static_cast<Sample>(m.stepSize);
+    }
+
+    void reset() noexcept {
+        std::fill(&state[0][0], &state[0][0] + 4 * Lanes, 0.0f);
+    }
+
+    inline void tick(Sample* x) noexcept {
+        const simd::Frames2 half = simd::splat(0.5f);
+        const simd::Frames2 two = simd::splat(2.0f);
+        const simd::Frames2 sixth = simd::splat(1.0f / 6.0f);
+        for (size_t k = 0; k < Lanes; k += 4) {
+            const simd::Frames2 in = simd::loadLanes(x + k);
+            const simd::Frames2 c = simd::loadLanes(cutoffCoeff + k);
+            const simd::Frames2 r = simd::loadLanes(res10 + k);
+            const simd::Frames2 h = simd::loadLanes(stepSize + k);
+            simd::Frames2 s[4];
+            for (int i = 0; i < 4; ++i) {
+                s[i] = simd::loadLanes(state[i] + k);
+            }
+            simd::Frames2 d1[4];
+            simd::Frames2 d2[4];
+            simd::Frames2 d3[4];
+            simd::Frames2 d4[4];
+            simd::Frames2 t[4];
+            derivatives(in, c, r, s, d1);
+            for (int i = 0; i < 4; ++i) t[i] = s[i] + half * h * d1[i];
+            derivatives(in, c, r, t, d2);
+            for (int i = 0; i < 4; ++i) t[i] = s[i] + half * h * d2[i];
+            derivatives(in, c, r, t, d3);
+            for (int i = 0; i < 4; ++i) t[i] = s[i] + h * d3[i];
+            derivatives(in, c, r, t, d4);
+            for (int i = 0; i < 4; ++i) {
+                s[i] = s[i] + sixth * h * (d1[i] + two * d2[i] + two * d3[i] + d4[i]);
+                simd::storeLanes(s[i], state[i] + k);
+            }
+            simd::storeLanes(s[3] * simd::loadLanes(makeupGain + k), x + k);
+        }
+    }
+
+    /// The model's cubic soft clip at saturation 3
+    static inline simd::Frames2 clip(simd::Frames2 v) noexcept {
+        const simd::Frames2 third = simd::splat(1.0f / 3.0f);
+        const simd::Frames2 v2 = simd::min(simd::max(v * third, simd::splat(-1.0f)), simd::splat(1.0f));
+        return simd::splat(3.0f) * (v2 - third * v2 * v2 * v2);
+    }
+
+    static inline void derivatives(simd::Frames2 input, simd::Frames2 c, simd::Frames2 res,
+                                   const simd::Frames2* s, simd::Frames2* d) noexcept {
+        const simd::Frames2 sat0 = clip(s[0]);
+        const simd::Frames2 sat1 = clip(s[1]);
+        const simd::Frames2 sat2 = clip(s[2]);
+        d[0] = c * (clip(input - res * s[3]) - sat0);
+        d[1] = c * (sat0 - sat1);
+        d[2] = c * (sat1 - sat2);
+        d[3] = c * (sat2 - clip(s[3]));
+    }
+};
+
+} // namespace ugens
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_UGENS_LADDERBANK_H
@@ -119,6 +119,9 @@ struct MicrotrackerMoogLadder {
     }
 
 private:
+    // LadderBank lanes copy their coefficients from a configured instance
+    template<typename, size_t> friend struct LadderLanes;
+
     double p0;
     double p1;
     double p2;
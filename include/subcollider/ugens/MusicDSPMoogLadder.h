@@ -135,6 +135,9 @@ struct MusicDSPMoogLadder {
     }
 
 private:
+    // LadderBank lanes copy their coefficients from a configured instance
+    template<typename, size_t> friend struct LadderLanes;
+
     double stage[4];
     double delay[4];
 
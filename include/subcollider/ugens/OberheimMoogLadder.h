@@ -22,6 +22,9 @@ namespace ugens {
  * Based on Will Pirkle's virtual analog model using four cascaded
  * one-pole filters with feedback.
  *
+ * @tparam T Internal precision. OberheimMoogLadder runs in double with
+ *           std::tanh; OberheimMoogLadderF runs in float with tanhApprox.
+ *
  * Usage:
  * @code
  * OberheimMoogLadder filter;
@@ -36,7 +39,8 @@ namespace ugens {
  * filter.process(buffer, 64);
  * @endcode
  */
-struct OberheimMoogLadder {
+template<typename T>
+struct OberheimMoogLadderT {
     /// Sample rate in Hz
     Sample sampleRate;
 
@@ -55,25 +59,25 @@ struct OberheimMoogLadder {
 
         // Initialize one-pole filters
         for (int i = 0; i < 4; i++) {
-            lpf[i].alpha = 1.0;
-            lpf[i].beta = 0.0;
-            lpf[i].gamma = 1.0;
-            lpf[i].delta = 0.0;
-            lpf[i].epsilon = 0.0;
-            lpf[i].a0 = 1.0;
-            lpf[i].feedback = 0.0;
-            lpf[i].z1 = 0.0;
+            lpf[i].alpha = T(1);
+            lpf[i].beta = T(0);
+            lpf[i].gamma = T(1);
+            lpf[i].delta = T(0);
+            lpf[i].epsilon = T(0);
+            lpf[i].a0 = T(1);
+            lpf[i].feedback = T(0);
+            lpf[i].z1 = T(0);
         }
 
-        saturation = 1.0;
-        K = 0.0;
-        gamma = 0.0;
-        alpha0 = 1.0;
+        saturation = T(1);
+        K = T(0);
+        gamma = T(0);
+        alpha0 = T(1);
 
         for (int i = 0; i < 5; i++) {
-            oberheimCoefs[i] = 0.0;
+            oberheimCoefs[i] = T(0);
         }
-        oberheimCoefs[4] = 1.0;
+        oberheimCoefs[4] = T(1);
 
         setCutoff(1000.0f);
         setResonance(0.1f);
@@ -88,31 +92,31 @@ struct OberheimMoogLadder {
 
         // prewarp for BZT
         double wd = 2.0 * PI * cutoff;
-        double T = 1.0 / sampleRate;
-        double wa = (2.0 / T) * std::tan(wd * T / 2.0);
-        double g = wa * T / 2.0;
+        double period = 1.0 / sampleRate;
+        double wa = (2.0 / period) * std::tan(wd * period / 2.0);
+        double g = wa * period / 2.0;
 
         // Feedforward coeff
         double G = g / (1.0 + g);
 
         for (int i = 0; i < 4; i++) {
-            lpf[i].alpha = G;
+            lpf[i].alpha = static_cast<T>(G);
         }
 
-        lpf[0].beta = G * G * G / (1.0 + g);
-        lpf[1].beta = G * G / (1.0 + g);
-        lpf[2].beta = G / (1.0 + g);
-        lpf[3].beta = 1.0 / (1.0 + g);
+        lpf[0].beta = static_cast<T>(G * G * G / (1.0 + g));
+        lpf[1].beta = static_cast<T>(G * G / (1.0 + g));
+        lpf[2].beta = static_cast<T>(G / (1.0 + g));
+        lpf[3].beta = static_cast<T>(1.0 / (1.0 + g));
 
-        gamma = G * G * G * G;
-        alpha0 = 1.0 / (1.0 + K * gamma);
+        gamma = static_cast<T>(G * G * G * G);
+        alpha0 = static_cast<T>(1.0 / (1.0 + K * static_cast<double>(gamma)));
 
         // Oberheim variations / LPF4
-        oberheimCoefs[0] = 0.0;
-        oberheimCoefs[1] = 0.0;
-        oberheimCoefs[2] = 0.0;
-        oberheimCoefs[3] = 0.0;
-        oberheimCoefs[4] = 1.0;
+        oberheimCoefs[0] = T(0);
+        oberheimCoefs[1] = T(0);
+        oberheimCoefs[2] = T(0);
+        oberheimCoefs[3] = T(0);
+        oberheimCoefs[4] = T(1);
     }
 
     /**
@@ -122,8 +126,8 @@ struct OberheimMoogLadder {
     void setResonance(Sample r) noexcept {
         resonance = r < 0.0f ? 0.0f : (r > 1.0f ? 1.0f : r);
         // this maps resonance = 0->1 to K = 0 -> 4
-        K = 4.0 * resonance;
-        alpha0 = 1.0 / (1.0 + K * gamma);
+        K = static_cast<T>(4.0 * resonance);
+        alpha0 = static_cast<T>(1.0 / (1.0 + K * static_cast<double>(gamma)));
     }
 
     /**
@@ -132,26 +136,26 @@ struct OberheimMoogLadder {
      * @return Filtered sample
      */
     inline Sample tick(Sample input) noexcept {
-        double sigma =
+        T sigma =
             getFeedbackOutput(0) +
             getFeedbackOutput(1) +
             getFeedbackOutput(2) +
             getFeedbackOutput(3);
 
-        double in = input * (1.0 + K);
+        T in = static_cast<T>(input) * (T(1) + K);
 
         // calculate input to first filter
-        double u = (in - K * sigma) * alpha0;
+        T u = (in - K * sigma) * alpha0;
 
-        u = std::tanh(saturation * u);
+        u = precisionTanh(saturation * u);
 
-        double stage1 = tickOnePole(0, u);
-        double stage2 = tickOnePole(1, stage1);
-        double stage3 = tickOnePole(2, stage2);
-        double stage4 = tickOnePole(3, stage3);
+        T stage1 = tickOnePole(0, u);
+        T stage2 = tickOnePole(1, stage1);
+        T stage3 = tickOnePole(2, stage2);
+        T stage4 = tickOnePole(3, stage3);
 
         // Oberheim variations
-        double out =
+        T out =
             oberheimCoefs[0] * u +
             oberheimCoefs[1] * stage1 +
             oberheimCoefs[2] * stage2 +
@@ -177,44 +181,53 @@ struct OberheimMoogLadder {
      */
     void reset() noexcept {
         for (int i = 0; i < 4; i++) {
-            lpf[i].z1 = 0.0;
-            lpf[i].feedback = 0.0;
+            lpf[i].z1 = T(0);
+            lpf[i].feedback = T(0);
         }
     }
 
 private:
+    // LadderBank lanes copy their coefficients from a configured instance
+    template<typename, size_t> friend struct LadderLanes;
+
     struct OnePole {
-        double alpha;
-        double beta;
-        double gamma;
-        double delta;
-        double epsilon;
-        double a0;
-        double feedback;
-        double z1;
+        T alpha;
+        T beta;
+        T gamma;
+        T delta;
+        T epsilon;
+        T a0;
+        T feedback;
+        T z1;
     };
 
     OnePole lpf[4];
 
-    double K;
-    double gamma;
-    double alpha0;
-    double saturation;
-    double oberheimCoefs[5];
+    T K;
+    T gamma;
+    T alpha0;
+    T saturation;
+    T oberheimCoefs[5];
 
-    inline double getFeedbackOutput(int index) noexcept {
+    inline T getFeedbackOutput(int index) noexcept {
         return lpf[index].beta * (lpf[index].z1 + lpf[index].feedback * lpf[index].delta);
     }
 
-    inline double tickOnePole(int index, double s) noexcept {
+    inline T tickOnePole(int index, T s) noexcept {
         s = s * lpf[index].gamma + lpf[index].feedback + lpf[index].epsilon * getFeedbackOutput(index);
-        double vn = (lpf[index].a0 * s - lpf[index].z1) * lpf[index].alpha;
-        double out = vn + lpf[index].z1;
+        T vn = (lpf[index].a0 * s - lpf[index].z1) * lpf[index].alpha;
+        T out = vn + lpf[index].z1;
         lpf[index].z1 = vn + out;
         return out;
     }
 };
 
+/// Double-precision Oberheim ladder (reference)
+using OberheimMoogLadder = OberheimMoogLadderT<double>;
+
+/// Single-precision Oberheim ladder (fast path)
+using OberheimMoogLadderF = OberheimMoogLadderT<float>;
+
 } // namespace ugens
 } // namespace subcollider
 
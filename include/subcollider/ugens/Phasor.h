@@ -14,6 +14,7 @@
 #define SUBCOLLIDER_UGENS_PHASOR_H
 
 #include "../types.h"
+#include "../Playhead.h"
 #include <cmath>
 
 namespace subcollider {
@@ -32,6 +33,11 @@ namespace ugens {
  *
  * Common use: index control with BufRd and BufWr.
  *
+ * The value type T is Sample for the usual float ramp. PlayheadPhasor
+ * (T = Playhead) runs the same ramp in 32.32 fixed point for playing
+ * buffers longer than 2^24 frames: increments and wraps are exact, and
+ * its output feeds BufRd::tick(Playhead) directly.
+ *
  * To output a signal with frequency freq oscillating between start and end:
  * rate = (end - start) * freq / sampleRate
  *
@@ -53,21 +59,22 @@ namespace ugens {
  * phasor.process(buffer, 64);
  * @endcode
  */
-struct Phasor {
+template<typename T>
+struct PhasorT {
     /// Current output value
-    Sample value;
+    T value;
 
     /// Rate of change per sample
-    Sample rate;
+    T rate;
 
     /// Start value (ramp beginning)
-    Sample start;
+    T start;
 
     /// End value (wrap point, never actually output)
-    Sample end;
+    T end;
 
     /// Reset position (value to jump to on trigger)
-    Sample resetPos;
+    T resetPos;
 
     /// Previous trigger value (for edge detection)
     Sample prevTrig;
@@ -81,10 +88,10 @@ struct Phasor {
      */
     void init(Sample sr = DEFAULT_SAMPLE_RATE) noexcept {
         sampleRate = sr;
-        rate = 1.0f;
-        start = 0.0f;
-        end = 1.0f;
-        resetPos = 0.0f;
+        rate = T(1.0f);
+        start = T();
+        end = T(1.0f);
+        resetPos = T();
         value = start;
         prevTrig = 0.0f;
     }
@@ -96,8 +103,8 @@ struct Phasor {
      * @param endVal End value / wrap point (default: 1.0)
      * @param resetPosVal Reset position on trigger (default: 0.0)
      */
-    void set(Sample rateVal, Sample startVal = 0.0f,
-             Sample endVal = 1.0f, Sample resetPosVal = 0.0f) noexcept {
+    void set(T rateVal, T startVal = T(),
+             T endVal = T(1.0f), T resetPosVal = T()) noexcept {
         rate = rateVal;
         start = startVal;
         end = endVal;
@@ -121,7 +128,7 @@ struct Phasor {
      * @brief Set rate directly.
      * @param rateVal Rate of change per sample
      */
-    void setRate(Sample rateVal) noexcept {
+    void setRate(T rateVal) noexcept {
         rate = rateVal;
     }
 
@@ -129,7 +136,7 @@ struct Phasor {
      * @brief Set start value.
      * @param startVal Start value
      */
-    void setStart(Sample startVal) noexcept {
+    void setStart(T startVal) noexcept {
         start = startVal;
     }
 
@@ -137,7 +144,7 @@ struct Phasor {
      * @brief Set end value (wrap point).
      * @param endVal End value
      */
-    void setEnd(Sample endVal) noexcept {
+    void setEnd(T endVal) noexcept {
         end = endVal;
     }
 
@@ -145,7 +152,7 @@ struct Phasor {
      * @brief Set reset position.
      * @param resetPosVal Reset position
      */
-    void setResetPos(Sample resetPosVal) noexcept {
+    void setResetPos(T resetPosVal) noexcept {
         resetPos = resetPosVal;
     }
 
@@ -153,26 +160,28 @@ struct Phasor {
      * @brief Generate single sample without trigger (inline per-sample processing).
      * @return Current value before advancing
      */
-    inline Sample tick() noexcept {
+    inline T tick() noexcept {
+        using std::fmod;  // Playhead's fmod is found by argument lookup
+
         // Handle wrap-around BEFORE returning value (end value should never be output)
-        Sample range = end - start;
-        if (range > 0.0f) {
+        T range = end - start;
+        if (range > T()) {
             // Forward ramp (end > start): value goes from start up to end
             if (value >= end || value < start) {
-                value = std::fmod(value - start, range);
-                if (value < 0.0f) {
+                value = fmod(value - start, range);
+                if (value < T()) {
                     value += range;
                 }
                 value += start;
             }
-        } else if (range < 0.0f) {
+        } else if (range < T()) {
             // Backward ramp (start > end): value goes from start down to end
-            Sample absRange = -range;
+            T absRange = -range;
             if (value <= end || value > start) {
                 // When at or past end, wrap back toward start
-                Sample offset = value - end;
-                offset = std::fmod(offset, absRange);
-                if (offset <= 0.0f) {
+                T offset = value - end;
+                offset = fmod(offset, absRange);
+                if (offset <= T()) {
                     offset += absRange;
                 }
                 value = end + offset;
@@ -180,7 +189,7 @@ struct Phasor {
         }
         // If end == start, value stays constant (range == 0)
 
-        Sample out = value;
+        T out = value;
 
         // Advance value by rate for next tick
         value += rate;
@@ -196,7 +205,7 @@ struct Phasor {
      * @param trig Trigger input signal
      * @return Current value before advancing
      */
-    inline Sample tick(Sample trig) noexcept {
+    inline T tick(Sample trig) noexcept {
         // Detect positive edge: previous <= 0 and current > 0
         if (prevTrig <= 0.0f && trig > 0.0f) {
             value = resetPos;
@@ -211,7 +220,7 @@ struct Phasor {
      * @param output Output buffer
      * @param numSamples Number of samples to generate
      */
-    void process(Sample* output, size_t numSamples) noexcept {
+    void process(T* output, size_t numSamples) noexcept {
         for (size_t i = 0; i < numSamples; ++i) {
             output[i] = tick();
         }
@@ -223,7 +232,7 @@ struct Phasor {
      * @param trig Trigger input buffer
      * @param numSamples Number of samples to generate
      */
-    void process(Sample* output, const Sample* trig, size_t numSamples) noexcept {
+    void process(T* output, const Sample* trig, size_t numSamples) noexcept {
         for (size_t i = 0; i < numSamples; ++i) {
             output[i] = tick(trig[i]);
         }
@@ -234,7 +243,7 @@ struct Phasor {
      * @param output Output buffer to add to
      * @param numSamples Number of samples to generate
      */
-    void processAdd(Sample* output, size_t numSamples) noexcept {
+    void processAdd(T* output, size_t numSamples) noexcept {
         for (size_t i = 0; i < numSamples; ++i) {
             output[i] += tick();
         }
@@ -252,12 +261,18 @@ struct Phasor {
      * @brief Reset Phasor to a specific position.
      * @param pos Position to reset to
      */
-    void reset(Sample pos) noexcept {
+    void reset(T pos) noexcept {
         value = pos;
         prevTrig = 0.0f;
     }
 };
 
+/// Float ramp (the common case)
+using Phasor = PhasorT<Sample>;
+
+/// 32.32 fixed-point ramp for long buffers
+using PlayheadPhasor = PhasorT<Playhead>;
+
 } // namespace ugens
 } // namespace subcollider
 
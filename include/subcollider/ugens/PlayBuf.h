@@ -0,0 +1,376 @@
+/**
+ * @file PlayBuf.h
+ * @brief Buffer player UGen: a Phasor and a BufRd fused into one block loop.
+ *
+ * PlayBuf advances its own read position through a buffer at a given
+ * rate, wrapping between loop points and jumping to a reset position on
+ * trigger. It produces exactly what a Phasor feeding a BufRd produces,
+ * but in blocks: the position is wrapped once (by the ramp, and only when
+ * it crosses a loop point) and the reads go through BufRd's block path,
+ * so the per-sample fmod in BufRd is gone.
+ * Designed for embedded use with no heap allocation and no virtual calls.
+ */
+
+#ifndef SUBCOLLIDER_UGENS_PLAYBUF_H
+#define SUBCOLLIDER_UGENS_PLAYBUF_H
+
+#include "../types.h"
+#include "../Buffer.h"
+#include "../BufferHandle.h"
+#include "BufRd.h"
+#include "Phasor.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace subcollider {
+namespace ugens {
+
+/**
+ * @brief Looping or one-shot buffer player with trigger reset.
+ *
+ * Parameters:
+ * - rate: frames advanced per output sample (negative plays backwards);
+ *   setPlaybackRate() applies the buffer/output sample rate ratio
+ * - start/end: loop points in frames (end is the wrap point, never read)
+ * - resetPos: frame jumped to when the trigger crosses from <= 0 to > 0
+ * - loop: wrap at the loop points, or stop (silence, isDone()) where the
+ *   looping player would have wrapped
+ * - interpolation: 1 = none, 2 = linear, 4 = cubic, 8/16/32 = windowed
+ *   sinc, as in BufRd
+ *
+ * With loop enabled the output is sample-for-sample identical to
+ * reader.tick(phasor.tick()) on a Phasor set to (rate, start, end,
+ * resetPos) and a BufRd with the same buffer and interpolation.
+ *
+ * Usage:
+ * @code
+ * PlayBuf player;
+ * player.init(48000.0f);
+ * player.setBuffer(&buf);           // loop points: whole buffer
+ * player.setPlaybackRate(1.0f);     // original pitch
+ * player.setInterpolation(4);
+ *
+ * // Block processing
+ * player.processStereo(left, right, 64);
+ * @endcode
+ */
+struct PlayBuf {
+    /// Phase accumulator (rate, loop points, reset position, trigger state)
+    Phasor phasor;
+
+    /// Buffer reader (buffer, interpolation)
+    BufRd reader;
+
+    /// Output sample rate in Hz
+    Sample sampleRate;
+
+    /// Loop mode: true wraps at the loop points, false plays once
+    bool loop;
+
+    /// One-shot playback has reached a loop point
+    bool done;
+
+    /**
+     * @brief Initialize PlayBuf.
+     * @param sr Output sample rate in Hz
+     * @param buf Buffer to play (loop points are set to the whole buffer)
+     */
+    void init(Sample sr = DEFAULT_SAMPLE_RATE, const Buffer* buf = nullptr) noexcept {
+        sampleRate = sr;
+        loop = true;
+        done = false;
+        phasor.init(sr);
+        reader.init();
+        setBuffer(buf);
+    }
+
+    /**
+     * @brief Set the buffer to play and loop over all of it.
+     * @param buf Pointer to the buffer
+     */
+    void setBuffer(const Buffer* buf) noexcept {
+        reader.setBuffer(buf);
+        resetLoopPoints();
+    }
+
+    /**
+     * @brief Play a relocatable buffer and loop over all of it.
+     * @param ref Handle reference from RelocatableBufferAllocator::ref()
+     */
+    void setBuffer(const BufferRef& ref) noexcept {
+        reader.setBuffer(ref);
+        resetLoopPoints();
+    }
+
+    /**
+     * @brief Set the phase increment directly.
+     * @param framesPerSample Buffer frames advanced per output sample
+     *
+     * Also picks the mip level read from buffers with a mip pyramid
+     * (BufRd::setMipRate()).
+     */
+    void setRate(Sample framesPerSample) noexcept {
+        phasor.setRate(framesPerSample);
+        reader.setMipRate(framesPerSample);
+    }
+
+    /**
+     * @brief Set the playback speed relative to the buffer's own rate.
+     * @param speed 1 = original pitch, 2 = octave up, -1 = reverse
+     *
+     * Scales by buffer sample rate / output sample rate, so call again
+     * after changing the buffer.
+     */
+    void setPlaybackRate(Sample speed) noexcept {
+        const Buffer* buf = reader.source();
+        const Sample scale = buf != nullptr && buf->sampleRate > 0.0f && sampleRate > 0.0f
+                                 ? buf->sampleRate / sampleRate
+                                 : 1.0f;
+        setRate(speed * scale);
+    }
+
+    /**
+     * @brief Set the loop points and restart at start.
+     * @param startFrame First frame of the loop
+     * @param endFrame Wrap point (start > end plays the segment backwards)
+     */
+    void setLoopPoints(Sample startFrame, Sample endFrame) noexcept {
+        phasor.set(phasor.rate, startFrame, endFrame, phasor.resetPos);
+        done = false;
+    }
+
+    /**
+     * @brief Set the position jumped to on trigger.
+     * @param frame Reset position in frames
+     */
+    void setResetPos(Sample frame) noexcept {
+        phasor.setResetPos(frame);
+    }
+
+    /**
+     * @brief Set loop mode.
+     * @param loopEnabled true to wrap at the loop points, false to play once
+     */
+    void setLoop(bool loopEnabled) noexcept {
+        loop = loopEnabled;
+    }
+
+    /**
+     * @brief Set interpolation mode.
+     * @param mode 1=none, 2=linear, 4=cubic, 8/16/32=windowed sinc
+     *             (others default to none)
+     */
+    void setInterpolation(uint8_t mode) noexcept {
+        reader.setInterpolation(mode);
+    }
+
+    /**
+     * @brief Check whether one-shot playback has finished.
+     * @return true once a non-looping player has reached a loop point
+     */
+    bool isDone() const noexcept {
+        return done;
+    }
+
+    /**
+     * @brief Restart at the loop start.
+     */
+    void reset() noexcept {
+        phasor.reset();
+        done = false;
+    }
+
+    /**
+     * @brief Restart at a given frame.
+     * @param frame Position in frames
+     */
+    void reset(Sample frame) noexcept {
+        phasor.reset(frame);
+        done = false;
+    }
+
+    /**
+     * @brief Generate one mono sample (left channel of stereo buffers).
+     * @return Sample at the current position, then advance
+     */
+    inline Sample tick() noexcept {
+        Sample phase = 0.0f;
+        return nextPhase(phase) ? reader.tick(phase) : 0.0f;
+    }
+
+    /**
+     * @brief Generate one mono sample with trigger input.
+     * @param trig Trigger; a rise from <= 0 to > 0 jumps to resetPos
+     * @return Sample at the current position, then advance
+     */
+    inline Sample tick(Sample trig) noexcept {
+        trigger(trig);
+        return tick();
+    }
+
+    /**
+     * @brief Generate one stereo sample (mono buffers duplicated).
+     * @return Stereo sample at the current position, then advance
+     */
+    inline Stereo tickStereo() noexcept {
+        Sample phase = 0.0f;
+        return nextPhase(phase) ? reader.tickStereo(phase) : Stereo();
+    }
+
+    /**
+     * @brief Generate one stereo sample with trigger input.
+     * @param trig Trigger; a rise from <= 0 to > 0 jumps to resetPos
+     * @return Stereo sample at the current position, then advance
+     */
+    inline Stereo tickStereo(Sample trig) noexcept {
+        trigger(trig);
+        return tickStereo();
+    }
+
+    /**
+     * @brief Process a block of mono samples.
+     * @param output Output buffer
+     * @param numSamples Number of samples to process
+     */
+    void process(Sample* output, size_t numSamples) noexcept {
+        dispatch<false>(output, nullptr, nullptr, numSamples);
+    }
+
+    /**
+     * @brief Process a block of mono samples with trigger input.
+     * @param output Output buffer
+     * @param trig Trigger input buffer
+     * @param numSamples Number of samples to process
+     */
+    void process(Sample* output, const Sample* trig, size_t numSamples) noexcept {
+        dispatch<false>(output, nullptr, trig, numSamples);
+    }
+
+    /**
+     * @brief Process a block of stereo samples.
+     * @param left Output buffer for left channel
+     * @param right Output buffer for right channel
+     * @param numSamples Number of samples to process
+     */
+    void processStereo(Sample* left, Sample* right, size_t numSamples) noexcept {
+        dispatch<true>(left, right, nullptr, numSamples);
+    }
+
+    /**
+     * @brief Process a block of stereo samples with trigger input.
+     * @param left Output buffer for left channel
+     * @param right Output buffer for right channel
+     * @param trig Trigger input buffer
+     * @param numSamples Number of samples to process
+     */
+    void processStereo(Sample* left, Sample* right, const Sample* trig,
+                       size_t numSamples) noexcept {
+        dispatch<true>(left, right, trig, numSamples);
+    }
+
+private:
+    /// Positions generated ahead of each BufRd block read
+    static constexpr size_t CHUNK = 64;
+
+    void resetLoopPoints() noexcept {
+        const Buffer* buf = reader.source();
+        const Sample frames = buf != nullptr && buf->isValid()
+                                  ? static_cast<Sample>(buf->numSamples)
+                                  : 0.0f;
+        setLoopPoints(0.0f, frames);
+    }
+
+    /// Jump to resetPos on a rising trigger (as Phasor::tick(trig))
+    inline void trigger(Sample trig) noexcept {
+        if (phasor.prevTrig <= 0.0f && trig > 0.0f) {
+            phasor.value = phasor.resetPos;
+            done = false;
+        }
+        phasor.prevTrig = trig;
+    }
+
+    /**
+     * @brief Produce the next read position.
+     * @param phase Receives the position
+     * @return false if one-shot playback is done (position not advanced)
+     *
+     * A one-shot player stops exactly where Phasor would wrap.
+     */
+    inline bool nextPhase(Sample& phase) noexcept {
+        if (!loop && !done) {
+            const Sample value = phasor.value;
+            if (phasor.end > phasor.start) {
+                done = value >= phasor.end || value < phasor.start;
+            } else if (phasor.end < phasor.start) {
+                done = value <= phasor.end || value > phasor.start;
+            }
+        }
+        if (done) {
+            return false;
+        }
+        phase = phasor.tick();
+        return true;
+    }
+
+    template<bool IsStereo>
+    void dispatch(Sample* a, Sample* b, const Sample* trig, size_t numSamples) noexcept {
+        switch (reader.interpolation) {
+            case 2: render<Interp::Linear, IsStereo>(a, b, trig, numSamples); break;
+            case 4: render<Interp::Cubic, IsStereo>(a, b, trig, numSamples); break;
+            case 8: render<Interp::Sinc8, IsStereo>(a, b, trig, numSamples); break;
+            case 16: render<Interp::Sinc16, IsStereo>(a, b, trig, numSamples); break;
+            case 32: render<Interp::Sinc32, IsStereo>(a, b, trig, numSamples); break;
+            default: render<Interp::Hold, IsStereo>(a, b, trig, numSamples); break;
+        }
+    }
+
+    /**
+     * @brief Generate positions a chunk at a time and read them as a block.
+     *
+     * Positions only need a branch per sample (the ramp wraps with fmod
+     * only when it crosses a loop point); BufRd reads each chunk with its
+     * unchecked fast path when the chunk stays clear of the buffer edges.
+     */
+    template<Interp Mode, bool IsStereo>
+    void render(Sample* a, Sample* b, const Sample* trig, size_t numSamples) noexcept {
+        Sample phases[CHUNK];
+        size_t i = 0;
+        while (i < numSamples) {
+            const size_t chunk = numSamples - i < CHUNK ? numSamples - i : CHUNK;
+            size_t count = 0;
+            bool silent = false;
+            for (; count < chunk; ++count) {
+                if (trig != nullptr) {
+                    trigger(trig[i + count]);
+                }
+                if (!nextPhase(phases[count])) {
+                    silent = true;
+                    break;
+                }
+            }
+            if (count > 0) {
+                if (IsStereo) {
+                    reader.processStereo<Mode>(a + i, b + i, phases, count);
+                } else {
+                    reader.process<Mode>(a + i, phases, count);
+                }
+                i += count;
+            }
+            if (silent) {
+                // One-shot finished: silent until a trigger restarts it
+                const size_t stop = trig != nullptr ? i + 1 : numSamples;
+                for (; i < stop; ++i) {
+                    a[i] = 0.0f;
+                    if (IsStereo) {
+                        b[i] = 0.0f;
+                    }
+                }
+            }
+        }
+    }
+};
+
+} // namespace ugens
+} // namespace subcollider
+
+#endif // SUBCOLLIDER_UGENS_PLAYBUF_H
@@ -51,6 +51,10 @@ namespace ugens {
  * where k controls the cutoff frequency, r is feedback (<= 4 for stability), 
  * and S(x) is a saturation function.
  *
+ * @tparam T Internal precision. RKSimulationMoogLadder runs the solver in
+ *           double; RKSimulationMoogLadderF runs it in float, which halves
+ *           the cost on float-only FPUs and stays stable at full resonance.
+ *
  * Usage:
  * @code
  * RKSimulationMoogLadder filter;
@@ -65,7 +69,8 @@ namespace ugens {
  * filter.process(buffer, 64);
  * @endcode
  */
-struct RKSimulationMoogLadder {
+template<typename T>
+struct RKSimulationMoogLadderT {
     /// Sample rate in Hz
     Sample sampleRate;
 
@@ -76,10 +81,10 @@ struct RKSimulationMoogLadder {
     Sample resonance;
 
     /// Input drive multiplier
-    double drive;
+    T drive;
 
     /// Makeup gain to compensate level loss at low cutoff
-    double makeupGain;
+    T makeupGain;
 
     /**
      * @brief Initialize the filter.
@@ -89,14 +94,14 @@ struct RKSimulationMoogLadder {
         sampleRate = sr;
         std::memset(state, 0, sizeof(state));
 
-        saturation = 3.0;
-        saturationInv = 1.0 / saturation;
-        cutoffCoeff = 0.0;
-        drive = 1.0;
-        makeupGain = 1.0;
+        saturation = T(3);
+        saturationInv = T(1) / saturation;
+        cutoffCoeff = T(0);
+        drive = T(1);
+        makeupGain = T(1);
 
         oversampleFactor = 1;
-        stepSize = 1.0 / (oversampleFactor * sampleRate);
+        stepSize = static_cast<T>(1.0 / (oversampleFactor * sampleRate));
 
         setCutoff(1000.0f);
         setResonance(0.1f);
@@ -108,14 +113,14 @@ struct RKSimulationMoogLadder {
      */
     void setCutoff(Sample c) noexcept {
         cutoff = c;
-        cutoffCoeff = 2.0 * PI * cutoff;
+        cutoffCoeff = static_cast<T>(2.0 * PI * cutoff);
 
         // Simple compensation to keep output level more consistent at low cutoff
         double nyquist = sampleRate * 0.5;
         double norm = nyquist > 0.0 ? static_cast<double>(cutoff) / nyquist : 0.0;
         norm = norm < 0.0 ? 0.0 : (norm > 1.0 ? 1.0 : norm);
-        makeupGain = 1.0 / (0.2 + norm);
-        if (makeupGain > 8.0) makeupGain = 8.0;
+        makeupGain = static_cast<T>(1.0 / (0.2 + norm));
+        if (makeupGain > T(8)) makeupGain = T(8);
     }
 
     /**
@@ -131,7 +136,7 @@ struct RKSimulationMoogLadder {
      * @param d Drive multiplier (1.0 = unity)
      */
     void setDrive(Sample d) noexcept {
-        drive = d < 0.0f ? 0.0f : static_cast<double>(d);
+        drive = d < 0.0f ? T(0) : static_cast<T>(d);
     }
 
     /**
@@ -140,7 +145,7 @@ struct RKSimulationMoogLadder {
      */
     void setOversampleFactor(int factor) noexcept {
         oversampleFactor = factor < 1 ? 1 : factor;
-        stepSize = 1.0 / (oversampleFactor * sampleRate);
+        stepSize = static_cast<T>(1.0 / (oversampleFactor * sampleRate));
     }
 
     /**
@@ -150,7 +155,7 @@ struct RKSimulationMoogLadder {
      */
     inline Sample tick(Sample input) noexcept {
         for (int j = 0; j < oversampleFactor; j++) {
-            rungekutteSolver(input);
+            rungekutteSolver(static_cast<T>(input));
         }
 
         return static_cast<Sample>(state[3] * makeupGain);
@@ -175,26 +180,29 @@ struct RKSimulationMoogLadder {
     }
 
 private:
-    double state[4];
-    double saturation;
-    double saturationInv;
-    double cutoffCoeff;
+    // LadderBank lanes copy their coefficients from a configured instance
+    template<typename, size_t> friend struct LadderLanes;
+
+    T state[4];
+    T saturation;
+    T saturationInv;
+    T cutoffCoeff;
     int oversampleFactor;
-    double stepSize;
+    T stepSize;
 
-    inline double clip(double value) noexcept {
-        double v2 = (value * saturationInv > 1.0 ? 1.0 :
-                    (value * saturationInv < -1.0 ? -1.0 :
-                     value * saturationInv));
-        return saturation * (v2 - (1.0 / 3.0) * v2 * v2 * v2);
+    inline T clip(T value) noexcept {
+        T v2 = (value * saturationInv > T(1) ? T(1) :
+               (value * saturationInv < T(-1) ? T(-1) :
+                value * saturationInv));
+        return saturation * (v2 - T(1.0 / 3.0) * v2 * v2 * v2);
     }
 
-    void calculateDerivatives(double input, double* dstate, double* currentState) noexcept {
-        double res = resonance * 10.0; // Scale resonance to [0, 10]
+    void calculateDerivatives(T input, T* dstate, T* currentState) noexcept {
+        T res = static_cast<T>(resonance) * T(10); // Scale resonance to [0, 10]
 
-        double satstate0 = clip(currentState[0]);
-        double satstate1 = clip(currentState[1]);
-        double satstate2 = clip(currentState[2]);
+        T satstate0 = clip(currentState[0]);
+        T satstate1 = clip(currentState[1]);
+        T satstate2 = clip(currentState[2]);
 
         dstate[0] = cutoffCoeff * (clip(input * drive - res * currentState[3]) - satstate0);
         dstate[1] = cutoffCoeff * (satstate0 - satstate1);
@@ -202,18 +210,18 @@ private:
         dstate[3] = cutoffCoeff * (satstate2 - clip(currentState[3]));
     }
 
-    void rungekutteSolver(double input) noexcept {
-        double deriv1[4], deriv2[4], deriv3[4], deriv4[4], tempState[4];
+    void rungekutteSolver(T input) noexcept {
+        T deriv1[4], deriv2[4], deriv3[4], deriv4[4], tempState[4];
 
         calculateDerivatives(input, deriv1, state);
 
         for (int i = 0; i < 4; i++)
-            tempState[i] = state[i] + 0.5 * stepSize * deriv1[i];
+            tempState[i] = state[i] + T(0.5) * stepSize * deriv1[i];
 
         calculateDerivatives(input, deriv2, tempState);
 
         for (int i = 0; i < 4; i++)
-            tempState[i] = state[i] + 0.5 * stepSize * deriv2[i];
+            tempState[i] = state[i] + T(0.5) * stepSize * deriv2[i];
 
         calculateDerivatives(input, deriv3, tempState);
 
@@ -223,10 +231,16 @@ private:
         calculateDerivatives(input, deriv4, tempState);
 
         for (int i = 0; i < 4; i++)
-            state[i] += (1.0 / 6.0) * stepSize * (deriv1[i] + 2.0 * deriv2[i] + 2.0 * deriv3[i] + deriv4[i]);
+            state[i] += T(1.0 / 6.0) * stepSize * (deriv1[i] + T(2) * deriv2[i] + T(2) * deriv3[i] + deriv4[i]);
     }
 };
 
+/// Double-precision Runge-Kutta ladder (reference)
+using RKSimulationMoogLadder = RKSimulationMoogLadderT<double>;
+
+/// Single-precision Runge-Kutta ladder (fast path)
+using RKSimulationMoogLadderF = RKSimulationMoogLadderT<float>;
+
 } // namespace ugens
 } // namespace subcollider
 
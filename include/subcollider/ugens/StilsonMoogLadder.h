@@ -154,6 +154,9 @@ struct StilsonMoogLadder {
     }
 
 private:
+    // LadderBank lanes copy their coefficients from a configured instance
+    template<typename, size_t> friend struct LadderLanes;
+
     double p;
     double Q;
     double state[4];
@@ -3,7 +3,7 @@
  * @brief SuperSaw synthesizer UGen - unison saw oscillators with vibrato.
  *
  * SuperSaw is a composite UGen that combines multiple detuned saw oscillators
- * with vibrato, stereo spreading, drive, and an amplitude envelope for a rich,
+ * with vibrato, stereo spreading, and an amplitude envelope for a rich,
  * powerful sound reminiscent of classic supersaw patches.
  */
 
@@ -11,28 +11,41 @@
 #define SUBCOLLIDER_UGENS_SUPERSAW_H
 
 #include "../types.h"
-#include "SawDPW.h"
+#include "../simd.h"
 #include "LFTri.h"
-#include "Pan2.h"
 #include "EnvelopeADSR.h"
+#include <algorithm>
 #include <cmath>
-#include <random>
 
 namespace subcollider {
 namespace ugens {
 
 /**
- * @brief SuperSaw synthesizer with 7 unison voices.
+ * @brief SuperSaw synthesizer with N unison voices.
  *
  * The SuperSaw generates a rich, detuned sound using:
- * - 7 saw oscillators with individual detuning and vibrato
+ * - N DPW saw oscillators with individual detuning and vibrato
  * - Stereo spreading via panning
- * - Drive/saturation
  * - ADSR amplitude envelope
  *
+ * The saws are stored structure-of-arrays in LANES = N rounded up to a
+ * multiple of 4, so one sample of every voice is a handful of vector
+ * operations; padding lanes have zero increment and zero gain. Detune
+ * ratios and pan gains are cached when their parameters change. Vibrato
+ * runs at control rate: every CONTROL_PERIOD samples each voice's
+ * triangle LFO and pow() are evaluated once, and the phase increment and
+ * DPW scale ramp linearly to the new values over the period. Frequency,
+ * detune and vibrato changes therefore glide in over at most one period.
+ *
+ * Members are ordered hot to cold: the lane arrays and envelope read every
+ * sample come first, configuration last. The seeding PRNG is local to
+ * init(), so a voice carries no generator state.
+ *
+ * @tparam Voices Number of unison voices (at least 2)
+ *
  * Usage:
  * @code
- * SuperSaw supersaw;
+ * SuperSaw supersaw;             // SuperSawN<7>
  * supersaw.init(48000.0f);
  * supersaw.setFrequency(440.0f);
  * supersaw.setAttack(0.01f);
@@ -47,25 +60,43 @@ namespace ugens {
  * supersaw.gate(0.0f);  // Note off
  * @endcode
  */
-struct SuperSaw {
-    static constexpr int NUM_VOICES = 7;
-
-    // Voice components
-    struct Voice {
-        SawDPW saw;
-        LFTri vibrato;
-        Pan2 panner;
-        Sample detuneOffset;     // Detune offset for this voice
-        Sample vibratoPhase;     // Random vibrato phase
-        Sample sawPhase;         // Random saw phase
-    };
-
-    Voice voices[NUM_VOICES];
-
-    // Shared components
+template<size_t Voices>
+struct SuperSawN {
+    static_assert(Voices >= 2, "SuperSawN needs at least two voices");
+
+    static constexpr int NUM_VOICES = static_cast<int>(Voices);
+
+    /// Voices rounded up to whole 4-lane vectors
+    static constexpr size_t LANES = (Voices + 3) / 4 * 4;
+
+    /// Samples between vibrato evaluations
+    static constexpr size_t CONTROL_PERIOD = 16;
+
+    // Hot state, touched every sample. Per-lane saw state (lane i is voice i)
+    alignas(16) Sample phase[LANES];           ///< DPW phase [0, 1)
+    alignas(16) Sample phaseIncrement[LANES];  ///< Current increment
+    alignas(16) Sample incrementStep[LANES];   ///< Per-sample increment ramp
+    alignas(16) Sample prevParabolic[LANES];   ///< Previous parabolic sample
+    alignas(16) Sample scale[LANES];           ///< DPW scale, 0.5 / increment
+    alignas(16) Sample scaleStep[LANES];       ///< Per-sample scale ramp
+    alignas(16) Sample gainLeft[LANES];        ///< Pan gain times 1/sqrt(N)
+    alignas(16) Sample gainRight[LANES];       ///< Pan gain times 1/sqrt(N)
+
     EnvelopeADSR envelope;
 
-    // Parameters
+    /// Samples left before the next control update
+    size_t controlCount;
+
+    /// False until the first control update, which jumps instead of ramping
+    bool primed;
+
+    // Control-rate state, touched every CONTROL_PERIOD samples
+    alignas(16) Sample detuneRatio[LANES];     ///< 2^(offset / 12)
+
+    /// Vibrato LFOs, clocked at sampleRate / CONTROL_PERIOD
+    LFTri vibrato[Voices];
+
+    // Configuration, touched only by the setters and control updates
     Sample frequency;
     Sample vibrRate;
     Sample vibrDepth;
@@ -74,10 +105,6 @@ struct SuperSaw {
 
     Sample sampleRate;
 
-    // Random number generator for initialization
-    std::mt19937 rng;
-    std::uniform_real_distribution<Sample> dist;
-
     /**
      * @brief Initialize the SuperSaw.
      * @param sr Sample rate in Hz (default: 48000)
@@ -86,10 +113,6 @@ struct SuperSaw {
     void init(Sample sr = DEFAULT_SAMPLE_RATE, unsigned int seed = 42) noexcept {
         sampleRate = sr;
 
-        // Initialize random number generator
-        rng.seed(seed);
-        dist = std::uniform_real_distribution<Sample>(0.0f, 1.0f);
-
         // Default parameters
         frequency = 400.0f;
         vibrRate = 6.0f;
@@ -103,21 +126,30 @@ struct SuperSaw {
         envelope.setSustain(0.7f);
         envelope.setRelease(0.3f);
 
-        // Initialize voices
-        for (int i = 0; i < NUM_VOICES; ++i) {
-            // Random phases
-            voices[i].vibratoPhase = dist(rng);
-            voices[i].sawPhase = dist(rng);
-
-            // Calculate detune offset for this voice
-            // Spread voices from -detune/2 to +detune/2 in semitones
-            voices[i].detuneOffset = ((static_cast<Sample>(i) / (NUM_VOICES - 1)) - 0.5f) * detune;
+        for (size_t k = 0; k < LANES; ++k) {
+            phase[k] = 0.0f;
+            phaseIncrement[k] = 0.0f;
+            incrementStep[k] = 0.0f;
+            prevParabolic[k] = 0.0f;
+            scale[k] = 0.0f;
+            scaleStep[k] = 0.0f;
+            detuneRatio[k] = 0.0f;
+        }
 
-            // Initialize oscillators
-            voices[i].saw.init(sr, voices[i].sawPhase * 2.0f - 1.0f);
-            voices[i].vibrato.init(sr, voices[i].vibratoPhase * 4.0f);
-            voices[i].vibrato.setFrequency(vibrRate);
+        // Random saw and vibrato phases, from a generator that lives only here
+        Lcg rng(seed);
+        const Sample controlRate = sr / static_cast<Sample>(CONTROL_PERIOD);
+        for (size_t i = 0; i < Voices; ++i) {
+            const Sample vibratoPhase = rng.nextUnipolar();
+            phase[i] = rng.nextUnipolar();
+            vibrato[i].init(controlRate, vibratoPhase * 4.0f);
+            vibrato[i].setFrequency(vibrRate);
         }
+
+        updateDetune();
+        updateSpread();
+        controlCount = 0;
+        primed = false;
     }
 
     /**
@@ -134,8 +166,8 @@ struct SuperSaw {
      */
     void setVibratoRate(Sample rate) noexcept {
         vibrRate = rate;
-        for (int i = 0; i < NUM_VOICES; ++i) {
-            voices[i].vibrato.setFrequency(rate);
+        for (size_t i = 0; i < Voices; ++i) {
+            vibrato[i].setFrequency(rate);
         }
     }
 
@@ -153,10 +185,7 @@ struct SuperSaw {
      */
     void setDetune(Sample det) noexcept {
         detune = det;
-        // Recalculate detune offsets
-        for (int i = 0; i < NUM_VOICES; ++i) {
-            voices[i].detuneOffset = ((static_cast<Sample>(i) / (NUM_VOICES - 1)) - 0.5f) * detune;
-        }
+        updateDetune();
     }
 
     /**
@@ -165,6 +194,7 @@ struct SuperSaw {
      */
     void setSpread(Sample s) noexcept {
         spread = clamp(s, 0.0f, 1.0f);
+        updateSpread();
     }
 
     /**
@@ -215,51 +245,28 @@ struct SuperSaw {
         return envelope.isActive();
     }
 
+    /**
+     * @brief Get the current envelope level.
+     * @return Envelope value [0, 1]
+     */
+    Sample level() const noexcept {
+        return envelope.value;
+    }
+
     /**
      * @brief Generate single stereo sample.
      * @return Stereo output sample
      */
     inline Stereo tick() noexcept {
-        // Get envelope value
-        Sample env = envelope.tick();
-
-        // Mix all voices
-        Stereo mix(0.0f, 0.0f);
-
-        for (int i = 0; i < NUM_VOICES; ++i) {
-            // Calculate vibrato modulation
-            Sample vibratoValue = voices[i].vibrato.tick();
-            // Convert vibrato depth from semitones to frequency ratio
-            Sample vibratoMod = std::pow(2.0f, (vibratoValue * vibrDepth) / 12.0f);
-
-            // Calculate detuned frequency
-            Sample detuneMod = std::pow(2.0f, voices[i].detuneOffset / 12.0f);
-            Sample voiceFreq = frequency * vibratoMod * detuneMod;
-
-            voices[i].saw.setFrequency(voiceFreq);
-
-            // Generate saw wave
-            Sample sawSample = voices[i].saw.tick();
-
-            // Pan the voice (alternate left/right based on index)
-            Sample panPos = ((i % 2) * 2.0f - 1.0f) * spread;
-            Stereo panned = voices[i].panner.process(sawSample, panPos);
-
-            // Accumulate
-            mix.left += panned.left;
-            mix.right += panned.right;
+        if (controlCount == 0) {
+            updateControl();
+            controlCount = CONTROL_PERIOD;
         }
+        --controlCount;
 
-        // Normalize by sqrt(NUM_VOICES) for equal power
-        Sample norm = 1.0f / std::sqrt(static_cast<Sample>(NUM_VOICES));
-        mix.left *= norm;
-        mix.right *= norm;
-
-        // Apply envelope
-        mix.left *= env;
-        mix.right *= env;
-
-        return mix;
+        const Sample env = envelope.tick();
+        const Stereo mix = renderFrame();
+        return Stereo(mix.left * env, mix.right * env);
     }
 
     /**
@@ -267,12 +274,25 @@ struct SuperSaw {
      * @param outputL Left channel output buffer
      * @param outputR Right channel output buffer
      * @param numSamples Number of samples to generate
+     *
+     * Runs the same per-sample lane kernel as tick() between control
+     * updates, so the output matches tick() exactly.
      */
     void process(Sample* outputL, Sample* outputR, size_t numSamples) noexcept {
-        for (size_t i = 0; i < numSamples; ++i) {
-            Stereo sample = tick();
-            outputL[i] = sample.left;
-            outputR[i] = sample.right;
+        size_t i = 0;
+        while (i < numSamples) {
+            if (controlCount == 0) {
+                updateControl();
+                controlCount = CONTROL_PERIOD;
+            }
+            const size_t run = std::min(controlCount, numSamples - i);
+            for (size_t s = 0; s < run; ++s, ++i) {
+                const Sample env = envelope.tick();
+                const Stereo mix = renderFrame();
+                outputL[i] = mix.left * env;
+                outputR[i] = mix.right * env;
+            }
+            controlCount -= run;
         }
     }
 
@@ -281,12 +301,93 @@ struct SuperSaw {
      */
     void reset() noexcept {
         envelope.reset();
-        for (int i = 0; i < NUM_VOICES; ++i) {
-            voices[i].saw.reset();
+        for (size_t k = 0; k < LANES; ++k) {
+            phase[k] = 0.0f;
+            prevParabolic[k] = 0.0f;
+        }
+        controlCount = 0;
+        primed = false;
+    }
+
+private:
+    /// Cache 2^(offset / 12), offsets spread from -detune/2 to +detune/2
+    void updateDetune() noexcept {
+        for (size_t i = 0; i < Voices; ++i) {
+            const Sample offset = (static_cast<Sample>(i) / static_cast<Sample>(Voices - 1) - 0.5f) * detune;
+            detuneRatio[i] = std::pow(2.0f, offset / 12.0f);
+        }
+    }
+
+    /// Cache equal-power pan gains, alternating voices left and right
+    void updateSpread() noexcept {
+        const Sample norm = 1.0f / std::sqrt(static_cast<Sample>(Voices));
+        for (size_t k = 0; k < LANES; ++k) {
+            gainLeft[k] = 0.0f;
+            gainRight[k] = 0.0f;
+        }
+        for (size_t i = 0; i < Voices; ++i) {
+            const Sample pan = (static_cast<Sample>(i % 2) * 2.0f - 1.0f) * spread;
+            const Sample angle = (pan + 1.0f) * 0.78539816339f;  // PI/4
+            gainLeft[i] = std::cos(angle) * norm;
+            gainRight[i] = std::sin(angle) * norm;
+        }
+    }
+
+    /// Step the vibrato LFOs and set up ramps to the next increments
+    void updateControl() noexcept {
+        const Sample baseIncrement = frequency / sampleRate;
+        const Sample rampScale = 1.0f / static_cast<Sample>(CONTROL_PERIOD);
+        for (size_t i = 0; i < Voices; ++i) {
+            const Sample vibratoMod = std::pow(2.0f, (vibrato[i].tick() * vibrDepth) / 12.0f);
+            const Sample target = baseIncrement * vibratoMod * detuneRatio[i];
+            // Scale by (sample_rate / frequency) / 2 to normalize to about [-1, 1]
+            const Sample targetScale = target > 0.0f ? 0.5f / target : 0.0f;
+            if (primed) {
+                incrementStep[i] = (target - phaseIncrement[i]) * rampScale;
+                scaleStep[i] = (targetScale - scale[i]) * rampScale;
+            } else {
+                phaseIncrement[i] = target;
+                scale[i] = targetScale;
+            }
+        }
+        primed = true;
+    }
+
+    /// Advance every lane one sample and return the panned mix
+    inline Stereo renderFrame() noexcept {
+        alignas(16) Sample out[LANES];
+        for (size_t k = 0; k < LANES; ++k) {
+            const Sample saw = phase[k] * 2.0f - 1.0f;
+            const Sample parabolic = saw * saw;
+            out[k] = (parabolic - prevParabolic[k]) * scale[k];
+            prevParabolic[k] = parabolic;
+            phase[k] += phaseIncrement[k];
+            phase[k] -= phase[k] >= 1.0f ? 1.0f : 0.0f;
+            phaseIncrement[k] += incrementStep[k];
+            scale[k] += scaleStep[k];
+        }
+
+        simd::Frames2 left = simd::splat(0.0f);
+        simd::Frames2 right = simd::splat(0.0f);
+        for (size_t k = 0; k < LANES; k += 4) {
+            const simd::Frames2 x = simd::load(out + k, out + k + 2);
+            left = left + x * simd::load(gainLeft + k, gainLeft + k + 2);
+            right = right + x * simd::load(gainRight + k, gainRight + k + 2);
         }
+        Sample l[4];
+        Sample r[4];
+        simd::store(left, l, l + 2);
+        simd::store(right, r, r + 2);
+        return Stereo((l[0] + l[1]) + (l[2] + l[3]), (r[0] + r[1]) + (r[2] + r[3]));
     }
 };
 
+/// The classic seven-voice SuperSaw
+using SuperSaw = SuperSawN<7>;
+
+// Eight cache lines, so 64 voices fit a 32 KB L1
+static_assert(sizeof(SuperSaw) <= 512, "SuperSaw voice exceeds its 512-byte budget");
+
 } // namespace ugens
 } // namespace subcollider
 
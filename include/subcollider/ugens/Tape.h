@@ -7,6 +7,7 @@
 #define SUBCOLLIDER_UGENS_TAPE_H
 
 #include "../types.h"
+#include <algorithm>
 #include <cmath>
 
 namespace subcollider {
@@ -68,6 +69,8 @@ struct TapeDcBlocker {
 
 /// Tape saturation effect built from the legacy TapeFX implementation.
 struct Tape {
+    static constexpr size_t STEREO_CHUNK = 64;
+
     Sample sampleRate;
     Sample bias;
     Sample pregain;
@@ -132,11 +135,40 @@ struct Tape {
         }
     }
 
+    /// Process planar stereo in place; same result as tickStereo() per sample.
+    ///
+    /// Works in chunks, one stage at a time over both channels, so the
+    /// stateless stages run over contiguous spans the compiler can
+    /// vectorize and only the follower and DC blockers stay serial.
     void processStereo(Sample* samplesL, Sample* samplesR, size_t numSamples) noexcept {
-        for (size_t i = 0; i < numSamples; ++i) {
-            Stereo out = tickStereo(samplesL[i], samplesR[i]);
-            samplesL[i] = out.left;
-            samplesR[i] = out.right;
+        Sample biasOffset[STEREO_CHUNK];
+        for (size_t start = 0; start < numSamples; start += STEREO_CHUNK) {
+            const size_t n = std::min(STEREO_CHUNK, numSamples - start);
+            Sample* left = samplesL + start;
+            Sample* right = samplesR + start;
+
+            for (size_t i = 0; i < n; ++i) {
+                left[i] *= pregain;
+                right[i] *= pregain;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                followerValue = follower.process(left[i]);
+                biasOffset[i] = followerValue * bias;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                left[i] = std::tanh(left[i] + biasOffset[i]);
+                right[i] = std::tanh(right[i] + biasOffset[i]);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                left[i] = dcLeft.process(left[i]);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                right[i] = dcRight.process(right[i]);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                left[i] = std::tanh(left[i]);
+                right[i] = std::tanh(right[i]);
+            }
         }
     }
 
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 #include "../Buffer.h"
 #include "../types.h"
@@ -22,8 +23,8 @@
 #include "LFNoise2.h"
 #include "LagLinear.h"
 #include "LinLin.h"
-#include "Wrap.h"
 #include "XFade2.h"
+#include "../Playhead.h"
 
 namespace subcollider {
 namespace ugens {
@@ -41,10 +42,44 @@ namespace ugens {
  * The phasor traverses a 2x loop window; the second half crossfades to a
  * second read head offset by the loop size. Toggle detection is done with
  * simple comparisons (no Changed/Select). Linear lag replaces VarLag.
+ *
+ * A BufferRef from a RelocatableBufferAllocator may be played instead of
+ * a plain Buffer; process() re-resolves it once per block, so the buffer
+ * can be moved by the compactor while it plays.
+ *
+ * process() is the fast path: the play mode (process<PlayMode::Bounce>)
+ * and interpolation are resolved once per block, and while the crossfade
+ * has settled only the audible head is read, as a straight ramp through
+ * BufRd's block reader into the planar outputs. It matches tick().
+ *
+ * Interpolation is the reader's (reader.setInterpolation()), per voice:
+ * 8, 16 or 32 selects a windowed-sinc read for voices that need the
+ * quality, while the rest stay on linear or cubic.
+ *
+ * The phasor and both read heads are 32.32 fixed-point Playheads, so
+ * loops deep inside long buffers (past 2^24 frames) keep their
+ * sub-sample position and wrap without drift.
+ *
+ * Members are ordered hot to cold: what every sample reads comes first,
+ * setter-owned configuration after it.
  */
 struct XPlay {
   enum class PlayMode : uint8_t { Loop = 0, Bounce = 1 };
 
+  // Hot state, touched every sample: phasor, loop window and the UGens
+  Playhead phasor;
+  Playhead headFrames;  ///< Buffer length in fixed point
+  Playhead headStart;   ///< Loop start in fixed point
+  Playhead headSize;    ///< Loop length in fixed point
+  bool isReverse = false;
+  bool inSecondHalf = false;
+
+  BufRd reader;
+  XFade2 xfader;
+  LagLinear fadeLag;
+  EnvelopeADSR env;
+
+  // Configuration, touched only by the setters and once per block
   const Buffer* buffer = nullptr;
   Sample sampleRate = DEFAULT_SAMPLE_RATE;
   Sample start = 0.0f;
@@ -54,21 +89,12 @@ struct XPlay {
   Sample gateValue = 1.0f;
   PlayMode playMode = PlayMode::Loop;
 
-  // Derived state
+  // Derived float copies of the loop window
   Sample frames = 0.0f;
   Sample loopStart = 0.0f;
   Sample loopEnd = 0.0f;
   Sample loopSize = 0.0f;
-  Sample phasor = 0.0f;
-  bool isReverse = false;
-  bool inSecondHalf = false;
 
-  // UGens
-  BufRd reader;
-  Wrap wrapper;
-  XFade2 xfader;
-  LagLinear fadeLag;
-  EnvelopeADSR env;
   DBAmp dbAmp;
 
   /**
@@ -98,6 +124,15 @@ struct XPlay {
     updateLoopBounds();
   }
 
+  /**
+   * @brief Set a relocatable playback buffer.
+   */
+  void setBuffer(const BufferRef& ref) noexcept {
+    buffer = nullptr;
+    reader.setBuffer(ref);
+    updateLoopBounds();
+  }
+
   /**
    * @brief Set start/end points (normalized 0..1).
    */
@@ -147,82 +182,187 @@ struct XPlay {
    */
   bool isDone() const noexcept { return env.isDone(); }
 
+  /**
+   * @brief Get whether the envelope is producing output.
+   */
+  bool isActive() const noexcept { return env.isActive(); }
+
+  /**
+   * @brief Get the current envelope level.
+   */
+  Sample level() const noexcept { return env.value; }
+
   /**
    * @brief Reset phasor to loop start.
    */
-  void resetPhasor() noexcept { phasor = loopStart; }
+  void resetPhasor() noexcept { phasor = headStart; }
+
+  /**
+   * @brief Silence the player and rewind to loop start (gate must be
+   * raised again to restart).
+   */
+  void reset() noexcept {
+    env.reset();
+    gateValue = 0.0f;
+    fadeLag.setValue(-1.0f);
+    phasor = headStart;
+    inSecondHalf = false;
+  }
 
   /**
    * @brief Process one stereo sample.
    * @return Stereo output
    */
   inline Stereo tick() noexcept {
-    if (buffer == nullptr || !buffer->isValid() || loopSize <= 0.0f) {
+    const Buffer* buf = reader.source();
+    if (buf == nullptr || !buf->isValid() || headSize <= Playhead()) {
       return Stereo();
     }
+    const Playhead increment = phaseIncrement(*buf);
+    switch (reader.interpolation) {
+      case 2:
+        return playMode == PlayMode::Bounce
+                   ? frame<PlayMode::Bounce, Interp::Linear>(increment)
+                   : frame<PlayMode::Loop, Interp::Linear>(increment);
+      case 4:
+        return playMode == PlayMode::Bounce
+                   ? frame<PlayMode::Bounce, Interp::Cubic>(increment)
+                   : frame<PlayMode::Loop, Interp::Cubic>(increment);
+      case 8:
+        return playMode == PlayMode::Bounce
+                   ? frame<PlayMode::Bounce, Interp::Sinc8>(increment)
+                   : frame<PlayMode::Loop, Interp::Sinc8>(increment);
+      case 16:
+        return playMode == PlayMode::Bounce
+                   ? frame<PlayMode::Bounce, Interp::Sinc16>(increment)
+                   : frame<PlayMode::Loop, Interp::Sinc16>(increment);
+      case 32:
+        return playMode == PlayMode::Bounce
+                   ? frame<PlayMode::Bounce, Interp::Sinc32>(increment)
+                   : frame<PlayMode::Loop, Interp::Sinc32>(increment);
+      default:
+        return playMode == PlayMode::Bounce
+                   ? frame<PlayMode::Bounce, Interp::Hold>(increment)
+                   : frame<PlayMode::Loop, Interp::Hold>(increment);
+    }
+  }
+
+  /**
+   * @brief Process a block of stereo samples.
+   * @param outL Left output
+   * @param outR Right output
+   * @param numSamples Number of samples to process
+   *
+   * Dispatches on playMode once per block; see process<Mode>().
+   */
+  void process(Sample* outL, Sample* outR, size_t numSamples) noexcept {
+    if (playMode == PlayMode::Bounce) {
+      process<PlayMode::Bounce>(outL, outR, numSamples);
+    } else {
+      process<PlayMode::Loop>(outL, outR, numSamples);
+    }
+  }
 
-    // Compute effective rate with buffer rate scaling and reverse flag
+  /**
+   * @brief Process a block of stereo samples with compile-time play mode.
+   * @tparam Mode Play mode (the playMode member is ignored)
+   * @param outL Left output
+   * @param outR Right output
+   * @param numSamples Number of samples to process
+   *
+   * Output matches tick() sample for sample. The rate scale and the
+   * interpolation dispatch are resolved once per block, and while the
+   * crossfade lag sits at either end only the audible head is read.
+   */
+  template <PlayMode Mode>
+  void process(Sample* outL, Sample* outR, size_t numSamples) noexcept {
+    reader.refresh();
+    const Buffer* buf = reader.source();
+    if (buf == nullptr || !buf->isValid() || headSize <= Playhead()) {
+      for (size_t i = 0; i < numSamples; ++i) {
+        outL[i] = 0.0f;
+        outR[i] = 0.0f;
+      }
+      return;
+    }
+    const Playhead increment = phaseIncrement(*buf);
+    switch (reader.interpolation) {
+      case 2: render<Mode, Interp::Linear>(outL, outR, numSamples, increment); break;
+      case 4: render<Mode, Interp::Cubic>(outL, outR, numSamples, increment); break;
+      case 8: render<Mode, Interp::Sinc8>(outL, outR, numSamples, increment); break;
+      case 16: render<Mode, Interp::Sinc16>(outL, outR, numSamples, increment); break;
+      case 32: render<Mode, Interp::Sinc32>(outL, outR, numSamples, increment); break;
+      default: render<Mode, Interp::Hold>(outL, outR, numSamples, increment); break;
+    }
+  }
+
+ private:
+  /// Phasor advance per sample: rate scaled by buffer/output rate, signed
+  /// by direction; also picks the reader's mip level for that rate
+  Playhead phaseIncrement(const Buffer& buf) noexcept {
     Sample rateScale =
-        buffer->sampleRate > 0.0f ? buffer->sampleRate / sampleRate : 1.0f;
+        buf.sampleRate > 0.0f ? buf.sampleRate / sampleRate : 1.0f;
     Sample effectiveRate = rate * rateScale * (isReverse ? -1.0f : 1.0f);
+    reader.setMipRate(effectiveRate);
+    return Playhead(static_cast<double>(effectiveRate));
+  }
+
+  /**
+   * @brief Position of a read head for a phasor value.
+   * @param phase Phasor inside the 2x loop window
+   * @param second false for head 1, true for head 2
+   */
+  template <PlayMode Mode>
+  inline Playhead headPosition(Playhead phase, bool second) const noexcept {
+    if (Mode == PlayMode::Loop) {
+      return (second ? phase - headSize : phase).wrap(headFrames);
+    }
+    // Bounce: head 1 pingpongs, head 2 mirrors to travel opposite
+    // direction at turns
+    const Playhead twoSize = headSize + headSize;
+    const Playhead phaseWithin = (phase - headStart).wrap(twoSize);
+    const Playhead p = second ? twoSize - phaseWithin : phaseWithin;
+    return headStart + ((p <= headSize) ? p : (twoSize - p));
+  }
 
-    Sample currentPhasor = phasor;
+  /**
+   * @brief Produce one frame and advance the phasor.
+   *
+   * XFade2 at -1 passes head 1 with unity gain and at +1 passes head 2,
+   * so a settled crossfade reads only that head.
+   */
+  template <PlayMode Mode, Interp I>
+  inline Stereo frame(Playhead increment) noexcept {
+    Playhead currentPhasor = phasor;
+    const Playhead twoSize = headSize + headSize;
 
     // Fade toggle when crossing half-point
-    bool nowSecondHalf = currentPhasor >= (loopStart + loopSize);
-    if (nowSecondHalf != inSecondHalf) {
-      inSecondHalf = nowSecondHalf;
-    }
+    inSecondHalf = currentPhasor >= (headStart + headSize);
     Sample fadeTarget = inSecondHalf ? 1.0f : -1.0f;  // map to [-1,1]
     Sample fadeCtrl = fadeLag.tick(fadeTarget);
 
-    // Positions for two read heads
-    Sample pos1 = 0.0f;
-    Sample pos2 = 0.0f;
-
-    if (playMode == PlayMode::Loop) {
-      pos1 = wrapper.process(currentPhasor, 0.0f, frames);
-      pos2 = wrapper.process(currentPhasor - loopSize, 0.0f, frames);
-    } else {  // Bounce
-      Sample twoSize = loopSize * 2.0f;
-      Sample phaseWithin = currentPhasor - loopStart;
-      // Ensure positive modulo inside [0, 2*loopSize)
-      phaseWithin = std::fmod(phaseWithin, twoSize);
-      if (phaseWithin < 0.0f) {
-        phaseWithin += twoSize;
-      }
-
-      auto pingpong = [&](Sample p) -> Sample {
-        return (p <= loopSize) ? p : (twoSize - p);
-      };
-
-      // Head 1 pingpongs, head 2 mirrors to travel opposite direction at turns
-      Sample p1 = pingpong(phaseWithin);
-      Sample p2 = pingpong(twoSize - phaseWithin);
-
-      pos1 = loopStart + p1;
-      pos2 = loopStart + p2;
+    Stereo snd;
+    if (fadeCtrl <= -1.0f) {
+      snd = reader.tickStereo<I>(headPosition<Mode>(currentPhasor, false));
+    } else if (fadeCtrl >= 1.0f) {
+      snd = reader.tickStereo<I>(headPosition<Mode>(currentPhasor, true));
+    } else {
+      Stereo sig1 = reader.tickStereo<I>(headPosition<Mode>(currentPhasor, false));
+      Stereo sig2 = reader.tickStereo<I>(headPosition<Mode>(currentPhasor, true));
+      snd = xfader.process(sig1, sig2, fadeCtrl);
     }
-
-    Stereo sig1 = reader.tickStereo(pos1);
-    Stereo sig2 = reader.tickStereo(pos2);
-
-    // Crossfade
-    Stereo snd = xfader.process(sig1, sig2, fadeCtrl);
     Sample envVal = env.tick();
     snd.left *= envVal;
     snd.right *= envVal;
 
     // Advance phasor over 2x loop window
-    currentPhasor += effectiveRate;
-    Sample loopWindowStart = loopStart;
-    Sample loopWindowEnd = loopStart + (loopSize * 2.0f);
-    if (currentPhasor >= loopWindowEnd) {
-      currentPhasor -= (loopSize * 2.0f);
+    currentPhasor += increment;
+    if (currentPhasor >= headStart + twoSize) {
+      currentPhasor -= twoSize;
       inSecondHalf = false;
-    } else if (currentPhasor < loopWindowStart) {
-      currentPhasor += (loopSize * 2.0f);
-      inSecondHalf = currentPhasor >= (loopStart + loopSize);
+    } else if (currentPhasor < headStart) {
+      currentPhasor += twoSize;
+      inSecondHalf = currentPhasor >= (headStart + headSize);
     }
     phasor = currentPhasor;
 
@@ -230,45 +370,111 @@ struct XPlay {
   }
 
   /**
-   * @brief Process a block of stereo samples.
+   * @brief Render a block, reading settled spans through BufRd's ramp path.
+   *
+   * While the crossfade lag rests at the target of the current half, the
+   * audible head moves in a straight line (slope +-increment) until the
+   * phasor leaves that half, so the span is read straight into the
+   * planar outputs with BufRd::processStereo() and then enveloped.
+   * Spans are also cut where the head would leave [0, frames), so the
+   * reader never wraps them itself. Crossfades go frame by frame.
    */
-  void process(Sample* outL, Sample* outR, size_t numSamples) noexcept {
-    for (size_t i = 0; i < numSamples; ++i) {
-      Stereo s = tick();
-      outL[i] = s.left;
-      outR[i] = s.right;
+  template <PlayMode Mode, Interp I>
+  void render(Sample* outL, Sample* outR, size_t numSamples,
+              Playhead increment) noexcept {
+    const Playhead twoSize = headSize + headSize;
+    const Playhead half = headStart + headSize;
+    size_t i = 0;
+    while (i < numSamples) {
+      const bool second = phasor >= half;
+      const Sample target = second ? 1.0f : -1.0f;
+      const bool settled = fadeLag.currentValue == target &&
+                           fadeLag.targetValue == target &&
+                           fadeLag.samplesRemaining == 0;
+      size_t run = 0;
+      Playhead head;
+      Playhead slope = increment;
+      if (settled) {
+        head = headPosition<Mode>(phasor, second);
+        if (Mode == PlayMode::Bounce && second) {
+          slope = -increment;  // Mirrored half travels the other way
+        }
+        run = std::min(steps(phasor, increment, second ? half : headStart,
+                             second ? headStart + twoSize : half),
+                       steps(head, slope, Playhead(), headFrames));
+        run = std::min(run, numSamples - i);
+      }
+      if (run == 0) {
+        const Stereo s = frame<Mode, I>(increment);
+        outL[i] = s.left;
+        outR[i++] = s.right;
+        continue;
+      }
+
+      inSecondHalf = second;
+      reader.processStereo<I>(outL + i, outR + i, head, slope, run);
+      for (size_t k = i; k < i + run; ++k) {
+        const Sample envVal = env.tick();
+        outL[k] *= envVal;
+        outR[k] *= envVal;
+      }
+      i += run;
+
+      // Advance phasor; only the last step can leave the half
+      phasor = Playhead::fromRaw(phasor.raw +
+                                 increment.raw * static_cast<int64_t>(run));
+      if (phasor >= headStart + twoSize) {
+        phasor -= twoSize;
+        inSecondHalf = false;
+      } else if (phasor < headStart) {
+        phasor += twoSize;
+        inSecondHalf = phasor >= half;
+      }
     }
   }
 
- private:
+  /// Steps from p by inc that stay inside [low, high) (SIZE_MAX if inc is 0)
+  static size_t steps(Playhead p, Playhead inc, Playhead low,
+                      Playhead high) noexcept {
+    if (p < low || p >= high) {
+      return 0;
+    }
+    if (inc.raw == 0) {
+      return SIZE_MAX;
+    }
+    const int64_t n = inc.raw > 0 ? (high.raw - 1 - p.raw) / inc.raw
+                                  : (p.raw - low.raw) / -inc.raw;
+    return static_cast<size_t>(n) + 1;
+  }
+
   void updateLoopBounds(bool resetPhasor = true) noexcept {
-    frames = (buffer && buffer->isValid())
-                 ? static_cast<Sample>(buffer->numSamples)
-                 : 0.0f;
-    loopStart = std::min(start, end) * frames;
-    loopEnd = std::max(start, end) * frames;
+    const Buffer* buf = reader.source();
+    const size_t numFrames = (buf && buf->isValid()) ? buf->numSamples : 0;
+    frames = static_cast<Sample>(numFrames);
+    const double lo = static_cast<double>(std::min(start, end)) * static_cast<double>(numFrames);
+    const double hi = static_cast<double>(std::max(start, end)) * static_cast<double>(numFrames);
+    headFrames = Playhead::fromIndex(static_cast<int64_t>(numFrames));
+    headStart = Playhead(lo);
+    headSize = Playhead(hi - lo);
+    loopStart = static_cast<Sample>(lo);
+    loopEnd = static_cast<Sample>(hi);
     loopSize = std::max(0.0f, loopEnd - loopStart);
     isReverse = start > end;
-    if (resetPhasor || loopSize <= 0.0f) {
-      phasor = loopStart;
+    if (resetPhasor || headSize <= Playhead()) {
+      phasor = headStart;
       inSecondHalf = false;
       return;
     }
 
-    Sample loopWindowStart = loopStart;
-    Sample loopWindowEnd = loopStart + (loopSize * 2.0f);
-
     // Keep phasor inside the new window
-    while (phasor < loopWindowStart) {
-      phasor += (loopSize * 2.0f);
-    }
-    while (phasor >= loopWindowEnd) {
-      phasor -= (loopSize * 2.0f);
-    }
-    inSecondHalf = phasor >= (loopStart + loopSize);
+    phasor = headStart + (phasor - headStart).wrap(headSize + headSize);
+    inSecondHalf = phasor >= (headStart + headSize);
   }
 };
 
+// Five cache lines per player
+static_assert(sizeof(XPlay) <= 320, "XPlay voice exceeds its 320-byte budget");
+
 }  // namespace ugens
 }  // namespace subcollider
 
@@ -30,10 +30,16 @@
 #include <subcollider/ugens/OberheimMoogLadder.h>
 #include <subcollider/ugens/ImprovedMoogLadder.h>
 #include <subcollider/ugens/RKSimulationMoogLadder.h>
+#include <subcollider/ugens/ZDFMoogLadder.h>
+#include <subcollider/ugens/LadderBank.h>
 #include <subcollider/ugens/RLPF.h>
 #include <subcollider/ugens/OnePoleLPF.h>
 #include <subcollider/ugens/Wrap.h>
 #include <subcollider/ugens/LinLin.h>
+#include <subcollider/ugens/BufRd.h>
+#include <subcollider/ugens/PlayBuf.h>
+#include <subcollider/ugens/XPlay.h>
+#include <subcollider/ugens/GrainCloud.h>
 
 using namespace subcollider;
 using namespace subcollider::ugens;
@@ -275,10 +281,11 @@ void benchmarkEnvelopeADSR() {
 }
 
 /**
- * @brief Benchmark SuperSaw tick().
+ * @brief Benchmark SuperSawN<Voices> tick().
  */
-void benchmarkSuperSaw() {
-    SuperSaw supersaw;
+template<size_t Voices>
+void benchmarkSuperSaw(const std::string& name) {
+    SuperSawN<Voices> supersaw;
     supersaw.init(48000.0f);
     supersaw.setFrequency(440.0f);
     supersaw.setAttack(0.01f);
@@ -321,7 +328,7 @@ void benchmarkSuperSaw() {
     double seconds = duration.count() / 1e9;
     double ticksPerSec = BENCHMARK_ITERATIONS / seconds;
 
-    printResult("SuperSaw", ticksPerSec);
+    printResult(name, ticksPerSec);
     (void)sinkL;
     (void)sinkR;
 }
@@ -656,10 +663,11 @@ void benchmarkMicrotrackerMoogLadder() {
 }
 
 /**
- * @brief Benchmark KrajeskiMoogLadder tick().
+ * @brief Benchmark KrajeskiMoogLadder tick(), at the precision of Filter.
  */
-void benchmarkKrajeskiMoogLadder() {
-    KrajeskiMoogLadder filter;
+template<typename Filter>
+void benchmarkKrajeskiMoogLadder(const std::string& name) {
+    Filter filter;
     filter.init(48000.0f);
     filter.setCutoff(1000.0f);
     filter.setResonance(0.4f);
@@ -684,7 +692,7 @@ void benchmarkKrajeskiMoogLadder() {
     double seconds = duration.count() / 1e9;
     double ticksPerSec = BENCHMARK_ITERATIONS / seconds;
 
-    printResult("KrajeskiMoog", ticksPerSec);
+    printResult(name, ticksPerSec);
     (void)sink;
 }
 
@@ -722,10 +730,11 @@ void benchmarkMusicDSPMoogLadder() {
 }
 
 /**
- * @brief Benchmark OberheimMoogLadder tick().
+ * @brief Benchmark OberheimMoogLadder tick(), at the precision of Filter.
  */
-void benchmarkOberheimMoogLadder() {
-    OberheimMoogLadder filter;
+template<typename Filter>
+void benchmarkOberheimMoogLadder(const std::string& name) {
+    Filter filter;
     filter.init(48000.0f);
     filter.setCutoff(1000.0f);
     filter.setResonance(0.4f);
@@ -750,15 +759,16 @@ void benchmarkOberheimMoogLadder() {
     double seconds = duration.count() / 1e9;
     double ticksPerSec = BENCHMARK_ITERATIONS / seconds;
 
-    printResult("OberheimMoog", ticksPerSec);
+    printResult(name, ticksPerSec);
     (void)sink;
 }
 
 /**
- * @brief Benchmark ImprovedMoogLadder tick().
+ * @brief Benchmark ImprovedMoogLadder tick(), at the precision of Filter.
  */
-void benchmarkImprovedMoogLadder() {
-    ImprovedMoogLadder filter;
+template<typename Filter>
+void benchmarkImprovedMoogLadder(const std::string& name) {
+    Filter filter;
     filter.init(48000.0f);
     filter.setCutoff(1000.0f);
     filter.setResonance(0.4f);
@@ -783,15 +793,16 @@ void benchmarkImprovedMoogLadder() {
     double seconds = duration.count() / 1e9;
     double ticksPerSec = BENCHMARK_ITERATIONS / seconds;
 
-    printResult("ImprovedMoog", ticksPerSec);
+    printResult(name, ticksPerSec);
     (void)sink;
 }
 
 /**
- * @brief Benchmark RKSimulationMoogLadder tick().
+ * @brief Benchmark RKSimulationMoogLadder tick(), at the precision of Filter.
  */
-void benchmarkRKSimulationMoogLadder() {
-    RKSimulationMoogLadder filter;
+template<typename Filter>
+void benchmarkRKSimulationMoogLadder(const std::string& name) {
+    Filter filter;
     filter.init(48000.0f);
     filter.setCutoff(1000.0f);
     filter.setResonance(0.4f);
@@ -816,15 +827,17 @@ void benchmarkRKSimulationMoogLadder() {
     double seconds = duration.count() / 1e9;
     double ticksPerSec = BENCHMARK_ITERATIONS / seconds;
 
-    printResult("RKSimulMoog", ticksPerSec);
+    printResult(name, ticksPerSec);
     (void)sink;
 }
 
 /**
- * @brief Benchmark RKSimulationMoogLadder tick() with 2x oversampling.
+ * @brief Benchmark RKSimulationMoogLadder tick() with 2x oversampling, at the
+ *        precision of Filter.
  */
-void benchmarkRKSimulationMoogLadder2x() {
-    RKSimulationMoogLadder filter;
+template<typename Filter>
+void benchmarkRKSimulationMoogLadder2x(const std::string& name) {
+    Filter filter;
     filter.init(48000.0f);
     filter.setOversampleFactor(2);  // 2x oversampling
     filter.setCutoff(1000.0f);
@@ -850,9 +863,103 @@ void benchmarkRKSimulationMoogLadder2x() {
     double seconds = duration.count() / 1e9;
     double ticksPerSec = BENCHMARK_ITERATIONS / seconds;
 
-    printResult("RKSimulMoog2x", ticksPerSec);
+    printResult(name, ticksPerSec);
     (void)sink;
 }
+
+/**
+ * @brief Time tick() of an initialized ladder under the shared parameter sweep.
+ * @return Ticks per second
+ */
+template<typename Filter>
+double ladderTicksPerSecond(Filter& filter) {
+    // Warmup
+    volatile Sample sink = 0.0f;
+    Sample input = 0.5f;
+    for (int i = 0; i < WARMUP_ITERATIONS; ++i) {
+        updateLadderParams(filter, i);
+        sink = filter.tick(input);
+    }
+
+    // Benchmark
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        updateLadderParams(filter, i);
+        sink = filter.tick(input);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    (void)sink;
+    return BENCHMARK_ITERATIONS / (duration.count() / 1e9);
+}
+
+/**
+ * @brief Benchmark ZDFMoogLadderT<T> one-pass and corrected tick()
+ *        against RKSimulationMoogLadderT<T> without oversampling.
+ */
+template<typename T>
+void benchmarkZDFMoogLadder(const std::string& name) {
+    RKSimulationMoogLadderT<T> rk;
+    ZDFMoogLadderT<T> onePass;
+    ZDFMoogLadderT<T, true> corrected;
+    rk.init(48000.0f);
+    onePass.init(48000.0f);
+    corrected.init(48000.0f);
+    rk.setCutoff(1000.0f);
+    onePass.setCutoff(1000.0f);
+    corrected.setCutoff(1000.0f);
+    rk.setResonance(0.4f);
+    onePass.setResonance(0.4f);
+    corrected.setResonance(0.4f);
+
+    const double rkTicks = ladderTicksPerSecond(rk);
+    const double onePassTicks = ladderTicksPerSecond(onePass);
+    const double correctedTicks = ladderTicksPerSecond(corrected);
+    printResult(name, onePassTicks);
+    printResult(name + "Cor", correctedTicks);
+    std::cout << "  cost vs RK 1x: one-pass " << std::setprecision(2) << rkTicks / onePassTicks
+              << "x, corrected " << rkTicks / correctedTicks << "x" << std::endl;
+}
+
+/**
+ * @brief Benchmark LadderBank<Model, Lanes> planar process(), reported
+ *        per filter instance so it compares with the scalar ladders.
+ */
+template<typename Model, size_t Lanes>
+void benchmarkLadderBank(const std::string& name) {
+    const size_t n = PARAM_CHANGE_BLOCK_SIZE;
+    static LadderBank<Model, Lanes> bank;
+    static Sample buffers[Lanes][PARAM_CHANGE_BLOCK_SIZE];
+    Sample* channels[Lanes];
+    for (size_t k = 0; k < Lanes; ++k) {
+        channels[k] = buffers[k];
+    }
+    bank.init(48000.0f);
+    volatile Sample sink = 0.0f;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int block = 0; block < BENCHMARK_ITERATIONS / static_cast<int>(n); ++block) {
+        for (size_t k = 0; k < Lanes; ++k) {
+            bank.setParameters(k, cutoffForBlock(block + static_cast<int>(k)),
+                               resonanceForBlock(block + static_cast<int>(k)));
+            for (size_t i = 0; i < n; ++i) {
+                buffers[k][i] = 0.5f;
+            }
+        }
+        bank.process(channels, n);
+        sink = buffers[Lanes - 1][n - 1];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    double seconds = duration.count() / 1e9;
+    double ticksPerSec = static_cast<double>(Lanes) * (BENCHMARK_ITERATIONS / n) * n / seconds;
+
+    printResult(name, ticksPerSec);
+    (void)sink;
+}
+
 /**
  * @brief Benchmark RLPF tick().
  */
@@ -961,6 +1068,203 @@ void benchmarkOnePoleLPF() {
     printResult("OnePoleLPF", ticksPerSec);
 }
 
+/**
+ * @brief Benchmark BufRd stereo cubic reads: tick() against the block API.
+ */
+void benchmarkBufRd() {
+    const int n = 64;
+    static constexpr size_t FRAMES = 48000;
+    static Sample data[FRAMES * 2];
+    for (size_t i = 0; i < FRAMES * 2; ++i) {
+        data[i] = static_cast<Sample>(i % 97) * 0.01f - 0.5f;
+    }
+    Buffer buf(data, 2, 48000.0f, FRAMES);
+    BufRd reader;
+    reader.init(&buf);
+    reader.setInterpolation(4);
+    const Sample rate = 1.37f;
+    Sample left[n];
+    Sample right[n];
+    volatile Sample sink = 0.0f;
+
+    // tick() per sample
+    Sample phase = 0.0f;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+        for (int k = 0; k < n; ++k) {
+            Stereo s = reader.tickStereo(phase);
+            left[k] = s.left;
+            right[k] = s.right;
+            phase += rate;
+        }
+        sink = left[0] + right[n - 1];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    printResult("BufRd (tick)", (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+
+    // Block API with compile-time interpolation
+    phase = 0.0f;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+        phase = reader.processStereo<Interp::Cubic>(left, right, phase, rate, n);
+        sink = left[0] + right[n - 1];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    printResult("BufRd (block)", (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+
+    // Windowed-sinc block reads, per kernel length
+    const uint8_t taps[3] = {8, 16, 32};
+    const char* names[3] = {"BufRd (sinc8)", "BufRd (sinc16)", "BufRd (sinc32)"};
+    for (int t = 0; t < 3; ++t) {
+        reader.setInterpolation(taps[t]);
+        phase = 0.0f;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+            phase = reader.processStereo(left, right, phase, rate, n);
+            sink = left[0] + right[n - 1];
+        }
+        end = std::chrono::high_resolution_clock::now();
+        seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+        printResult(names[t], (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+    }
+    (void)sink;
+}
+
+/**
+ * @brief Benchmark PlayBuf stereo linear playback against Phasor + BufRd.
+ */
+void benchmarkPlayBuf() {
+    const int n = 64;
+    static constexpr size_t FRAMES = 48000;
+    static Sample data[FRAMES * 2];
+    for (size_t i = 0; i < FRAMES * 2; ++i) {
+        data[i] = static_cast<Sample>(i % 89) * 0.01f - 0.5f;
+    }
+    Buffer buf(data, 2, 48000.0f, FRAMES);
+    Sample left[n];
+    Sample right[n];
+    volatile Sample sink = 0.0f;
+
+    Phasor phasor;
+    phasor.init(48000.0f);
+    phasor.set(1.37f, 0.0f, static_cast<Sample>(FRAMES));
+    BufRd reader;
+    reader.init(&buf);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+        for (int k = 0; k < n; ++k) {
+            Stereo s = reader.tickStereo(phasor.tick());
+            left[k] = s.left;
+            right[k] = s.right;
+        }
+        sink = left[0] + right[n - 1];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    printResult("Phasor+BufRd", (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+
+    PlayBuf player;
+    player.init(48000.0f, &buf);
+    player.setRate(1.37f);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+        player.processStereo(left, right, n);
+        sink = left[0] + right[n - 1];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    printResult("PlayBuf", (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+    (void)sink;
+}
+
+/**
+ * @brief Benchmark XPlay tick() against block process().
+ */
+void benchmarkXPlay() {
+    const int n = 64;
+    static constexpr size_t FRAMES = 48000;
+    static Sample data[FRAMES * 2];
+    for (size_t i = 0; i < FRAMES * 2; ++i) {
+        data[i] = static_cast<Sample>(i % 89) * 0.01f - 0.5f;
+    }
+    Buffer buf(data, 2, 44100.0f, FRAMES);
+    Sample left[n];
+    Sample right[n];
+    volatile Sample sink = 0.0f;
+
+    XPlay xplay;
+    xplay.init(48000.0f);
+    xplay.setBuffer(&buf);
+    xplay.setStartEnd(0.1f, 0.9f);
+    xplay.setRate(1.37f);
+    xplay.setGate(1.0f);
+    XPlay blocked = xplay;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+        for (int k = 0; k < n; ++k) {
+            Stereo s = xplay.tick();
+            left[k] = s.left;
+            right[k] = s.right;
+        }
+        sink = left[0] + right[n - 1];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    printResult("XPlay tick", (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+        blocked.process(left, right, n);
+        sink = left[0] + right[n - 1];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    printResult("XPlay block", (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+    (void)sink;
+}
+
+/**
+ * @brief Benchmark a 64-grain GrainCloud, counted per grain to compare with XPlay.
+ */
+void benchmarkGrainCloud() {
+    const int n = 64;
+    static constexpr size_t FRAMES = 48000;
+    static Sample data[FRAMES * 2];
+    for (size_t i = 0; i < FRAMES * 2; ++i) {
+        data[i] = static_cast<Sample>(i % 89) * 0.01f - 0.5f;
+    }
+    Buffer buf(data, 2, 44100.0f, FRAMES);
+    Sample left[n];
+    Sample right[n];
+    volatile Sample sink = 0.0f;
+
+    static GrainCloud<128> cloud;
+    cloud.init(48000.0f);
+    cloud.setBuffer(&buf);
+    cloud.setDensity(1280.0f);  // 64 grains of 50 ms overlap
+    cloud.setDuration(0.05f);
+    cloud.setPosition(0.5f, 0.4f);
+    cloud.setRate(1.37f, 0.1f);
+    cloud.setPan(0.0f, 1.0f);
+    for (int i = 0; i < 100; ++i) {
+        cloud.process(left, right, n);  // Fill the cloud
+    }
+    const double grains = static_cast<double>(cloud.activeGrains());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS / n; ++i) {
+        cloud.process(left, right, n);
+        sink = left[0] + right[n - 1];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+    printResult("GrainCloud grain", grains * (BENCHMARK_ITERATIONS / n) * static_cast<double>(n) / seconds);
+    (void)sink;
+}
+
 int main() {
     std::cout << "=== SubCollider UGen Benchmarks ===" << std::endl;
     std::cout << std::endl;
@@ -970,7 +1274,9 @@ int main() {
     benchmarkLFTri();
     benchmarkEnvelopeAR();
     benchmarkEnvelopeADSR();
-    benchmarkSuperSaw();
+    benchmarkSuperSaw<7>("SuperSaw");
+    benchmarkSuperSaw<8>("SuperSaw 8");
+    benchmarkSuperSaw<16>("SuperSaw 16");
     benchmarkLFNoise2();
     benchmarkPan2();
     benchmarkXFade2();
@@ -979,15 +1285,34 @@ int main() {
     benchmarkLagLinear();
     benchmarkLinLin();
     benchmarkPhasor();
+    benchmarkBufRd();
+    benchmarkPlayBuf();
+    benchmarkXPlay();
+    benchmarkGrainCloud();
     benchmarkCombC();
     benchmarkStilsonMoogLadder();
     benchmarkMicrotrackerMoogLadder();
-    benchmarkKrajeskiMoogLadder();
+    benchmarkKrajeskiMoogLadder<KrajeskiMoogLadder>("KrajeskiMoog");
+    benchmarkKrajeskiMoogLadder<KrajeskiMoogLadderF>("KrajeskiMoogF");
     benchmarkMusicDSPMoogLadder();
-    benchmarkOberheimMoogLadder();
-    benchmarkImprovedMoogLadder();
-    benchmarkRKSimulationMoogLadder();
-    benchmarkRKSimulationMoogLadder2x();
+    benchmarkOberheimMoogLadder<OberheimMoogLadder>("OberheimMoog");
+    benchmarkOberheimMoogLadder<OberheimMoogLadderF>("OberheimMoogF");
+    benchmarkImprovedMoogLadder<ImprovedMoogLadder>("ImprovedMoog");
+    benchmarkImprovedMoogLadder<ImprovedMoogLadderF>("ImprovedMoogF");
+    benchmarkRKSimulationMoogLadder<RKSimulationMoogLadder>("RKSimulMoog");
+    benchmarkRKSimulationMoogLadder<RKSimulationMoogLadderF>("RKSimulMoogF");
+    benchmarkRKSimulationMoogLadder2x<RKSimulationMoogLadder>("RKSimulMoog2x");
+    benchmarkRKSimulationMoogLadder2x<RKSimulationMoogLadderF>("RKSimul2xF");
+    benchmarkZDFMoogLadder<double>("ZDFMoog");
+    benchmarkZDFMoogLadder<float>("ZDFMoogF");
+    benchmarkLadderBank<StilsonMoogLadder, 8>("Stilson x8");
+    benchmarkLadderBank<MicrotrackerMoogLadder, 8>("Microtrack x8");
+    benchmarkLadderBank<KrajeskiMoogLadder, 8>("Krajeski x8");
+    benchmarkLadderBank<MusicDSPMoogLadder, 8>("MusicDSP x8");
+    benchmarkLadderBank<OberheimMoogLadder, 8>("Oberheim x8");
+    benchmarkLadderBank<ImprovedMoogLadder, 8>("Improved x8");
+    benchmarkLadderBank<RKSimulationMoogLadder, 8>("RKSimul x8");
+    benchmarkLadderBank<KrajeskiMoogLadder, 4>("Krajeski x4");
     benchmarkRLPF();
     benchmarkOnePoleLPF();
 
@@ -5,8 +5,11 @@
 
 #include <iostream>
 #include <cmath>
+#include <cstdint>
+#include <thread>
 #include <subcollider/AudioBuffer.h>
 #include <subcollider/AudioLoop.h>
+#include <subcollider/AudioRingLoop.h>
 
 using namespace subcollider;
 
@@ -132,5 +135,112 @@ int test_audioloop() {
         TEST("AudioCallbackHandler: buffer was modified", buffer[0] == 1.0f);
     }
 
+    // Test AudioRingLoop initialization
+    {
+        AudioRingLoop<64, 4> ring;
+        ring.init(48000.0f, 2);
+        TEST("AudioRingLoop init: sample rate set", ring.sampleRate == 48000.0f);
+        TEST("AudioRingLoop init: run-ahead limit", ring.maxAhead() == 2);
+        TEST("AudioRingLoop init: writable up to limit", ring.writable() == 2);
+        TEST("AudioRingLoop init: nothing readable", ring.readable() == 0);
+    }
+
+    // Test AudioRingLoop FIFO order and run-ahead limit
+    {
+        AudioRingLoop<16, 3> ring;
+        ring.init(48000.0f);
+        for (int block = 0; block < 3; ++block) {
+            Sample* buf = ring.getProcessingBuffer();
+            buf[0] = static_cast<Sample>(block + 1);
+            ring.swapBuffers();
+        }
+        TEST("AudioRingLoop full: not writable", ring.writable() == 0);
+        TEST("AudioRingLoop full: write rejected", ring.getProcessingBuffer() == nullptr);
+        TEST("AudioRingLoop full: overrun counted", ring.overrunCount() == 1);
+
+        bool inOrder = true;
+        for (int block = 0; block < 3; ++block) {
+            const Sample* out = ring.getOutputBuffer();
+            inOrder = inOrder && out[0] == static_cast<Sample>(block + 1);
+            ring.releaseOutputBuffer();
+        }
+        TEST("AudioRingLoop: blocks read in order", inOrder);
+        TEST("AudioRingLoop: no underrun while data ready", ring.underrunCount() == 0);
+    }
+
+    // Test AudioRingLoop underrun returns silence
+    {
+        AudioRingLoop<16, 3> ring;
+        ring.init(48000.0f);
+        const Sample* out = ring.getOutputBuffer();
+        TEST("AudioRingLoop underrun: silent block", out[0] == 0.0f && out[15] == 0.0f);
+        TEST("AudioRingLoop underrun: counted", ring.underrunCount() == 1);
+        ring.releaseOutputBuffer();
+        TEST("AudioRingLoop underrun: release is a no-op", ring.writable() == 3);
+    }
+
+    // Test AudioRingLoop across threads without tearing
+    {
+        static AudioRingLoop<64, 4> ring;
+        ring.init(48000.0f, 3);
+        constexpr int BLOCKS = 20000;
+
+        std::thread renderer([]() {
+            int block = 0;
+            while (block < BLOCKS) {
+                if (ring.writable() == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                Sample* buf = ring.getProcessingBuffer();
+                for (size_t i = 0; i < 64; ++i) {
+                    buf[i] = static_cast<Sample>(block);
+                }
+                ring.swapBuffers();
+                ++block;
+            }
+        });
+
+        int expected = 0;
+        bool consistent = true;
+        while (expected < BLOCKS) {
+            if (ring.readable() == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            const Sample* out = ring.getOutputBuffer();
+            for (size_t i = 0; i < 64; ++i) {
+                if (out[i] != static_cast<Sample>(expected)) {
+                    consistent = false;
+                }
+            }
+            ring.releaseOutputBuffer();
+            ++expected;
+        }
+        renderer.join();
+
+        TEST("AudioRingLoop threads: every block intact and in order", consistent);
+        TEST("AudioRingLoop threads: no overruns", ring.overrunCount() == 0);
+    }
+
+    // Test StereoAudioLoop planar buffers
+    {
+        StereoAudioLoop<64> loop;
+        loop.init(48000.0f);
+        TEST("StereoAudioLoop init: two channels", loop.numChannels == 2);
+
+        auto& proc = loop.getProcessingBuffer();
+        proc.left()[0] = 1.0f;
+        proc.right()[0] = -1.0f;
+        loop.swapBuffers();
+
+        const auto& out = loop.getOutputBuffer();
+        TEST("StereoAudioLoop swap: output holds rendered block",
+             out.left()[0] == 1.0f && out.right()[0] == -1.0f);
+        TEST("StereoAudioLoop swap: processing buffer changes", &loop.getProcessingBuffer() != &out);
+        TEST("StereoAudioLoop: channels aligned",
+             reinterpret_cast<uintptr_t>(out.right()) % 64 == 0);
+    }
+
     return failures;
 }
@@ -4,8 +4,13 @@
  */
 
 #include <iostream>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
 #include <subcollider/BufferAllocator.h>
+#include <subcollider/ConcurrentBufferAllocator.h>
 
 using namespace subcollider;
 
@@ -20,8 +25,16 @@ using namespace subcollider;
 // Use smaller pool size for tests to avoid large memory usage
 // 48000 floats total (not per channel), 16 blocks max
 using TestAllocator = BufferAllocator<48000, 16>;
+using TestTlsfAllocator = TlsfBufferAllocator<48000, 16>;
+#if defined(SUBCOLLIDER_HAS_MMAP)
+using TestMmapAllocator = MmapBufferAllocator<48000, 16, TlsfStrategy>;
+#endif
 
-int test_bufferallocator() {
+namespace {
+
+/// Shared allocator semantics, run once per block strategy
+template<typename TestAllocator>
+int allocatorSemantics() {
     int failures = 0;
 
     // Test uninitialized allocator
@@ -349,5 +362,287 @@ int test_bufferallocator() {
         TEST("Allocator buffer getStereoSample(1).right", std::abs(s1.right - 0.6f) < 0.0001f);
     }
 
+    // Test guard frames: reserved around the data, released with it
+    {
+        TestAllocator alloc;
+        alloc.init(48000.0f);
+        const size_t before = alloc.freeSpace();
+        Buffer buf = alloc.allocate(4, 2, 3);
+        TEST("Allocator guard: buffer valid", buf.isValid() && buf.guardFrames == 3);
+        TEST("Allocator guard: guard floats reserved", alloc.freeSpace() == before - (4 + 6) * 2);
+        TEST("Allocator guard: guards start unused", !buf.hasGuards(Buffer::GuardMode::Wrap, 1));
+
+        Sample left[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+        Sample right[4] = {-1.0f, -2.0f, -3.0f, -4.0f};
+        TestAllocator::fillStereo(buf, left, right, 4);
+        buf.updateGuards(Buffer::GuardMode::Wrap);
+        TEST("Allocator guard wrap: frame -1 is last frame",
+             buf.data[-2] == 4.0f && buf.data[-1] == -4.0f);
+        TEST("Allocator guard wrap: frame -3 is frame 1", buf.data[-6] == 2.0f);
+        TEST("Allocator guard wrap: frames past end are first frames",
+             buf.data[8] == 1.0f && buf.data[9] == -1.0f && buf.data[12] == 3.0f);
+        TEST("Allocator guard wrap: reach check", buf.hasGuards(Buffer::GuardMode::Wrap, 3) &&
+             !buf.hasGuards(Buffer::GuardMode::Wrap, 4) && !buf.hasGuards(Buffer::GuardMode::Clamp, 1));
+
+        buf.updateGuards(Buffer::GuardMode::Clamp);
+        TEST("Allocator guard clamp: edges repeated",
+             buf.data[-6] == 1.0f && buf.data[-1] == -1.0f && buf.data[12] == 4.0f && buf.data[13] == -4.0f);
+
+        left[3] = 40.0f;
+        TestAllocator::fillStereo(buf, left, right, 4);
+        TEST("Allocator guard: fill refreshes guards in their mode", buf.data[12] == 40.0f);
+
+        TEST("Allocator guard: release", alloc.release(buf));
+        TEST("Allocator guard: all space returned", alloc.freeSpace() == before);
+    }
+
+    // Test guard frames wrap around buffers shorter than the guard
+    {
+        TestAllocator alloc;
+        alloc.init(48000.0f);
+        Buffer buf = alloc.allocate(2, 1, 3);
+        Sample data[2] = {5.0f, 6.0f};
+        TestAllocator::fillMono(buf, data, 2);
+        buf.updateGuards(Buffer::GuardMode::Wrap);
+        TEST("Allocator guard short: before wraps repeatedly",
+             buf.data[-1] == 6.0f && buf.data[-2] == 5.0f && buf.data[-3] == 6.0f);
+        TEST("Allocator guard short: after wraps repeatedly",
+             buf.data[2] == 5.0f && buf.data[3] == 6.0f && buf.data[4] == 5.0f);
+    }
+
+    return failures;
+}
+
+} // namespace
+
+int test_bufferallocator() {
+    int failures = 0;
+
+    std::cout << "(first-fit)" << std::endl;
+    failures += allocatorSemantics<TestAllocator>();
+
+    std::cout << "(TLSF)" << std::endl;
+    failures += allocatorSemantics<TestTlsfAllocator>();
+
+    // Test TLSF buffers carry a block id for O(1) release
+    {
+        TestTlsfAllocator alloc;
+        alloc.init(48000.0f);
+        Buffer buf = alloc.allocate(100, 1);
+        TEST("TLSF: buffer carries block id", buf.blockId != Buffer::NO_BLOCK);
+
+        Buffer copy(buf.data, buf.channels, buf.sampleRate, buf.numSamples);
+        TEST("TLSF: release without id falls back to lookup", alloc.release(copy));
+        TEST("TLSF: double release rejected", !alloc.release(buf));
+    }
+
+    // Test TLSF reuses a freed hole of the same size
+    {
+        TestTlsfAllocator alloc;
+        alloc.init(48000.0f);
+        Buffer a = alloc.allocate(4000, 1);
+        Buffer b = alloc.allocate(4000, 1);
+        Buffer c = alloc.allocate(4000, 1);
+        alloc.release(b);
+        Buffer d = alloc.allocate(4000, 1);
+        TEST("TLSF hole: same-size request fills hole", d.data == b.data);
+        TEST("TLSF hole: neighbours untouched", a.isValid() && c.isValid());
+    }
+
+    // Test TLSF hands out whole blocks once records run out
+    {
+        TlsfBufferAllocator<1000, 2> alloc;
+        alloc.init(48000.0f);
+        Buffer a = alloc.allocate(100, 1);
+        Buffer b = alloc.allocate(100, 1);
+        TEST("TLSF records exhausted: last block not split", b.isValid() && alloc.freeSpace() == 0);
+        TEST("TLSF records exhausted: further allocation fails", !alloc.allocate(1, 1).isValid());
+        alloc.release(a);
+        alloc.release(b);
+        TEST("TLSF records exhausted: full pool again", alloc.freeSpace() == 1000 && alloc.blockCount() == 1);
+    }
+
+    // Test TLSF under random churn: no overlap, exact accounting, full coalescing
+    {
+        using ChurnAllocator = TlsfBufferAllocator<1 << 16, 256>;
+        static ChurnAllocator alloc;
+        alloc.init(48000.0f);
+
+        std::vector<Buffer> live;
+        uint32_t rng = 12345;
+        bool overlapFree = true;
+        bool accountingExact = true;
+        for (int step = 0; step < 5000; ++step) {
+            rng = rng * 1664525u + 1013904223u;
+            if (live.size() < 100 && (rng >> 16) % 3 != 0) {
+                const size_t size = 1 + (rng >> 8) % 2000;
+                Buffer buf = alloc.allocate(size, 1);
+                if (buf.isValid()) {
+                    for (const Buffer& other : live) {
+                        if (buf.data < other.data + other.numSamples &&
+                            other.data < buf.data + buf.numSamples) {
+                            overlapFree = false;
+                        }
+                    }
+                    live.push_back(buf);
+                }
+            } else if (!live.empty()) {
+                const size_t index = (rng >> 4) % live.size();
+                alloc.release(live[index]);
+                live[index] = live.back();
+                live.pop_back();
+            }
+
+            size_t used = 0;
+            for (const Buffer& buf : live) {
+                used += buf.numSamples;
+            }
+            if (alloc.usedSpace() != used) {
+                accountingExact = false;
+            }
+        }
+        TEST("TLSF churn: no overlapping buffers", overlapFree);
+        TEST("TLSF churn: used space exact", accountingExact);
+
+        for (const Buffer& buf : live) {
+            alloc.release(buf);
+        }
+        TEST("TLSF churn: everything coalesces", alloc.blockCount() == 1);
+        TEST("TLSF churn: whole pool allocatable", alloc.allocate(1 << 16, 1).isValid());
+    }
+
+#if defined(SUBCOLLIDER_HAS_MMAP)
+    std::cout << "(mmap)" << std::endl;
+    failures += allocatorSemantics<TestMmapAllocator>();
+
+    // Test mmap pool is committed lazily and prefault/lock commit buffers
+    {
+        constexpr size_t POOL = size_t(1) << 24;  // 64 MB
+        MmapBufferAllocator<POOL, 16> alloc;
+        alloc.init(48000.0f);
+        TEST("Mmap: init succeeds", alloc.isInitialized());
+        TEST("Mmap: pool not resident after init",
+             alloc.storage().residentBytes(0, POOL) < POOL * sizeof(Sample) / 8);
+
+        Buffer buf = alloc.allocate(1 << 18, 1);
+        buf.data[0] = 0.25f;
+        TEST("Mmap: prefault succeeds", alloc.prefault(buf));
+        TEST("Mmap: prefaulted buffer resident",
+             alloc.storage().residentBytes(0, buf.totalFloats()) >= buf.totalFloats() * sizeof(Sample));
+        TEST("Mmap: prefault keeps contents", buf.data[0] == 0.25f && buf.data[1000] == 0.0f);
+
+        Buffer other = alloc.allocate(1 << 16, 1);
+        if (alloc.lock(other)) {
+            TEST("Mmap: lock succeeds (or RLIMIT_MEMLOCK)", alloc.unlock(other));
+        } else {
+            TEST("Mmap: lock succeeds (or RLIMIT_MEMLOCK)", true);
+        }
+        TEST("Mmap: prefault of foreign buffer rejected",
+             !alloc.prefault(Buffer(&buf.sampleRate, 1, 48000.0f, 1)));
+
+        alloc.reset();
+        Buffer again = alloc.allocate(1 << 18, 1);
+        TEST("Mmap: reset zeroes pool", again.data == buf.data && again.data[0] == 0.0f);
+        TEST("Mmap: reset drops pages",
+             alloc.storage().residentBytes(0, POOL) < POOL * sizeof(Sample) / 8);
+    }
+#endif
+
+    // Test concurrent allocator defers releases until reclaim
+    {
+        static ConcurrentBufferAllocator<TestTlsfAllocator, 4> alloc;
+        alloc.init(48000.0f);
+        Buffer a = alloc.allocate(1000, 1);
+        Buffer b = alloc.allocate(1000, 1);
+        TEST("Concurrent: allocations valid", a.isValid() && b.isValid() && a.data != b.data);
+        TEST("Concurrent: release queued", alloc.release(a));
+        TEST("Concurrent: memory held until reclaim", alloc.usedSpace() == 2000);
+        TEST("Concurrent: reclaim releases queued buffer", alloc.reclaim() == 1);
+        TEST("Concurrent: memory returned", alloc.usedSpace() == 1000);
+
+        alloc.release(b);
+        Buffer c = alloc.allocate(48000, 1);
+        TEST("Concurrent: allocate reclaims pending first", c.isValid());
+        alloc.release(c);
+
+        Buffer bufs[5];
+        for (Buffer& buf : bufs) {
+            buf = alloc.allocate(10, 1);
+        }
+        bool queued = true;
+        for (size_t i = 0; i < 4; ++i) {
+            queued = queued && alloc.release(bufs[i]);
+        }
+        TEST("Concurrent: full queue rejects release", queued && !alloc.release(bufs[4]));
+        TEST("Concurrent: rejected release counted", alloc.droppedReleases() == 1);
+        alloc.reclaim();
+        TEST("Concurrent: retry after reclaim succeeds", alloc.release(bufs[4]));
+    }
+
+    // Test loader thread allocating while the audio thread releases
+    {
+        using Pool = ConcurrentBufferAllocator<TlsfBufferAllocator<1 << 16, 256>, 256>;
+        static Pool alloc;
+        alloc.init(48000.0f);
+        alloc.startReclaimer(std::chrono::microseconds(200));
+
+        MpscRing<Buffer, 64> handoff;
+        std::atomic<bool> loading{true};
+        std::atomic<int> corrupt{0};
+        std::atomic<int> loaded{0};
+
+        std::thread loader([&]() {
+            uint32_t rng = 777;
+            for (int i = 0; i < 4000; ++i) {
+                rng = rng * 1664525u + 1013904223u;
+                Buffer buf = alloc.allocate(1 + (rng >> 8) % 1500, 1);
+                if (!buf.isValid()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const Sample tag = static_cast<Sample>(i);
+                for (size_t k = 0; k < buf.numSamples; ++k) {
+                    buf.data[k] = tag;
+                }
+                while (!handoff.tryPush(buf)) {
+                    std::this_thread::yield();
+                }
+                loaded.fetch_add(1, std::memory_order_relaxed);
+            }
+            loading.store(false, std::memory_order_release);
+        });
+
+        std::thread audio([&]() {
+            Buffer buf;
+            for (;;) {
+                if (!handoff.tryPop(buf)) {
+                    if (!loading.load(std::memory_order_acquire) && handoff.empty()) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (size_t k = 1; k < buf.numSamples; ++k) {
+                    if (buf.data[k] != buf.data[0]) {
+                        corrupt.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+                while (!alloc.release(buf)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        loader.join();
+        audio.join();
+        alloc.stopReclaimer();
+
+        TEST("Concurrent stress: buffers loaded", loaded.load() > 0);
+        TEST("Concurrent stress: no buffer overwritten while live", corrupt.load() == 0);
+        TEST("Concurrent stress: all memory reclaimed", alloc.freeSpace() == (1 << 16));
+        TEST("Concurrent stress: pool fully coalesced", alloc.blockCount() == 1);
+    }
+
     return failures;
 }
@@ -4,8 +4,12 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <string>
 #include <subcollider/Buffer.h>
+#include <subcollider/BufferAllocator.h>
 #include <subcollider/ugens/BufRd.h>
 
 using namespace subcollider;
@@ -19,6 +23,66 @@ using namespace subcollider::ugens;
         std::cout << "PASS: " << name << std::endl; \
     }
 
+namespace {
+
+/// Advance a ramp phase the way the block API does
+Sample advanceRef(Sample phase, Sample increment, Sample frames, bool loop) {
+    phase += increment;
+    if (loop) {
+        if (phase >= frames) {
+            phase -= frames;
+        } else if (phase < 0.0f) {
+            phase += frames;
+        }
+    }
+    return phase;
+}
+
+/// Compare block output against tick()/tickStereo() on the same phases
+bool blockMatchesTick(BufRd& reader, Interp mode, Sample start, Sample increment, size_t n) {
+    reader.setInterpolation(static_cast<uint8_t>(mode));
+    const Sample frames = static_cast<Sample>(reader.source()->numSamples);
+    Sample mono[256];
+    Sample left[256];
+    Sample right[256];
+    Sample phases[256];
+    const Sample endMono = reader.process(mono, start, increment, n);
+    const Sample endStereo = reader.processStereo(left, right, start, increment, n);
+    Sample phase = start;
+    if (reader.loop) {
+        phase = std::fmod(phase, frames);
+        if (phase < 0.0f) {
+            phase += frames;
+        }
+    }
+    bool ok = true;
+    for (size_t i = 0; i < n; ++i) {
+        phases[i] = phase;
+        const Stereo s = reader.tickStereo(phase);
+        ok = ok && mono[i] == reader.tick(phase) && left[i] == s.left && right[i] == s.right;
+        phase = advanceRef(phase, increment, frames, reader.loop);
+    }
+    ok = ok && endMono == phase && endStereo == phase;
+
+    // Phase buffer form over the same phases
+    reader.process(mono, phases, n);
+    reader.processStereo(left, right, phases, n);
+    for (size_t i = 0; i < n; ++i) {
+        const Stereo s = reader.tickStereo(phases[i]);
+        ok = ok && mono[i] == reader.tick(phases[i]) && left[i] == s.left && right[i] == s.right;
+    }
+    return ok;
+}
+
+/// Copy interleaved frames into a buffer of either channel count
+void fillFrames(Buffer& buf, const Sample* data) {
+    for (size_t i = 0; i < buf.totalFloats(); ++i) {
+        buf.data[i] = data[i];
+    }
+}
+
+} // namespace
+
 int test_bufrd() {
     int failures = 0;
 
@@ -316,5 +380,196 @@ int test_bufrd() {
         TEST("BufRd linear wrap: phase 3.5 interpolates", std::abs(val - 1.5f) < 0.001f);
     }
 
+    // Test block API matches tick() for every mode, channel count and loop setting
+    {
+        Sample mono[97];
+        Sample stereo[97 * 2];
+        for (size_t i = 0; i < 97; ++i) {
+            mono[i] = std::sin(0.37f * static_cast<Sample>(i));
+            stereo[i * 2] = mono[i];
+            stereo[i * 2 + 1] = std::cos(0.53f * static_cast<Sample>(i));
+        }
+        Buffer monoBuf(mono, 1, 48000.0f, 97);
+        Buffer stereoBuf(stereo, 2, 48000.0f, 97);
+        const Interp modes[6] = {Interp::Hold, Interp::Linear, Interp::Cubic,
+                                 Interp::Sinc8, Interp::Sinc16, Interp::Sinc32};
+        const char* names[6] = {"none", "linear", "cubic", "sinc8", "sinc16", "sinc32"};
+        for (int m = 0; m < 6; ++m) {
+            for (int ch = 0; ch < 2; ++ch) {
+                BufRd reader;
+                reader.init(ch == 0 ? &monoBuf : &stereoBuf);
+                const std::string tag = std::string(names[m]) + (ch == 0 ? " mono" : " stereo");
+                reader.setLoop(true);
+                TEST("BufRd block " + tag + ": inside buffer",
+                     blockMatchesTick(reader, modes[m], 10.25f, 0.75f, 64));
+                TEST("BufRd block " + tag + ": crosses loop point",
+                     blockMatchesTick(reader, modes[m], 80.5f, 1.3f, 64));
+                TEST("BufRd block " + tag + ": reverse across start",
+                     blockMatchesTick(reader, modes[m], 20.0f, -0.9f, 64));
+                TEST("BufRd block " + tag + ": start phase outside buffer",
+                     blockMatchesTick(reader, modes[m], -250.5f, 2.5f, 64));
+                TEST("BufRd block " + tag + ": odd length, zero increment",
+                     blockMatchesTick(reader, modes[m], 33.3f, 0.0f, 7));
+                reader.setLoop(false);
+                TEST("BufRd block " + tag + ": clamped past the end",
+                     blockMatchesTick(reader, modes[m], 60.0f, 1.7f, 64));
+                TEST("BufRd block " + tag + ": clamped before the start",
+                     blockMatchesTick(reader, modes[m], 5.0f, -0.4f, 64));
+            }
+        }
+    }
+
+    // Test block API on a missing buffer and phase carry-over
+    {
+        BufRd reader;
+        reader.init();
+        Sample out[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        const Sample next = reader.process<Interp::Linear>(out, 1.0f, 0.5f, 4);
+        TEST("BufRd block no buffer: silence", out[0] == 0.0f && out[3] == 0.0f);
+        TEST("BufRd block no buffer: phase still advances", next == 3.0f);
+
+        Sample data[8] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+        Buffer buf(data, 1, 48000.0f, 8);
+        reader.setBuffer(&buf);
+        Sample phase = 0.0f;
+        for (int block = 0; block < 5; ++block) {
+            phase = reader.process<Interp::Hold>(out, phase, 1.0f, 4);
+        }
+        TEST("BufRd block: phase wraps across blocks", phase == 4.0f && out[0] == 0.0f && out[3] == 3.0f);
+    }
+
+    // Test guarded buffers read exactly like unguarded ones
+    {
+        static BufferAllocator<4096, 8> alloc;
+        alloc.init(48000.0f);
+        Sample plain[61 * 2];
+        for (size_t i = 0; i < 61 * 2; ++i) {
+            plain[i] = std::sin(0.41f * static_cast<Sample>(i));
+        }
+        const Interp modes[6] = {Interp::Hold, Interp::Linear, Interp::Cubic,
+                                 Interp::Sinc8, Interp::Sinc16, Interp::Sinc32};
+        for (uint8_t ch = 1; ch <= 2; ++ch) {
+            Buffer ref(plain, ch, 48000.0f, 61);
+            Buffer guarded = alloc.allocate(61, ch, 16);
+            fillFrames(guarded, plain);
+            for (int loopMode = 0; loopMode < 2; ++loopMode) {
+                const bool loop = loopMode == 0;
+                guarded.updateGuards(loop ? Buffer::GuardMode::Wrap : Buffer::GuardMode::Clamp);
+                BufRd a;
+                BufRd b;
+                a.init(&ref);
+                b.init(&guarded);
+                a.setLoop(loop);
+                b.setLoop(loop);
+                bool same = true;
+                for (int m = 0; m < 6; ++m) {
+                    a.setInterpolation(static_cast<uint8_t>(modes[m]));
+                    b.setInterpolation(static_cast<uint8_t>(modes[m]));
+                    for (Sample p = -3.0f; p < 66.0f; p += 0.37f) {
+                        const Stereo sa = a.tickStereo(p);
+                        const Stereo sb = b.tickStereo(p);
+                        same = same && a.tick(p) == b.tick(p) && sa.left == sb.left && sa.right == sb.right;
+                    }
+                    same = same && blockMatchesTick(b, modes[m], 50.0f, 0.9f, 64) &&
+                           blockMatchesTick(b, modes[m], 3.0f, -0.6f, 64);
+                }
+                TEST(std::string("BufRd guarded ") + (ch == 1 ? "mono " : "stereo ") +
+                     (loop ? "wrap" : "clamp") + ": matches unguarded", same);
+            }
+            alloc.release(guarded);
+        }
+    }
+
+    // Test a tiny negative phase wraps to frame 0, not to numSamples: the
+    // guarded path would read past the trailing guards
+    {
+        const size_t frames = 48000;
+        const size_t guard = 2;
+        static Sample storage[(frames + 2 * guard + 8) * 2];
+        const Interp modes[2] = {Interp::Linear, Interp::Cubic};
+        bool wrapped = true;
+        for (uint8_t ch = 1; ch <= 2; ++ch) {
+            // Whatever lies past the guards poisons any read of it
+            for (Sample& s : storage) {
+                s = std::numeric_limits<Sample>::quiet_NaN();
+            }
+            Buffer buf(storage + guard * ch, ch, 48000.0f, frames, Buffer::NO_BLOCK, guard);
+            for (size_t i = 0; i < frames * ch; ++i) {
+                buf.data[i] = std::sin(0.013f * static_cast<Sample>(i));
+            }
+            buf.updateGuards(Buffer::GuardMode::Wrap);
+            BufRd reader;
+            reader.init(&buf);
+            for (Interp mode : modes) {
+                reader.setInterpolation(static_cast<uint8_t>(mode));
+                const Stereo s = reader.tickStereo(-1e-6f);
+                const Stereo s0 = reader.tickStereo(0.0f);
+                wrapped = wrapped && reader.tick(-1e-6f) == reader.tick(0.0f) &&
+                          s.left == s0.left && s.right == s0.right;
+            }
+        }
+        TEST("BufRd guarded wrap: tiny negative phase reads frame 0", wrapped);
+    }
+
+    // Test clamped cubic reads repeat the first frame before the start
+    {
+        Sample data[4] = {1.0f, 1.0f, 5.0f, 9.0f};
+        Buffer buf(data, 1, 48000.0f, 4);
+        BufRd reader;
+        reader.init(&buf);
+        reader.setLoop(false);
+        reader.setInterpolation(4);
+        // Catmull-Rom through (1, 1, 1, 5) at t = 0.5, not through the last sample
+        TEST("BufRd cubic clamp: edge frame before start", std::abs(reader.tick(0.5f) - 0.75f) < 1e-6f);
+    }
+
+    // Test windowed-sinc reads: exact on frames, accurate between them
+    {
+        const Sample pi = 3.14159265f;
+        Sample data[256];
+        Sample high[256];
+        for (size_t i = 0; i < 256; ++i) {
+            // 10 and 90 cycles per loop: 0.04 and 0.35 of the sample rate
+            data[i] = std::sin(2.0f * pi * 10.0f * static_cast<Sample>(i) / 256.0f);
+            high[i] = std::sin(2.0f * pi * 90.0f * static_cast<Sample>(i) / 256.0f);
+        }
+        Buffer buf(data, 1, 48000.0f, 256);
+        Buffer highBuf(high, 1, 48000.0f, 256);
+        BufRd reader;
+        reader.init(&buf);
+
+        const uint8_t modes[4] = {4, 8, 16, 32};
+        Sample lowError[4];
+        Sample highError[4];
+        bool exact = true;
+        for (int m = 0; m < 4; ++m) {
+            reader.setInterpolation(modes[m]);
+            lowError[m] = 0.0f;
+            highError[m] = 0.0f;
+            for (Sample p = 0.0f; p < 256.0f; p += 0.37f) {
+                const Sample expected = std::sin(2.0f * pi * 10.0f * p / 256.0f);
+                lowError[m] = std::max(lowError[m], std::abs(reader.tick(p) - expected));
+            }
+            for (size_t i = 0; i < 256; i += 17) {
+                exact = exact && reader.tick(static_cast<Sample>(i)) == data[i];
+            }
+            reader.setBuffer(&highBuf);
+            for (Sample p = 0.0f; p < 256.0f; p += 0.37f) {
+                const Sample expected = std::sin(2.0f * pi * 90.0f * p / 256.0f);
+                highError[m] = std::max(highError[m], std::abs(reader.tick(p) - expected));
+            }
+            reader.setBuffer(&buf);
+        }
+        std::cout << "  sinc error, low/high tone: cubic " << lowError[0] << "/" << highError[0]
+                  << ", sinc8 " << lowError[1] << "/" << highError[1]
+                  << ", sinc16 " << lowError[2] << "/" << highError[2]
+                  << ", sinc32 " << lowError[3] << "/" << highError[3] << std::endl;
+        TEST("BufRd sinc: integer phases return the frame", exact);
+        TEST("BufRd sinc: low tone beats cubic", lowError[1] < lowError[0] && lowError[3] < 1e-3f);
+        TEST("BufRd sinc: high tone error falls with taps",
+             highError[1] < highError[0] && highError[2] < highError[1] && highError[3] < highError[2]);
+        TEST("BufRd sinc32: high tone accurate", highError[3] < 0.01f);
+    }
+
     return failures;
 }
@@ -0,0 +1,160 @@
+/**
+ * @file test_controlqueue.cpp
+ * @brief Unit tests for MpscRing, ControlQueue and AudioLoop control draining
+ */
+
+#include <iostream>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <subcollider/MpscRing.h>
+#include <subcollider/ControlQueue.h>
+#include <subcollider/AudioLoop.h>
+
+using namespace subcollider;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+int test_controlqueue() {
+    int failures = 0;
+
+    // Test FIFO order and empty ring
+    {
+        MpscRing<int, 8> ring;
+        int value = -1;
+        TEST("MpscRing: starts empty", ring.empty() && !ring.tryPop(value));
+
+        ring.tryPush(1);
+        ring.tryPush(2);
+        ring.tryPush(3);
+        bool inOrder = ring.tryPop(value) && value == 1;
+        inOrder = inOrder && ring.tryPop(value) && value == 2;
+        inOrder = inOrder && ring.tryPop(value) && value == 3;
+        TEST("MpscRing: pops in push order", inOrder);
+        TEST("MpscRing: empty after draining", ring.empty());
+    }
+
+    // Test full ring rejects and counts drops
+    {
+        MpscRing<int, 4> ring;
+        bool accepted = true;
+        for (int i = 0; i < 4; ++i) {
+            accepted = accepted && ring.tryPush(i);
+        }
+        TEST("MpscRing full: capacity accepted", accepted);
+        TEST("MpscRing full: extra push rejected", !ring.tryPush(99));
+        TEST("MpscRing full: drop counted", ring.droppedCount() == 1);
+
+        int value = 0;
+        ring.tryPop(value);
+        TEST("MpscRing full: slot reusable after pop", ring.tryPush(4));
+    }
+
+    // Test wrap-around over many laps
+    {
+        MpscRing<uint32_t, 4> ring;
+        bool ok = true;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            ok = ok && ring.tryPush(i);
+            uint32_t out = 0;
+            ok = ok && ring.tryPop(out) && out == i;
+        }
+        TEST("MpscRing: wraps around correctly", ok);
+    }
+
+    // Test concurrent producers
+    {
+        constexpr uint32_t PRODUCERS = 4;
+        constexpr uint32_t PER_PRODUCER = 20000;
+        static ControlQueue<256> queue;
+        queue.clear();
+
+        std::vector<std::thread> producers;
+        for (uint32_t p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([p]() {
+                for (uint32_t i = 0; i < PER_PRODUCER; ++i) {
+                    while (!queue.push(p, i, static_cast<Sample>(i))) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        uint32_t next[PRODUCERS] = {};
+        uint32_t received = 0;
+        bool ordered = true;
+        while (received < PRODUCERS * PER_PRODUCER) {
+            received += static_cast<uint32_t>(queue.drain([&](const ControlMessage& msg) {
+                if (msg.target >= PRODUCERS || msg.param != next[msg.target] ||
+                    msg.value != static_cast<Sample>(msg.param)) {
+                    ordered = false;
+                } else {
+                    ++next[msg.target];
+                }
+            }));
+        }
+        for (auto& t : producers) {
+            t.join();
+        }
+
+        TEST("ControlQueue concurrent: all messages received", received == PRODUCERS * PER_PRODUCER);
+        TEST("ControlQueue concurrent: per-producer order kept", ordered);
+        TEST("ControlQueue concurrent: nothing left", queue.empty());
+    }
+
+    // Test message fields and drain limit
+    {
+        ControlQueue<16> queue;
+        queue.push(3, 7, 0.5f, 12);
+        queue.push(ControlMessage{4, 8, 0.25f, 0});
+        queue.push(5, 9, 1.0f);
+
+        ControlMessage first{};
+        size_t handled = queue.drain([&](const ControlMessage& msg) { first = msg; }, 1);
+        TEST("ControlQueue drain: limit respected", handled == 1);
+        TEST("ControlQueue drain: fields preserved",
+             first.target == 3 && first.param == 7 && first.value == 0.5f && first.offset == 12);
+        TEST("ControlQueue drain: rest handled later",
+             queue.drain([](const ControlMessage&) {}) == 2);
+    }
+
+    // Test AudioLoop drains the attached queue once per block
+    {
+        struct Params {
+            Sample cutoff;
+            uint32_t calls;
+        };
+        static ControlQueue<64> queue;
+        queue.clear();
+        Params params{0.0f, 0};
+
+        AudioLoop<64> loop;
+        loop.init(48000.0f);
+        TEST("AudioLoop control: no queue is a no-op", loop.processControl() == 0);
+
+        loop.setControlQueue(&queue, [](const ControlMessage& msg, void* data) {
+            auto* p = static_cast<Params*>(data);
+            if (msg.param == 1) {
+                p->cutoff = msg.value;
+            }
+            ++p->calls;
+        }, &params);
+
+        queue.push(0, 1, 800.0f);
+        queue.push(0, 1, 1200.0f);
+        queue.push(0, 2, 0.3f);
+
+        TEST("AudioLoop control: messages delivered", loop.processControl() == 3);
+        TEST("AudioLoop control: handler saw all", params.calls == 3);
+        TEST("AudioLoop control: last value wins", params.cutoff == 1200.0f);
+        TEST("AudioLoop control: queue drained", loop.processControl() == 0);
+    }
+
+    return failures;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test_diskin.cpp
+ * @brief Unit tests for DiskIn and DiskStreamer
+ */
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <subcollider/BufferAllocator.h>
+#include <subcollider/DiskStreamer.h>
+#include <subcollider/ugens/DiskIn.h>
+
+using namespace subcollider;
+using namespace subcollider::ugens;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+int test_diskin() {
+    int failures = 0;
+
+#if defined(SUBCOLLIDER_HAS_MMAP)
+    WavFile wav;
+    wav.open("data/amen_16_48000.wav");
+    TEST("DiskIn: test file opens", wav.isOpen());
+    if (!wav.isOpen()) {
+        // Every check below reads the file (run from the source root)
+        return failures;
+    }
+
+    // Reference: the whole file converted in memory
+    static BufferAllocator<1 << 20, 4> allocator;
+    allocator.init(48000.0f);
+    const Buffer reference = wav.load(allocator);
+    const size_t frames = reference.numSamples;
+
+    // Test the prefilled ring plays the start of the file
+    {
+        static DiskIn<1024> disk;
+        disk.open(&wav);
+        TEST("DiskIn: open prefills the ring", disk.buffered() == 1024);
+        TEST("DiskIn: stereo file streams stereo", disk.channels == 2);
+
+        Sample left[64];
+        Sample right[64];
+        disk.processStereo(left, right, 64);
+        bool match = true;
+        for (size_t i = 0; i < 64; ++i) {
+            match = match && left[i] == reference.data[i * 2] && right[i] == reference.data[i * 2 + 1];
+        }
+        TEST("DiskIn: block matches file", match);
+
+        const Sample mono = disk.tick();
+        const Stereo frame = disk.tickStereo();
+        TEST("DiskIn: tick returns left channel", mono == reference.data[64 * 2]);
+        TEST("DiskIn: tickStereo returns next frame",
+             frame.left == reference.data[65 * 2] && frame.right == reference.data[65 * 2 + 1]);
+        TEST("DiskIn: no underruns while buffered", disk.underrunCount() == 0);
+    }
+
+    // Test an empty ring reports underruns and recovers after refill
+    {
+        static DiskIn<256> disk;
+        disk.open(&wav);
+        Sample out[64];
+        for (int i = 0; i < 4; ++i) {
+            disk.process(out, 64);
+        }
+        disk.process(out, 64);
+        TEST("DiskIn underrun: missing frames counted", disk.underrunCount() == 64);
+        TEST("DiskIn underrun: output is silence", out[0] == 0.0f && out[63] == 0.0f);
+
+        TEST("DiskIn underrun: refill tops up", disk.refill() == 256);
+        disk.process(out, 64);
+        TEST("DiskIn underrun: resumes where it stopped", out[0] == reference.data[256 * 2]);
+        TEST("DiskIn underrun: count unchanged after refill", disk.underrunCount() == 64);
+    }
+
+    // Test the background thread streams the whole file without underruns
+    {
+        static DiskIn<4096> disk;
+        DiskStreamer<4> streamer;
+        disk.open(&wav);
+        streamer.start(std::chrono::microseconds(200));
+        TEST("DiskStreamer: stream added", streamer.add(disk));
+
+        std::vector<Sample> left(frames + 64);
+        std::vector<Sample> right(frames + 64);
+        size_t played = 0;
+        while (!disk.isDone()) {
+            if (disk.buffered() < 64 && played + disk.buffered() < frames) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            disk.processStereo(left.data() + played, right.data() + played, 64);
+            played += 64;
+        }
+        TEST("DiskStreamer: stream removed", streamer.remove(disk));
+        streamer.stop();
+
+        bool match = played >= frames;
+        for (size_t i = 0; match && i < frames; ++i) {
+            match = left[i] == reference.data[i * 2] && right[i] == reference.data[i * 2 + 1];
+        }
+        TEST("DiskStreamer: whole file streamed in order", match);
+        TEST("DiskStreamer: no underruns", disk.underrunCount() == 0);
+        TEST("DiskStreamer: tail after end is silence", left[frames] == 0.0f || played == frames);
+    }
+
+    // Test looping wraps to the start of the file and start offset is honoured
+    {
+        static DiskIn<256> disk;
+        disk.open(&wav, true, frames - 10);
+        Sample out[20];
+        disk.process(out, 20);
+        TEST("DiskIn loop: plays from start frame", out[0] == reference.data[(frames - 10) * 2]);
+        TEST("DiskIn loop: wraps to file start", out[10] == reference.data[0] && out[19] == reference.data[9 * 2]);
+        TEST("DiskIn loop: never done", !disk.isDone());
+    }
+#endif
+
+    return failures;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file test_eventscheduler.cpp
+ * @brief Unit tests for EventScheduler
+ */
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <subcollider/EventScheduler.h>
+#include <subcollider/ControlQueue.h>
+#include <subcollider/ExampleVoice.h>
+
+using namespace subcollider;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+struct Span {
+    size_t offset;
+    size_t count;
+};
+
+} // namespace
+
+int test_eventscheduler() {
+    int failures = 0;
+
+    // Test block without events renders in one call
+    {
+        EventScheduler<16> events;
+        events.init();
+        std::vector<Span> spans;
+        events.process(64, [](const ControlMessage&) {},
+                       [&](size_t offset, size_t count) { spans.push_back({offset, count}); });
+        TEST("EventScheduler no events: single span", spans.size() == 1);
+        TEST("EventScheduler no events: full block", spans[0].offset == 0 && spans[0].count == 64);
+        TEST("EventScheduler no events: clock advances", events.now() == 64);
+    }
+
+    // Test block is split at event offsets
+    {
+        EventScheduler<16> events;
+        events.init();
+        events.scheduleIn(40, 0, 2, 2.0f);
+        events.scheduleIn(10, 0, 1, 1.0f);
+        events.scheduleIn(40, 0, 3, 3.0f);
+
+        std::vector<Span> spans;
+        std::vector<ControlMessage> applied;
+        events.process(64,
+                       [&](const ControlMessage& msg) { applied.push_back(msg); },
+                       [&](size_t offset, size_t count) { spans.push_back({offset, count}); });
+
+        TEST("EventScheduler split: three spans", spans.size() == 3);
+        TEST("EventScheduler split: spans contiguous",
+             spans[0].offset == 0 && spans[0].count == 10 &&
+             spans[1].offset == 10 && spans[1].count == 30 &&
+             spans[2].offset == 40 && spans[2].count == 24);
+        TEST("EventScheduler split: events applied in time order",
+             applied.size() == 3 && applied[0].param == 1 && applied[1].param == 2 &&
+             applied[2].param == 3);
+        TEST("EventScheduler split: offsets reported",
+             applied[0].offset == 10 && applied[1].offset == 40 && applied[2].offset == 40);
+        TEST("EventScheduler split: queue empty", events.pending() == 0);
+    }
+
+    // Test events in later blocks and late events
+    {
+        EventScheduler<16> events;
+        events.init();
+        events.schedule(100, 0, 1, 1.0f);
+
+        size_t appliedAt = 999;
+        size_t calls = 0;
+        auto apply = [&](const ControlMessage& msg) { appliedAt = msg.offset; ++calls; };
+        auto render = [](size_t, size_t) {};
+
+        events.process(64, apply, render);
+        TEST("EventScheduler future: not applied early", calls == 0 && events.pending() == 1);
+        events.process(64, apply, render);
+        TEST("EventScheduler future: applied in its block", calls == 1 && appliedAt == 36);
+
+        events.schedule(5, 0, 1, 1.0f);  // already in the past
+        events.process(64, apply, render);
+        TEST("EventScheduler late: applied at block start", calls == 2 && appliedAt == 0);
+    }
+
+    // Test capacity limit
+    {
+        EventScheduler<2> events;
+        events.init();
+        events.scheduleIn(1, 0, 0, 0.0f);
+        events.scheduleIn(2, 0, 0, 0.0f);
+        TEST("EventScheduler full: rejects", !events.scheduleIn(3, 0, 0, 0.0f));
+        TEST("EventScheduler full: drop counted", events.droppedCount() == 1);
+    }
+
+    // Test pulling offsets from a ControlQueue
+    {
+        ControlQueue<16> queue;
+        EventScheduler<16> events;
+        events.init();
+        events.process(128, [](const ControlMessage&) {}, [](size_t, size_t) {});
+
+        queue.push(7, 1, 0.5f, 20);
+        TEST("EventScheduler pull: takes message", events.pull(queue) == 1);
+        uint32_t offset = 0;
+        uint32_t target = 0;
+        events.process(64,
+                       [&](const ControlMessage& msg) { offset = msg.offset; target = msg.target; },
+                       [](size_t, size_t) {});
+        TEST("EventScheduler pull: offset relative to next block", offset == 20 && target == 7);
+    }
+
+    // Test a trigger lands on its exact sample
+    {
+        ExampleVoice reference;
+        ExampleVoice scheduled;
+        reference.init(48000.0f);
+        scheduled.init(48000.0f);
+        reference.setAttack(0.001f);
+        scheduled.setAttack(0.001f);
+
+        Sample refL[64], refR[64];
+        reference.process(refL, refR, 17);
+        reference.trigger();
+        reference.process(refL + 17, refR + 17, 47);
+
+        EventScheduler<16> events;
+        events.init();
+        events.scheduleIn(17, 0, 0, 1.0f);
+
+        Sample outL[64], outR[64];
+        events.process(64,
+                       [&](const ControlMessage&) { scheduled.trigger(); },
+                       [&](size_t offset, size_t count) {
+                           scheduled.process(outL + offset, outR + offset, count);
+                       });
+
+        bool silentBefore = true;
+        for (size_t i = 0; i < 17; ++i) {
+            if (outL[i] != 0.0f || outR[i] != 0.0f) {
+                silentBefore = false;
+            }
+        }
+        bool matches = true;
+        for (size_t i = 0; i < 64; ++i) {
+            if (outL[i] != refL[i] || outR[i] != refR[i]) {
+                matches = false;
+            }
+        }
+        TEST("EventScheduler trigger: silent before offset", silentBefore);
+        TEST("EventScheduler trigger: sound after offset", outL[20] != 0.0f || outR[20] != 0.0f);
+        TEST("EventScheduler trigger: matches manual split", matches);
+    }
+
+    return failures;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file test_graincloud.cpp
+ * @brief Unit tests for GrainCloud
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <subcollider/Buffer.h>
+#include <subcollider/ugens/GrainCloud.h>
+
+using namespace subcollider;
+using namespace subcollider::ugens;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+int test_graincloud() {
+    int failures = 0;
+    const Sample sr = 48000.0f;
+
+    const Sample pi = 3.14159265f;
+    Sample ones[1000];
+    Sample ramp[1000];
+    Sample mono[1000];
+    Sample stereo[1000 * 2];
+    for (size_t i = 0; i < 1000; ++i) {
+        // Tones periodic in the buffer, so wrapped reads stay smooth
+        const Sample x = 2.0f * pi * static_cast<Sample>(i) / 1000.0f;
+        ones[i] = 1.0f;
+        ramp[i] = static_cast<Sample>(i);
+        mono[i] = std::sin(9.0f * x);
+        stereo[i * 2] = std::sin(5.0f * x);
+        stereo[i * 2 + 1] = std::cos(7.0f * x);
+    }
+    Buffer onesBuf(ones, 1, sr, 1000);
+    Buffer rampBuf(ramp, 1, sr, 1000);
+    Buffer monoBuf(mono, 1, sr, 1000);
+    Buffer stereoBuf(stereo, 2, sr, 1000);
+
+    // Test silence without a buffer
+    {
+        GrainCloud<16> cloud;
+        cloud.init(sr);
+        cloud.setDensity(1000.0f);
+        Sample left[64];
+        Sample right[64];
+        cloud.process(left, right, 64);
+        TEST("GrainCloud no buffer: silence", left[0] == 0.0f && right[63] == 0.0f);
+        TEST("GrainCloud no buffer: no grains", cloud.activeGrains() == 0 &&
+             !cloud.spawn(0.0f, 1.0f, 0.01f, 0.0f));
+    }
+
+    // Test one grain: Hann window, equal-power pan, exact length
+    {
+        GrainCloud<16> cloud;
+        cloud.init(sr);
+        cloud.setBuffer(&onesBuf);
+        TEST("GrainCloud spawn: accepted", cloud.spawn(0.5f, 1.0f, 200.0f / sr, 0.0f));
+
+        Sample left[256];
+        Sample right[256];
+        cloud.process(left, right, 256);
+        const Sample centre = 0.70710678f;
+        TEST("GrainCloud grain: starts at zero", left[0] == 0.0f);
+        TEST("GrainCloud grain: peaks mid-grain", std::abs(left[100] - centre) < 1e-4f);
+        TEST("GrainCloud grain: centre pan is equal power", std::abs(left[50] - right[50]) < 1e-6f);
+        TEST("GrainCloud grain: window shape",
+             std::abs(left[50] - centre * 0.5f) < 1e-3f);
+        TEST("GrainCloud grain: ends after its duration",
+             left[199] < 1e-3f && left[200] == 0.0f && cloud.activeGrains() == 0);
+    }
+
+    // Test read position and rate
+    {
+        GrainCloud<16> cloud;
+        cloud.init(sr);
+        cloud.setBuffer(&rampBuf);
+        cloud.spawn(0.25f, 2.0f, 100.0f / sr, -1.0f);
+        Sample left[100];
+        Sample right[100];
+        cloud.process(left, right, 100);
+        // Frame 50 reads buffer frame 250 + 2 * 50 under a window of 1
+        TEST("GrainCloud read: position and rate", std::abs(left[50] - 350.0f) < 0.05f);
+        TEST("GrainCloud read: hard left pan", right[50] < 1e-4f);
+    }
+
+    // Test grains wrap around the buffer end
+    {
+        GrainCloud<16> cloud;
+        cloud.init(sr);
+        cloud.setBuffer(&rampBuf);
+        cloud.spawn(0.99f, 1.0f, 40.0f / sr, -1.0f);
+        Sample left[40];
+        Sample right[40];
+        cloud.process(left, right, 40);
+        // Frame 20 reads buffer frame 990 + 20 = 1010, wrapped to 10
+        TEST("GrainCloud wrap: reads past the end from the start", std::abs(left[20] - 10.0f) < 0.05f);
+    }
+
+    // Test scheduler density and pool capacity
+    {
+        GrainCloud<64> cloud;
+        cloud.init(sr);
+        cloud.setBuffer(&onesBuf);
+        cloud.setDensity(1000.0f);   // One grain every 48 samples
+        cloud.setDuration(0.01f);    // 480 samples: ten overlap
+        Sample left[64];
+        Sample right[64];
+        for (int block = 0; block < 75; ++block) {
+            cloud.process(left, right, 64);
+        }
+        TEST("GrainCloud scheduler: overlap sums to about density * duration * 0.5",
+             std::abs(left[10] - 10.0f * 0.5f * 0.70710678f) < 0.05f);
+        // After 4810 samples the grains started at 4368..4800 are sounding
+        cloud.process(left, right, 10);
+        TEST("GrainCloud scheduler: steady overlap", cloud.activeGrains() == 10);
+
+        GrainCloud<4> small;
+        small.init(sr);
+        small.setBuffer(&onesBuf);
+        bool accepted = true;
+        for (int i = 0; i < 4; ++i) {
+            accepted = accepted && small.spawn(0.0f, 1.0f, 0.01f, 0.0f);
+        }
+        TEST("GrainCloud pool: full pool drops", accepted &&
+             !small.spawn(0.0f, 1.0f, 0.01f, 0.0f) && small.dropped == 1);
+    }
+
+    // Test process matches tick, mono and stereo buffers, with jitter
+    {
+        const Buffer* buffers[2] = {&monoBuf, &stereoBuf};
+        for (int b = 0; b < 2; ++b) {
+            GrainCloud<32> blocked;
+            GrainCloud<32> ticked;
+            GrainCloud<32>* clouds[2] = {&blocked, &ticked};
+            for (GrainCloud<32>* c : clouds) {
+                c->init(sr, 777);
+                c->setBuffer(buffers[b]);
+                c->setDensity(2000.0f);
+                c->setDuration(0.004f);
+                c->setPosition(0.5f, 0.5f);
+                c->setRate(1.0f, 0.5f);
+                c->setPan(0.0f, 1.0f);
+                c->spawn(0.1f, -1.5f, 0.003f, 0.3f, 1.0f, 70);
+            }
+            Sample left[512];
+            Sample right[512];
+            blocked.process(left, right, 200);
+            blocked.process(left + 200, right + 200, 312);
+            // Positions advance per pair in one and per frame in the other,
+            // and grains finish at different points of the mix order
+            Sample error = 0.0f;
+            for (size_t i = 0; i < 512; ++i) {
+                const Stereo s = ticked.tick();
+                error = std::max(error, std::max(std::abs(s.left - left[i]), std::abs(s.right - right[i])));
+            }
+            TEST(std::string("GrainCloud ") + (b == 0 ? "mono" : "stereo") + ": process matches tick",
+                 error < 1e-3f && blocked.activeGrains() == ticked.activeGrains());
+        }
+    }
+
+    return failures;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file test_ladderbank.cpp
+ * @brief Unit tests for LadderBank
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <subcollider/ugens/LadderBank.h>
+
+using namespace subcollider;
+using namespace subcollider::ugens;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+constexpr size_t TEST_SAMPLES = 2000;
+
+/// Test signal for a lane: a naive saw at a lane-specific pitch
+Sample laneInput(size_t lane, size_t i) {
+    const Sample period = 37.0f + 23.0f * static_cast<Sample>(lane);
+    const Sample phase = std::fmod(static_cast<Sample>(i), period) / period;
+    return 0.8f * (2.0f * phase - 1.0f);
+}
+
+/**
+ * Largest difference between each bank lane and a scalar model with the
+ * same settings, over TEST_SAMPLES samples of per-lane input, and the
+ * largest scalar output (so a silent filter cannot pass).
+ */
+template<typename Model, size_t Lanes>
+void compareWithScalar(Sample resonance, Sample& error, Sample& peak) {
+    LadderBank<Model, Lanes> bank;
+    Model scalar[Lanes];
+    bank.init(48000.0f);
+    for (size_t k = 0; k < Lanes; ++k) {
+        const Sample cutoff = 300.0f * static_cast<Sample>(k + 1);
+        const Sample r = resonance * static_cast<Sample>(k + 1) / static_cast<Sample>(Lanes);
+        bank.setCutoff(k, cutoff);
+        bank.setResonance(k, r);
+        scalar[k].init(48000.0f);
+        scalar[k].setCutoff(cutoff);
+        scalar[k].setResonance(r);
+    }
+
+    error = 0.0f;
+    peak = 0.0f;
+    Sample in[Lanes];
+    Sample out[Lanes];
+    for (size_t i = 0; i < TEST_SAMPLES; ++i) {
+        for (size_t k = 0; k < Lanes; ++k) {
+            in[k] = laneInput(k, i);
+        }
+        bank.tick(in, out);
+        for (size_t k = 0; k < Lanes; ++k) {
+            const Sample expected = scalar[k].tick(in[k]);
+            error = std::max(error, std::abs(out[k] - expected));
+            peak = std::max(peak, std::abs(expected));
+        }
+    }
+}
+
+template<typename Model>
+int testModel(const std::string& name, Sample tolerance) {
+    int failures = 0;
+    Sample error4;
+    Sample peak4;
+    Sample error8;
+    Sample peak8;
+    compareWithScalar<Model, 4>(0.6f, error4, peak4);
+    compareWithScalar<Model, 8>(0.6f, error8, peak8);
+    TEST("LadderBank<" + name + ", 4>: lanes track scalar filters",
+         error4 < tolerance * peak4 && peak4 > 0.05f);
+    TEST("LadderBank<" + name + ", 8>: lanes track scalar filters",
+         error8 < tolerance * peak8 && peak8 > 0.05f);
+    return failures;
+}
+
+} // namespace
+
+int test_ladderbank() {
+    int failures = 0;
+
+    // Float lanes against the double scalar models (tanhApprox where the
+    // models call std::tanh), per-lane cutoff and resonance
+    failures += testModel<StilsonMoogLadder>("Stilson", 1e-3f);
+    failures += testModel<MicrotrackerMoogLadder>("Microtracker", 1e-3f);
+    failures += testModel<KrajeskiMoogLadder>("Krajeski", 1e-3f);
+    failures += testModel<MusicDSPMoogLadder>("MusicDSP", 1e-3f);
+    failures += testModel<OberheimMoogLadder>("Oberheim", 1e-3f);
+    failures += testModel<ImprovedMoogLadder>("Improved", 1e-3f);
+    failures += testModel<RKSimulationMoogLadder>("RKSimulation", 1e-3f);
+
+    // Test the vector tanh matches the scalar one lane for lane
+    {
+        alignas(16) Sample x[4] = {-6.0f, -0.7f, 0.01f, 2.3f};
+        alignas(16) Sample y[4];
+        simd::storeLanes(simd::tanhApprox(simd::loadLanes(x)), y);
+        bool same = true;
+        for (int k = 0; k < 4; ++k) {
+            same = same && y[k] == tanhApprox(x[k]);
+        }
+        TEST("LadderBank tanhApprox: vector lanes match scalar", same);
+    }
+
+    // Test parameters are stored per lane, clamped as the model clamps them
+    {
+        LadderBank<ImprovedMoogLadder, 4> bank;
+        bank.init(48000.0f);
+        TEST("LadderBank init: model defaults",
+             bank.cutoff[3] == 1000.0f && std::abs(bank.resonance[0] - 0.1f) < 1e-6f);
+        bank.setCutoff(1, 2000.0f);
+        bank.setResonance(2, 1.5f);
+        bank.setCutoff(3, 30000.0f);
+        TEST("LadderBank setters: one lane at a time",
+             bank.cutoff[0] == 1000.0f && bank.cutoff[1] == 2000.0f && bank.resonance[2] == 1.0f);
+        TEST("LadderBank setters: model clamping applies", bank.cutoff[3] < 15500.0f);
+    }
+
+    // Test planar process matches tick, in place and out of place
+    {
+        LadderBank<KrajeskiMoogLadder, 8> ticked;
+        LadderBank<KrajeskiMoogLadder, 8> blocked;
+        LadderBank<KrajeskiMoogLadder, 8> inPlace;
+        LadderBank<KrajeskiMoogLadder, 8>* banks[3] = {&ticked, &blocked, &inPlace};
+        for (LadderBank<KrajeskiMoogLadder, 8>* b : banks) {
+            b->init(48000.0f);
+            for (size_t k = 0; k < 8; ++k) {
+                b->setParameters(k, 200.0f + 400.0f * static_cast<Sample>(k), 0.1f * static_cast<Sample>(k));
+            }
+        }
+
+        Sample in[8][256];
+        Sample out[8][256];
+        Sample work[8][256];
+        const Sample* inputs[8];
+        Sample* outputs[8];
+        Sample* channels[8];
+        for (size_t k = 0; k < 8; ++k) {
+            for (size_t i = 0; i < 256; ++i) {
+                in[k][i] = laneInput(k, i);
+                work[k][i] = in[k][i];
+            }
+            inputs[k] = in[k];
+            outputs[k] = out[k];
+            channels[k] = work[k];
+        }
+        blocked.process(inputs, outputs, 256);
+        inPlace.process(channels, 256);
+
+        bool same = true;
+        Sample frameIn[8];
+        Sample frameOut[8];
+        for (size_t i = 0; i < 256; ++i) {
+            for (size_t k = 0; k < 8; ++k) {
+                frameIn[k] = in[k][i];
+            }
+            ticked.tick(frameIn, frameOut);
+            for (size_t k = 0; k < 8; ++k) {
+                same = same && frameOut[k] == out[k][i] && frameOut[k] == work[k][i];
+            }
+        }
+        TEST("LadderBank process: planar block matches tick", same);
+
+        blocked.reset();
+        Sample silence[8] = {};
+        Sample after[8];
+        blocked.tick(silence, after);
+        TEST("LadderBank reset: state cleared", std::abs(after[5]) < 1e-6f);
+    }
+
+    return failures;
+}
@@ -33,6 +33,11 @@ int test_buffer();
 int test_bufferallocator();
 int test_bufrd();
 int test_bufrd_phasor();
+int test_playbuf();
+int test_playhead();
+int test_mippyramid();
+int test_graincloud();
+int test_ladderbank();
 int test_playback_oversampling();
 int test_fverb();
 int test_combc();
@@ -41,6 +46,14 @@ int test_onepolelpf();
 int test_dcblock();
 int test_laglinear();
 int test_linlin();
+int test_voicepool();
+int test_workerpool();
+int test_controlqueue();
+int test_eventscheduler();
+int test_multibuffer();
+int test_relocatablebufferallocator();
+int test_wavfile();
+int test_diskin();
 
 int main() {
     int failures = 0;
@@ -119,6 +132,21 @@ int main() {
     std::cout << "--- BufRd + Phasor Tests ---" << std::endl;
     failures += test_bufrd_phasor();
 
+    std::cout << "--- PlayBuf Tests ---" << std::endl;
+    failures += test_playbuf();
+
+    std::cout << "--- Playhead Tests ---" << std::endl;
+    failures += test_playhead();
+
+    std::cout << "--- MipPyramid Tests ---" << std::endl;
+    failures += test_mippyramid();
+
+    std::cout << "--- GrainCloud Tests ---" << std::endl;
+    failures += test_graincloud();
+
+    std::cout << "--- LadderBank Tests ---" << std::endl;
+    failures += test_ladderbank();
+
     std::cout << "--- Playback Oversampling Tests ---" << std::endl;
     failures += test_playback_oversampling();
 
@@ -143,6 +171,30 @@ int main() {
     std::cout << "--- LinLin Tests ---" << std::endl;
     failures += test_linlin();
 
+    std::cout << "--- VoicePool Tests ---" << std::endl;
+    failures += test_voicepool();
+
+    std::cout << "--- WorkerPool Tests ---" << std::endl;
+    failures += test_workerpool();
+
+    std::cout << "--- ControlQueue Tests ---" << std::endl;
+    failures += test_controlqueue();
+
+    std::cout << "--- EventScheduler Tests ---" << std::endl;
+    failures += test_eventscheduler();
+
+    std::cout << "--- MultiBuffer Tests ---" << std::endl;
+    failures += test_multibuffer();
+
+    std::cout << "--- RelocatableBufferAllocator Tests ---" << std::endl;
+    failures += test_relocatablebufferallocator();
+
+    std::cout << "--- WavFile Tests ---" << std::endl;
+    failures += test_wavfile();
+
+    std::cout << "--- DiskIn Tests ---" << std::endl;
+    failures += test_diskin();
+
     std::cout << std::endl;
     if (failures == 0) {
         std::cout << "All tests passed!" << std::endl;
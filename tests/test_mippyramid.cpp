@@ -0,0 +1,220 @@
+/**
+ * @file test_mippyramid.cpp
+ * @brief Unit tests for MipPyramid and mipmapped BufRd reads
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <subcollider/BufferAllocator.h>
+#include <subcollider/MipPyramid.h>
+#include <subcollider/ugens/BufRd.h>
+
+using namespace subcollider;
+using namespace subcollider::ugens;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+using MipAllocator = BufferAllocator<1 << 16, 32>;
+
+/// RMS of a BufRd stepping through a buffer at a fixed rate
+Sample rmsAtRate(BufRd& reader, Sample rate, size_t n) {
+    Sample phase = 0.0f;
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const Sample s = reader.tick(phase);
+        sum += static_cast<double>(s) * s;
+        phase += rate;
+    }
+    return static_cast<Sample>(std::sqrt(sum / static_cast<double>(n)));
+}
+
+} // namespace
+
+int test_mippyramid() {
+    int failures = 0;
+    const Sample pi = 3.14159265f;
+
+    static MipAllocator allocator;
+    allocator.init(48000.0f);
+
+    // Test level layout and linking
+    {
+        const size_t usedBefore = allocator.usedSpace();
+        Buffer buf = allocator.allocate(1024, 2, 2);
+        for (size_t i = 0; i < 1024 * 2; ++i) {
+            buf.data[i] = 0.5f;
+        }
+        buf.updateGuards(Buffer::GuardMode::Wrap);
+
+        MipPyramid<> mips;
+        TEST("MipPyramid build: six levels down to 16 frames", mips.build(allocator, buf) == 6);
+        TEST("MipPyramid build: halves length",
+             mips.level(0).numSamples == 512 && mips.level(5).numSamples == 16);
+        TEST("MipPyramid build: halves sample rate", mips.level(1).sampleRate == 12000.0f);
+        TEST("MipPyramid build: linked through Buffer::mip",
+             buf.mip == &mips.level(0) && mips.level(0).mip == &mips.level(1) &&
+             mips.level(5).mip == nullptr);
+        TEST("MipPyramid build: keeps guard mode",
+             mips.level(2).hasGuards(Buffer::GuardMode::Wrap, 2));
+
+        bool dc = true;
+        const Buffer& level = mips.level(2);
+        for (size_t i = 0; i < level.numSamples * 2; ++i) {
+            dc = dc && std::abs(level.data[i] - 0.5f) < 1e-5f;
+        }
+        TEST("MipPyramid filter: DC passes", dc);
+
+        mips.release(allocator, buf);
+        TEST("MipPyramid release: unlinks", buf.mip == nullptr && mips.size() == 0);
+        allocator.release(buf);
+        TEST("MipPyramid release: frees the levels", allocator.usedSpace() == usedBefore);
+    }
+
+    // Test the half-band filter keeps low tones and removes Nyquist
+    {
+        Buffer low = allocator.allocate(512, 1);
+        Buffer nyquist = allocator.allocate(512, 1);
+        for (size_t i = 0; i < 512; ++i) {
+            low.data[i] = std::sin(2.0f * pi * static_cast<Sample>(i) / 64.0f);
+            nyquist.data[i] = (i & 1) ? -1.0f : 1.0f;
+        }
+        MipPyramid<1> lowMips;
+        MipPyramid<1> nyquistMips;
+        lowMips.build(allocator, low);
+        nyquistMips.build(allocator, nyquist);
+
+        Sample lowError = 0.0f;
+        Sample nyquistPeak = 0.0f;
+        for (size_t j = 0; j < 256; ++j) {
+            lowError = std::max(lowError, std::abs(lowMips.level(0).data[j] - low.data[j * 2]));
+            nyquistPeak = std::max(nyquistPeak, std::abs(nyquistMips.level(0).data[j]));
+        }
+        TEST("MipPyramid filter: low tone passes, aligned", lowError < 1e-3f);
+        TEST("MipPyramid filter: Nyquist removed", nyquistPeak < 1e-2f);
+
+        lowMips.release(allocator, low);
+        nyquistMips.release(allocator, nyquist);
+        allocator.release(low);
+        allocator.release(nyquist);
+    }
+
+    // Test odd-length levels loop where the source does
+    {
+        // 501 frames: levels of 251, 126 and 63 frames, none a whole halving
+        const size_t n = 501;
+        Buffer buf = allocator.allocate(n, 1, 4);
+        for (size_t i = 0; i < n; ++i) {
+            buf.data[i] = std::sin(2.0f * pi * 3.0f * static_cast<Sample>(i) / static_cast<Sample>(n));
+        }
+        buf.updateGuards(Buffer::GuardMode::Wrap);
+        MipPyramid<3> mips;
+        mips.build(allocator, buf);
+        TEST("MipPyramid odd length: rounds levels up",
+             mips.level(0).numSamples == 251 && mips.level(1).numSamples == 126 &&
+             mips.level(2).numSamples == 63);
+
+        // Frame j of each level sits at source position j * n / n_k
+        Sample levelError = 0.0f;
+        for (size_t k = 0; k < 3; ++k) {
+            const Buffer& level = mips.level(k);
+            for (size_t j = 0; j < level.numSamples; ++j) {
+                const Sample x = static_cast<Sample>(j) / static_cast<Sample>(level.numSamples);
+                levelError = std::max(levelError, std::abs(level.data[j] - std::sin(2.0f * pi * 3.0f * x)));
+            }
+        }
+        TEST("MipPyramid odd length: levels span the loop", levelError < 1e-3f);
+
+        // Reads across the loop seam follow the tone at every level
+        BufRd reader;
+        reader.init(&buf);
+        reader.setInterpolation(4);
+        Sample seamError = 0.0f;
+        const Sample rates[] = {2.0f, 4.0f, 8.0f};
+        for (Sample rate : rates) {
+            reader.setMipRate(rate);
+            for (Sample p = static_cast<Sample>(n) - 12.0f; p < static_cast<Sample>(n) + 12.0f; p += 0.25f) {
+                const Sample expected = std::sin(2.0f * pi * 3.0f * p / static_cast<Sample>(n));
+                seamError = std::max(seamError, std::abs(reader.tick(p) - expected));
+                seamError = std::max(seamError, std::abs(reader.tick(Playhead(p)) - expected));
+            }
+        }
+        TEST("MipPyramid odd length: seam lines up with the source", seamError < 2e-3f);
+
+        mips.release(allocator, buf);
+        allocator.release(buf);
+    }
+
+    // Test BufRd level selection and aliasing at high rates
+    {
+        Buffer buf = allocator.allocate(4096, 1);
+        for (size_t i = 0; i < 4096; ++i) {
+            // 0.45 of the sample rate: anything faster than 1.1x aliases it
+            buf.data[i] = std::sin(2.0f * pi * 0.45f * static_cast<Sample>(i));
+        }
+        MipPyramid<> mips;
+        mips.build(allocator, buf);
+
+        BufRd reader;
+        reader.init(&buf);
+        reader.setInterpolation(4);
+        const Sample plain = rmsAtRate(reader, 4.0f, 1000);
+        reader.setMipRate(4.0f);
+        TEST("BufRd mips: rate 4 reads level 2", reader.mipLevel == 2 && reader.mipBlend == 0.0f);
+        const Sample mipped = rmsAtRate(reader, 4.0f, 1000);
+        TEST("BufRd mips: no mips aliases loudly", plain > 0.3f);
+        TEST("BufRd mips: mipped output is quiet", mipped < 0.02f);
+
+        reader.setInterpolation(2);
+        TEST("BufRd mips: level 2 frame at source frame 4j",
+             reader.tick(40.0f) == mips.level(1).getSample(10));
+
+        reader.setMipRate(2.0f * std::sqrt(2.0f));
+        TEST("BufRd mips: half-octave crossfades two levels",
+             reader.mipLevel == 1 && std::abs(reader.mipBlend - 0.5f) < 1e-5f);
+
+        reader.setMipRate(-0.5f);
+        TEST("BufRd mips: slow rates read the buffer itself",
+             reader.tick(123.25f) == lerp(buf.data[123], buf.data[124], 0.25f));
+
+        // Block forms take the per-sample mip path and still match tick()
+        reader.setInterpolation(4);
+        reader.setMipRate(2.7f);
+        Sample ramp[200];
+        Sample fixed[200];
+        Sample phases[200];
+        Sample arrayOut[200];
+        reader.process(ramp, 4000.0f, 2.7f, 200);
+        reader.process(fixed, Playhead(4000.0), Playhead(2.7), 200);
+        Sample phase = 4000.0f;
+        Playhead pos(4000.0);
+        bool same = true;
+        for (size_t i = 0; i < 200; ++i) {
+            phases[i] = static_cast<Sample>(i) * 2.7f + 10.0f;
+        }
+        reader.process(arrayOut, phases, 200);
+        for (size_t i = 0; i < 200; ++i) {
+            same = same && ramp[i] == reader.tick(phase) && fixed[i] == reader.tick(pos);
+            same = same && arrayOut[i] == reader.tick(phases[i]);
+            phase += 2.7f;
+            if (phase >= 4096.0f) {
+                phase -= 4096.0f;
+            }
+            pos = (pos + Playhead(2.7)).wrap(Playhead::fromIndex(4096));
+        }
+        TEST("BufRd mips: block forms match tick", same);
+
+        mips.release(allocator, buf);
+        allocator.release(buf);
+    }
+
+    return failures;
+}
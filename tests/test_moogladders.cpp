@@ -4,7 +4,11 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
 #include <subcollider/ugens/StilsonMoogLadder.h>
 #include <subcollider/ugens/MicrotrackerMoogLadder.h>
 #include <subcollider/ugens/KrajeskiMoogLadder.h>
@@ -12,6 +16,7 @@
 #include <subcollider/ugens/OberheimMoogLadder.h>
 #include <subcollider/ugens/ImprovedMoogLadder.h>
 #include <subcollider/ugens/RKSimulationMoogLadder.h>
+#include <subcollider/ugens/ZDFMoogLadder.h>
 
 using namespace subcollider;
 using namespace subcollider::ugens;
@@ -24,6 +29,315 @@ using namespace subcollider::ugens;
         std::cout << "PASS: " << name << std::endl; \
     }
 
+namespace {
+
+/**
+ * Run the double and float variants of a ladder side by side: a 2000
+ * sample saw burst, then two seconds of silence in which a resonant
+ * filter rings on or self-oscillates. Reports the largest float/double
+ * difference under the burst relative to its peak, the largest float
+ * output, whether it stayed finite, and both variants' RMS over the
+ * final 100 ms.
+ */
+template<typename Double, typename Float>
+void comparePrecision(Sample cutoff, Sample resonance, Sample& burstError, Sample& floatPeak,
+                      bool& finite, Sample& tailDouble, Sample& tailFloat) {
+    Double reference;
+    Float fast;
+    reference.init(48000.0f);
+    fast.init(48000.0f);
+    reference.setCutoff(cutoff);
+    fast.setCutoff(cutoff);
+    reference.setResonance(resonance);
+    fast.setResonance(resonance);
+
+    const int burst = 2000;
+    const int total = 96000;
+    const int tail = 4800;
+    Sample error = 0.0f;
+    Sample peak = 0.0f;
+    double sumDouble = 0.0;
+    double sumFloat = 0.0;
+    floatPeak = 0.0f;
+    finite = true;
+    for (int i = 0; i < total; ++i) {
+        const Sample x = i < burst ? 0.8f * (2.0f * std::fmod(static_cast<Sample>(i), 100.0f) / 100.0f - 1.0f)
+                                   : 0.0f;
+        const Sample a = reference.tick(x);
+        const Sample b = fast.tick(x);
+        finite = finite && std::isfinite(b);
+        floatPeak = std::max(floatPeak, std::abs(b));
+        if (i < burst) {
+            error = std::max(error, std::abs(a - b));
+            peak = std::max(peak, std::abs(a));
+        }
+        if (i >= total - tail) {
+            sumDouble += static_cast<double>(a) * a;
+            sumFloat += static_cast<double>(b) * b;
+        }
+    }
+    burstError = peak > 0.0f ? error / peak : 1.0f;
+    tailDouble = static_cast<Sample>(std::sqrt(sumDouble / tail));
+    tailFloat = static_cast<Sample>(std::sqrt(sumFloat / tail));
+}
+
+/**
+ * Float variant against double: tracks it under input at moderate
+ * resonance, and at full resonance stays finite and bounded and rings or
+ * self-oscillates at the same level.
+ */
+template<typename Double, typename Float>
+int testPrecision(const std::string& name, Sample bound) {
+    int failures = 0;
+    bool tracks = true;
+    bool stable = true;
+    bool sameTail = true;
+    const Sample cutoffs[4] = {200.0f, 1000.0f, 5000.0f, 12000.0f};
+    for (Sample cutoff : cutoffs) {
+        Sample burstError;
+        Sample floatPeak;
+        bool finite;
+        Sample tailDouble;
+        Sample tailFloat;
+        comparePrecision<Double, Float>(cutoff, 0.5f, burstError, floatPeak, finite, tailDouble, tailFloat);
+        // Very high cutoffs leave the RK solver's accurate range; compare
+        // the float variant there by stability and level only
+        if (cutoff <= 5000.0f) {
+            tracks = tracks && burstError < 1e-3f;
+        }
+
+        comparePrecision<Double, Float>(cutoff, 1.0f, burstError, floatPeak, finite, tailDouble, tailFloat);
+        stable = stable && finite && floatPeak < bound;
+        // Near self-oscillation the phase drifts apart, so compare level
+        sameTail = sameTail && (tailDouble > 1e-3f ? std::abs(tailFloat - tailDouble) < 0.05f * tailDouble
+                                                   : tailFloat < 1e-3f);
+    }
+    TEST(name + "F: tracks double precision at resonance 0.5", tracks);
+    TEST(name + "F: finite and bounded at full resonance", stable);
+    TEST(name + "F: rings at the double variant's level at full resonance", sameTail);
+    return failures;
+}
+
+/**
+ * Run a ZDF ladder next to RKSimulationMoogLadder: half a second of a
+ * naive saw at the given level, then half a second of silence. Reports
+ * the RMS difference under input relative to the RK output's RMS (after
+ * the first 100 ms), and each filter's RMS and zero crossings over the
+ * silent half, where a self-oscillating ladder keeps ringing.
+ */
+template<typename ZDF>
+void compareWithRK(Sample cutoff, Sample resonance, Sample level, Sample& drivenError,
+                   Sample& ringRK, Sample& ringZDF, int& crossingsRK, int& crossingsZDF) {
+    RKSimulationMoogLadder rk;
+    ZDF zdf;
+    rk.init(48000.0f);
+    zdf.init(48000.0f);
+    rk.setCutoff(cutoff);
+    zdf.setCutoff(cutoff);
+    rk.setResonance(resonance);
+    zdf.setResonance(resonance);
+
+    const int half = 24000;
+    double diff = 0.0;
+    double power = 0.0;
+    double ringPowerRK = 0.0;
+    double ringPowerZDF = 0.0;
+    Sample lastRK = 0.0f;
+    Sample lastZDF = 0.0f;
+    crossingsRK = 0;
+    crossingsZDF = 0;
+    for (int i = 0; i < 2 * half; ++i) {
+        const Sample x = i < half ? level * (2.0f * std::fmod(static_cast<Sample>(i), 109.0f) / 109.0f - 1.0f)
+                                  : 0.0f;
+        const Sample a = rk.tick(x);
+        const Sample b = zdf.tick(x);
+        if (i >= 4800 && i < half) {
+            diff += static_cast<double>(a - b) * (a - b);
+            power += static_cast<double>(a) * a;
+        } else if (i >= half) {
+            ringPowerRK += static_cast<double>(a) * a;
+            ringPowerZDF += static_cast<double>(b) * b;
+            crossingsRK += (a < 0.0f) != (lastRK < 0.0f) ? 1 : 0;
+            crossingsZDF += (b < 0.0f) != (lastZDF < 0.0f) ? 1 : 0;
+        }
+        lastRK = a;
+        lastZDF = b;
+    }
+    drivenError = static_cast<Sample>(std::sqrt(diff / power));
+    ringRK = static_cast<Sample>(std::sqrt(ringPowerRK / half));
+    ringZDF = static_cast<Sample>(std::sqrt(ringPowerZDF / half));
+}
+
+/// Power spectrum of a Hann-windowed block (radix-2 FFT, size a power of two)
+std::vector<double> powerSpectrum(const std::vector<double>& block) {
+    const size_t n = block.size();
+    const double pi = 3.14159265358979323846;
+    std::vector<std::complex<double>> a(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = block[i] * (0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(i) / static_cast<double>(n)));
+    }
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const std::complex<double> step = std::polar(1.0, -2.0 * pi / static_cast<double>(len));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> w = 1.0;
+            for (size_t k = 0; k < len / 2; ++k) {
+                const std::complex<double> odd = a[i + k + len / 2] * w;
+                a[i + k + len / 2] = a[i + k] - odd;
+                a[i + k] += odd;
+                w *= step;
+            }
+        }
+    }
+    std::vector<double> power(n / 2);
+    for (size_t k = 0; k < n / 2; ++k) {
+        power[k] = std::norm(a[k]);
+    }
+    return power;
+}
+
+/// Third-octave band levels from 40 Hz up and the peak frequency of a power spectrum
+void spectralShape(const std::vector<double>& power, double binHz, std::vector<double>& bands, double& peakHz) {
+    bands.clear();
+    for (double low = 40.0; low < binHz * static_cast<double>(power.size()); low *= std::pow(2.0, 1.0 / 3.0)) {
+        const double high = low * std::pow(2.0, 1.0 / 3.0);
+        double energy = 0.0;
+        for (size_t k = 1; k < power.size(); ++k) {
+            const double f = binHz * static_cast<double>(k);
+            energy += f >= low && f < high ? power[k] : 0.0;
+        }
+        bands.push_back(std::sqrt(energy));
+    }
+    size_t peak = 1;
+    for (size_t k = 2; k + 1 < power.size(); ++k) {
+        peak = power[k] > power[peak] ? k : peak;
+    }
+    // Parabolic interpolation on log magnitude
+    const double l = std::log(power[peak - 1] + 1e-30);
+    const double c = std::log(power[peak]);
+    const double r = std::log(power[peak + 1] + 1e-30);
+    peakHz = binHz * (static_cast<double>(peak) + 0.5 * (l - r) / (l - 2.0 * c + r));
+}
+
+/**
+ * Drive the ZDF ladder and the RK model at 4x oversampling with the same
+ * saw for one second and compare the spectra of the last 16384 samples:
+ * the RMS difference of their third-octave band levels relative to the
+ * RK levels, and the relative difference of their spectral peaks. At
+ * high resonance the loop self-oscillates on top of the drive and the
+ * two waveforms drift apart in phase, so a waveform difference says
+ * nothing there.
+ */
+template<typename ZDF>
+void compareSpectrumWithRK(Sample cutoff, Sample resonance, Sample level,
+                           Sample& envelopeError, Sample& peakError) {
+    RKSimulationMoogLadder rk;
+    ZDF zdf;
+    rk.init(48000.0f);
+    zdf.init(48000.0f);
+    rk.setOversampleFactor(4);
+    rk.setCutoff(cutoff);
+    zdf.setCutoff(cutoff);
+    rk.setResonance(resonance);
+    zdf.setResonance(resonance);
+
+    const size_t length = 48000;
+    const size_t window = 16384;
+    std::vector<double> blockRK(window);
+    std::vector<double> blockZDF(window);
+    for (size_t i = 0; i < length; ++i) {
+        const Sample x = level * (2.0f * std::fmod(static_cast<Sample>(i), 109.0f) / 109.0f - 1.0f);
+        const Sample a = rk.tick(x);
+        const Sample b = zdf.tick(x);
+        if (i >= length - window) {
+            blockRK[i - (length - window)] = a;
+            blockZDF[i - (length - window)] = b;
+        }
+    }
+
+    std::vector<double> bandsRK;
+    std::vector<double> bandsZDF;
+    double peakRK;
+    double peakZDF;
+    spectralShape(powerSpectrum(blockRK), 48000.0 / window, bandsRK, peakRK);
+    spectralShape(powerSpectrum(blockZDF), 48000.0 / window, bandsZDF, peakZDF);
+    double diff = 0.0;
+    double power = 0.0;
+    for (size_t k = 0; k < bandsRK.size(); ++k) {
+        diff += (bandsZDF[k] - bandsRK[k]) * (bandsZDF[k] - bandsRK[k]);
+        power += bandsRK[k] * bandsRK[k];
+    }
+    envelopeError = static_cast<Sample>(std::sqrt(diff / power));
+    peakError = static_cast<Sample>(std::abs(peakZDF / peakRK - 1.0));
+}
+
+/**
+ * Compare a ZDF ladder with the RK model: waveform below self-oscillation,
+ * spectral envelope and peak driven above it, and free self-oscillation
+ * level and pitch (pitch within 1 / pitchDivisor of the RK crossings).
+ */
+template<typename ZDF>
+int testZDFAgainstRK(const std::string& name, int pitchDivisor) {
+    int failures = 0;
+    {
+        // Below self-oscillation, driven into the clipper and not: the
+        // waveforms follow the RK model
+        bool driven = true;
+        // Above it (feedback 10): rings at the RK model's level and pitch
+        bool ringing = true;
+        const Sample cutoffs[3] = {200.0f, 1000.0f, 3000.0f};
+        for (Sample cutoff : cutoffs) {
+            Sample error;
+            Sample ringRK;
+            Sample ringZDF;
+            int crossingsRK;
+            int crossingsZDF;
+            for (Sample resonance : {0.0f, 0.3f}) {
+                for (Sample level : {0.5f, 2.0f}) {
+                    compareWithRK<ZDF>(cutoff, resonance, level, error, ringRK, ringZDF, crossingsRK, crossingsZDF);
+                    driven = driven && error < 0.12f;
+                }
+            }
+            compareWithRK<ZDF>(cutoff, 1.0f, 0.5f, error, ringRK, ringZDF, crossingsRK, crossingsZDF);
+            ringing = ringing && ringRK > 1.0f && std::abs(ringZDF - ringRK) < 0.02f * ringRK &&
+                      std::abs(crossingsZDF - crossingsRK) <= crossingsRK / pitchDivisor + 1;
+        }
+        TEST(name + " vs RK: driven response within 12% RMS", driven);
+        TEST(name + " vs RK: self-oscillation level and pitch match", ringing);
+    }
+    {
+        // Driven above the self-oscillation threshold (feedback 5 to 9),
+        // into the clipper and not: same spectral envelope and peak
+        Sample worstEnvelope = 0.0f;
+        Sample worstPeak = 0.0f;
+        for (Sample cutoff : {200.0f, 1000.0f, 3000.0f}) {
+            for (Sample resonance : {0.5f, 0.7f, 0.9f}) {
+                for (Sample level : {0.5f, 2.0f}) {
+                    Sample envelopeError;
+                    Sample peakError;
+                    compareSpectrumWithRK<ZDF>(cutoff, resonance, level, envelopeError, peakError);
+                    worstEnvelope = std::max(worstEnvelope, envelopeError);
+                    worstPeak = std::max(worstPeak, peakError);
+                }
+            }
+        }
+        TEST(name + " vs RK: resonant spectral envelope within 6%", worstEnvelope < 0.06f);
+        TEST(name + " vs RK: resonant spectral peak within 1%", worstPeak < 0.01f);
+    }
+    return failures;
+}
+
+} // namespace
+
 int test_moogladders() {
     int failures = 0;
 
@@ -321,5 +635,97 @@ int test_moogladders() {
         TEST("RKSimulationMoogLadder reset: filter state resets", std::abs(out) < 0.1f);
     }
 
+    // Test ZDFMoogLadder
+    std::cout << "  ZDFMoogLadder:" << std::endl;
+    {
+        ZDFMoogLadder filter;
+        filter.init(48000.0f);
+        TEST("ZDFMoogLadder init: sample rate is set", filter.sampleRate == 48000.0f);
+        TEST("ZDFMoogLadder init: default cutoff is 1000", filter.cutoff == 1000.0f);
+        TEST("ZDFMoogLadder init: default resonance is 0.1", std::abs(filter.resonance - 0.1f) < 0.01f);
+        filter.setCutoff(30000.0f);
+        TEST("ZDFMoogLadder setCutoff: limited below Nyquist", filter.cutoff < 24000.0f);
+    }
+    {
+        ZDFMoogLadder filter;
+        filter.init(48000.0f);
+        Sample buffer[64];
+        for (int i = 0; i < 64; ++i) buffer[i] = (i % 2 == 0) ? 1.0f : -1.0f;
+        filter.process(buffer, 64);
+
+        bool allValid = true;
+        for (int i = 0; i < 64; ++i) {
+            if (std::isnan(buffer[i]) || std::isinf(buffer[i])) {
+                allValid = false;
+                break;
+            }
+        }
+        TEST("ZDFMoogLadder process: no NaN or Inf in output", allValid);
+    }
+    {
+        // Full resonance near Nyquist, where RK at 1x loses accuracy
+        ZDFMoogLadder filter;
+        ZDFMoogLadderCorrected corrected;
+        filter.init(48000.0f);
+        corrected.init(48000.0f);
+        filter.setCutoff(20000.0f);
+        corrected.setCutoff(20000.0f);
+        filter.setResonance(1.0f);
+        corrected.setResonance(1.0f);
+        bool stable = true;
+        for (int i = 0; i < 48000; ++i) {
+            const Sample out = filter.tick(i < 100 ? 1.0f : 0.0f);
+            const Sample outCorrected = corrected.tick(i < 100 ? 1.0f : 0.0f);
+            stable = stable && std::isfinite(out) && std::abs(out) < 10.0f &&
+                     std::isfinite(outCorrected) && std::abs(outCorrected) < 10.0f;
+        }
+        TEST("ZDFMoogLadder stability: finite and bounded at 20 kHz, full resonance", stable);
+    }
+    {
+        ZDFMoogLadder filter;
+        filter.init(48000.0f);
+        for (int i = 0; i < 100; ++i) filter.tick(0.5f);
+        filter.reset();
+        Sample out = filter.tick(0.0f);
+        TEST("ZDFMoogLadder reset: filter state resets", std::abs(out) < 0.1f);
+    }
+    failures += testZDFAgainstRK<ZDFMoogLadder>("ZDFMoogLadder", 100);
+    failures += testZDFAgainstRK<ZDFMoogLadderCorrected>("ZDFMoogLadderCorrected", 300);
+    {
+        ZDFMoogLadder reference;
+        ZDFMoogLadderF fast;
+        reference.init(48000.0f);
+        fast.init(48000.0f);
+        reference.setResonance(0.4f);
+        fast.setResonance(0.4f);
+        Sample error = 0.0f;
+        for (int i = 0; i < 4800; ++i) {
+            const Sample x = 2.0f * std::fmod(static_cast<Sample>(i), 109.0f) / 109.0f - 1.0f;
+            error = std::max(error, std::abs(reference.tick(x) - fast.tick(x)));
+        }
+        TEST("ZDFMoogLadderF: tracks double precision", error < 1e-3f);
+    }
+    {
+        ZDFMoogLadderCorrected reference;
+        ZDFMoogLadderCorrectedF fast;
+        reference.init(48000.0f);
+        fast.init(48000.0f);
+        reference.setResonance(0.4f);
+        fast.setResonance(0.4f);
+        Sample error = 0.0f;
+        for (int i = 0; i < 4800; ++i) {
+            const Sample x = 2.0f * std::fmod(static_cast<Sample>(i), 109.0f) / 109.0f - 1.0f;
+            error = std::max(error, std::abs(reference.tick(x) - fast.tick(x)));
+        }
+        TEST("ZDFMoogLadderCorrectedF: tracks double precision", error < 1e-3f);
+    }
+
+    // Test float variants against the double reference
+    std::cout << "  Float precision variants:" << std::endl;
+    failures += testPrecision<KrajeskiMoogLadder, KrajeskiMoogLadderF>("KrajeskiMoogLadder", 2.0f);
+    failures += testPrecision<OberheimMoogLadder, OberheimMoogLadderF>("OberheimMoogLadder", 2.0f);
+    failures += testPrecision<ImprovedMoogLadder, ImprovedMoogLadderF>("ImprovedMoogLadder", 4.0f);
+    failures += testPrecision<RKSimulationMoogLadder, RKSimulationMoogLadderF>("RKSimulationMoogLadder", 8.0f);
+
     return failures;
 }
@@ -0,0 +1,98 @@
+/**
+ * @file test_multibuffer.cpp
+ * @brief Unit tests for MultiBuffer
+ */
+
+#include <iostream>
+#include <cstdint>
+#include <subcollider/MultiBuffer.h>
+
+using namespace subcollider;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+int test_multibuffer() {
+    int failures = 0;
+
+    // Test initialization
+    {
+        MultiBuffer<4, 64> buffer;
+        TEST("MultiBuffer: size is set to capacity", buffer.size == 64);
+        TEST("MultiBuffer: channel count", buffer.numChannels() == 4);
+
+        bool allZero = true;
+        for (size_t c = 0; c < 4; ++c) {
+            for (size_t i = 0; i < 64; ++i) {
+                if (buffer.channel(c)[i] != 0.0f) {
+                    allZero = false;
+                }
+            }
+        }
+        TEST("MultiBuffer: initialized to zero", allZero);
+    }
+
+    // Test every channel is aligned, including padded odd sizes
+    {
+        MultiBuffer<3, 37, 32> buffer;
+        bool aligned = true;
+        for (size_t c = 0; c < 3; ++c) {
+            if (reinterpret_cast<uintptr_t>(buffer.channel(c)) % 32 != 0) {
+                aligned = false;
+            }
+        }
+        TEST("MultiBuffer: every channel 32-byte aligned", aligned);
+        TEST("MultiBuffer: stride padded", (MultiBuffer<3, 37, 32>::STRIDE == 40));
+        TEST("MultiBuffer: 64-byte alignment default",
+             reinterpret_cast<uintptr_t>(StereoBuffer<64>().right()) % 64 == 0);
+    }
+
+    // Test left/right are planar and independent
+    {
+        StereoBuffer<16> buffer;
+        buffer.left()[3] = 1.0f;
+        buffer.right()[3] = 2.0f;
+        TEST("MultiBuffer: left is channel 0", buffer.channel(0)[3] == 1.0f);
+        TEST("MultiBuffer: right is channel 1", buffer.channel(1)[3] == 2.0f);
+        TEST("MultiBuffer: channels do not overlap", buffer.right() - buffer.left() >= 16);
+    }
+
+    // Test interleave round trip
+    {
+        StereoBuffer<8> buffer;
+        for (size_t i = 0; i < 8; ++i) {
+            buffer.left()[i] = static_cast<Sample>(i);
+            buffer.right()[i] = -static_cast<Sample>(i);
+        }
+        Sample interleaved[16];
+        buffer.interleave(interleaved);
+        TEST("MultiBuffer interleave: frame order",
+             interleaved[6] == 3.0f && interleaved[7] == -3.0f);
+
+        StereoBuffer<8> copy;
+        copy.deinterleave(interleaved);
+        bool same = true;
+        for (size_t i = 0; i < 8; ++i) {
+            if (copy.left()[i] != buffer.left()[i] || copy.right()[i] != buffer.right()[i]) {
+                same = false;
+            }
+        }
+        TEST("MultiBuffer deinterleave: round trip", same);
+    }
+
+    // Test clear
+    {
+        StereoBuffer<16> buffer;
+        buffer.left()[5] = 1.0f;
+        buffer.right()[15] = 1.0f;
+        buffer.clear();
+        TEST("MultiBuffer clear: all zeros", buffer.left()[5] == 0.0f && buffer.right()[15] == 0.0f);
+    }
+
+    return failures;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_playbuf.cpp
+ * @brief Unit tests for PlayBuf UGen
+ */
+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <subcollider/Buffer.h>
+#include <subcollider/ugens/BufRd.h>
+#include <subcollider/ugens/Phasor.h>
+#include <subcollider/ugens/PlayBuf.h>
+
+using namespace subcollider;
+using namespace subcollider::ugens;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+/// Play n samples through PlayBuf blocks and a Phasor + BufRd pair; true if identical
+bool matchesPair(const Buffer& buf, uint8_t interp, Sample rate, Sample start, Sample end,
+                 const Sample* trig, size_t n) {
+    PlayBuf player;
+    player.init(48000.0f, &buf);
+    player.setInterpolation(interp);
+    player.setRate(rate);
+    player.setLoopPoints(start, end);
+    player.setResetPos(start + 3.0f);
+
+    Phasor phasor;
+    phasor.init(48000.0f);
+    phasor.set(rate, start, end, start + 3.0f);
+    BufRd reader;
+    reader.init(&buf);
+    reader.setInterpolation(interp);
+
+    PlayBuf mono = player;
+    Sample left[700];
+    Sample right[700];
+    Sample out[700];
+    // Uneven block sizes so chunks and wraps land at different offsets
+    const size_t blocks[4] = {64, 17, 128, 1};
+    size_t done = 0;
+    for (size_t b = 0; done < n; ++b) {
+        size_t len = blocks[b % 4];
+        if (len > n - done) {
+            len = n - done;
+        }
+        if (trig != nullptr) {
+            player.processStereo(left + done, right + done, trig + done, len);
+            mono.process(out + done, trig + done, len);
+        } else {
+            player.processStereo(left + done, right + done, len);
+            mono.process(out + done, len);
+        }
+        done += len;
+    }
+
+    bool same = true;
+    for (size_t i = 0; i < n; ++i) {
+        const Sample phase = trig != nullptr ? phasor.tick(trig[i]) : phasor.tick();
+        const Stereo s = reader.tickStereo(phase);
+        same = same && left[i] == s.left && right[i] == s.right && out[i] == s.left;
+    }
+    return same;
+}
+
+} // namespace
+
+int test_playbuf() {
+    int failures = 0;
+
+    Sample mono[150];
+    Sample stereo[150 * 2];
+    for (size_t i = 0; i < 150; ++i) {
+        mono[i] = std::sin(0.21f * static_cast<Sample>(i));
+        stereo[i * 2] = mono[i];
+        stereo[i * 2 + 1] = std::cos(0.17f * static_cast<Sample>(i));
+    }
+    Buffer monoBuf(mono, 1, 48000.0f, 150);
+    Buffer stereoBuf(stereo, 2, 48000.0f, 150);
+
+    // Test initialization
+    {
+        PlayBuf player;
+        player.init(48000.0f, &stereoBuf);
+        TEST("PlayBuf init: loops whole buffer",
+             player.phasor.start == 0.0f && player.phasor.end == 150.0f);
+        TEST("PlayBuf init: looping, not done", player.loop && !player.isDone());
+        TEST("PlayBuf init: first sample is frame 0", player.tickStereo().right == stereo[1]);
+    }
+
+    // Test block output equals Phasor + BufRd for every mode and buffer layout
+    {
+        Sample trig[700];
+        for (size_t i = 0; i < 700; ++i) {
+            trig[i] = (i % 97 == 50) ? 1.0f : 0.0f;
+        }
+        const uint8_t modes[4] = {1, 2, 4, 8};
+        for (int m = 0; m < 4; ++m) {
+            for (int ch = 0; ch < 2; ++ch) {
+                const Buffer& buf = ch == 0 ? monoBuf : stereoBuf;
+                const std::string tag = "interp " + std::to_string(modes[m]) + (ch == 0 ? " mono" : " stereo");
+                TEST("PlayBuf vs pair " + tag + ": whole buffer",
+                     matchesPair(buf, modes[m], 0.73f, 0.0f, 150.0f, nullptr, 700));
+                TEST("PlayBuf vs pair " + tag + ": inner loop",
+                     matchesPair(buf, modes[m], 1.37f, 20.0f, 90.5f, nullptr, 700));
+                TEST("PlayBuf vs pair " + tag + ": reverse",
+                     matchesPair(buf, modes[m], -0.61f, 0.0f, 150.0f, nullptr, 700));
+                TEST("PlayBuf vs pair " + tag + ": backward segment",
+                     matchesPair(buf, modes[m], 1.1f, 120.0f, 30.0f, nullptr, 700));
+                TEST("PlayBuf vs pair " + tag + ": trigger",
+                     matchesPair(buf, modes[m], 1.5f, 10.0f, 140.0f, trig, 700));
+            }
+        }
+    }
+
+    // Test playback rate scales by buffer/output sample rate
+    {
+        Buffer slow(mono, 1, 24000.0f, 150);
+        PlayBuf player;
+        player.init(48000.0f, &slow);
+        player.setPlaybackRate(1.0f);
+        TEST("PlayBuf setPlaybackRate: half-rate buffer advances 0.5", player.phasor.rate == 0.5f);
+    }
+
+    // Test one-shot playback stops and restarts on trigger
+    {
+        Sample data[8] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+        Buffer buf(data, 1, 48000.0f, 8);
+        PlayBuf player;
+        player.init(48000.0f, &buf);
+        player.setInterpolation(1);
+        player.setLoop(false);
+
+        Sample out[12];
+        player.process(out, 12);
+        TEST("PlayBuf one-shot: plays the buffer once", out[0] == 1.0f && out[7] == 8.0f);
+        TEST("PlayBuf one-shot: silent afterwards", out[8] == 0.0f && out[11] == 0.0f);
+        TEST("PlayBuf one-shot: done", player.isDone());
+
+        Sample trig[12] = {};
+        trig[2] = 1.0f;
+        player.process(out, trig, 12);
+        TEST("PlayBuf one-shot: silent before trigger", out[0] == 0.0f && out[1] == 0.0f);
+        TEST("PlayBuf one-shot: trigger restarts at reset position", out[2] == 1.0f && out[9] == 8.0f);
+        TEST("PlayBuf one-shot: stops again", out[10] == 0.0f && player.isDone());
+    }
+
+    // Test missing buffer plays silence
+    {
+        PlayBuf player;
+        player.init(48000.0f);
+        Sample left[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        Sample right[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        player.processStereo(left, right, 4);
+        TEST("PlayBuf no buffer: silence", left[0] == 0.0f && right[3] == 0.0f);
+    }
+
+    return failures;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file test_playhead.cpp
+ * @brief Unit tests for Playhead fixed-point positions and their use in
+ *        Phasor and BufRd
+ */
+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <subcollider/Buffer.h>
+#include <subcollider/Playhead.h>
+#include <subcollider/ugens/BufRd.h>
+#include <subcollider/ugens/Phasor.h>
+
+using namespace subcollider;
+using namespace subcollider::ugens;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+/// Read n samples as a Playhead ramp (tick and block); true if both match float tick()
+bool matchesFloat(BufRd& reader, double start, double inc, size_t n) {
+    Sample left[300];
+    Sample right[300];
+    Sample mono[300];
+    Playhead next = reader.processStereo(left, right, Playhead(start), Playhead(inc), n);
+    reader.process(mono, Playhead(start), Playhead(inc), n);
+
+    bool same = true;
+    Playhead pos(start);
+    Sample phase = static_cast<Sample>(start);
+    const Sample numSamples = static_cast<Sample>(reader.source()->numSamples);
+    for (size_t i = 0; i < n; ++i) {
+        const Stereo expected = reader.tickStereo(phase);
+        const Stereo fixed = reader.tickStereo(pos);
+        same = same && fixed.left == expected.left && fixed.right == expected.right;
+        same = same && left[i] == expected.left && right[i] == expected.right;
+        same = same && mono[i] == reader.tick(pos);
+        pos += Playhead(inc);
+        phase += static_cast<Sample>(inc);
+        if (reader.loop) {
+            pos = pos.wrap(Playhead::fromIndex(reader.source()->numSamples));
+            if (phase >= numSamples) {
+                phase -= numSamples;
+            } else if (phase < 0.0f) {
+                phase += numSamples;
+            }
+        }
+    }
+    return same && next == pos;
+}
+
+} // namespace
+
+int test_playhead() {
+    int failures = 0;
+
+    // Test conversion and integer/fraction split
+    {
+        const Playhead p(2.5);
+        TEST("Playhead: index of 2.5", p.index() == 2);
+        TEST("Playhead: frac of 2.5", p.frac() == 0.5f);
+        TEST("Playhead: round trip", p.toSample() == 2.5f);
+
+        const Playhead n(-0.25);
+        TEST("Playhead: negative index rounds down", n.index() == -1);
+        TEST("Playhead: negative frac", n.frac() == 0.75f);
+
+        TEST("Playhead: fromIndex", Playhead::fromIndex(7, 0x80000000u) == Playhead(7.5));
+    }
+
+    // Test sub-sample resolution past 2^24 frames
+    {
+        const double big = 16777216.0 + 100.0;  // 2^24 + 100
+        const Sample floatPhase = static_cast<Sample>(big + 0.5);
+        TEST("Playhead precision: float phase loses the fraction",
+             floatPhase - std::floor(floatPhase) == 0.0f);
+
+        Playhead p(big);
+        const Playhead inc(0.25);
+        p += inc;
+        p += inc;
+        p += inc;
+        TEST("Playhead precision: index stays exact", p.index() == 16777316);
+        TEST("Playhead precision: fraction accumulates", p.frac() == 0.75f);
+    }
+
+    // Test wrapping is exact
+    {
+        const Playhead length = Playhead::fromIndex(7);
+        const Playhead inc(0.1);
+        Playhead p;
+        for (int i = 0; i < 1000; ++i) {
+            p = (p + inc).wrap(length);
+        }
+        TEST("Playhead wrap: no drift after 1000 steps",
+             p.raw == (1000 * inc.raw) % length.raw);
+        TEST("Playhead wrap: negative", Playhead(-1.5).wrap(length) == Playhead(5.5));
+        TEST("Playhead wrap: large jump", Playhead(30.25).wrap(length) == Playhead(2.25));
+        TEST("Playhead clamp",
+             Playhead(9.0).clamp(Playhead(), Playhead(6.0)) == Playhead(6.0));
+    }
+
+    // Test PlayheadPhasor follows Phasor on exactly representable ramps
+    {
+        Phasor phasor;
+        phasor.init(48000.0f);
+        phasor.set(0.75f, 2.0f, 10.0f, 4.0f);
+        PlayheadPhasor fixed;
+        fixed.init(48000.0f);
+        fixed.set(Playhead(0.75), Playhead(2.0), Playhead(10.0), Playhead(4.0));
+
+        bool same = true;
+        for (int i = 0; i < 100; ++i) {
+            const Sample trig = (i % 37 == 20) ? 1.0f : 0.0f;
+            same = same && fixed.tick(trig).toSample() == phasor.tick(trig);
+        }
+        TEST("PlayheadPhasor: matches Phasor forward", same);
+
+        phasor.set(-1.25f, 9.0f, 1.0f, 9.0f);
+        fixed.set(Playhead(-1.25), Playhead(9.0), Playhead(1.0), Playhead(9.0));
+        same = true;
+        for (int i = 0; i < 100; ++i) {
+            same = same && fixed.tick().toSample() == phasor.tick();
+        }
+        TEST("PlayheadPhasor: matches Phasor backward", same);
+    }
+
+    // Test BufRd Playhead reads match float reads on small buffers
+    {
+        Sample mono[64];
+        Sample stereo[64 * 2];
+        for (size_t i = 0; i < 64; ++i) {
+            mono[i] = std::sin(0.3f * static_cast<Sample>(i));
+            stereo[i * 2] = mono[i];
+            stereo[i * 2 + 1] = std::cos(0.2f * static_cast<Sample>(i));
+        }
+        Buffer monoBuf(mono, 1, 48000.0f, 64);
+        Buffer stereoBuf(stereo, 2, 48000.0f, 64);
+
+        const uint8_t modes[3] = {1, 2, 4};
+        for (int m = 0; m < 3; ++m) {
+            for (int ch = 0; ch < 2; ++ch) {
+                BufRd reader;
+                reader.init(ch == 0 ? &monoBuf : &stereoBuf);
+                reader.setInterpolation(modes[m]);
+                const std::string tag = "interp " + std::to_string(modes[m]) + (ch == 0 ? " mono" : " stereo");
+                TEST("BufRd Playhead " + tag + ": loop forward", matchesFloat(reader, 3.0, 0.75, 300));
+                TEST("BufRd Playhead " + tag + ": loop reverse", matchesFloat(reader, 10.5, -1.25, 300));
+                reader.setLoop(false);
+                TEST("BufRd Playhead " + tag + ": clamp", matchesFloat(reader, 40.0, 0.125, 300));
+            }
+        }
+    }
+
+    // Test interpolation past 2^24 frames
+    {
+        const size_t frames = (size_t(1) << 24) + 256;
+        std::vector<Sample> data(frames);
+        for (size_t i = 0; i < frames; ++i) {
+            data[i] = (i & 1) ? 1.0f : 0.0f;
+        }
+        Buffer buf(data.data(), 1, 48000.0f, frames);
+        BufRd reader;
+        reader.init(&buf);
+        reader.setInterpolation(2);
+
+        const double pos = 16777216.0 + 100.5;
+        TEST("BufRd long buffer: float phase snaps to a frame",
+             reader.tick(static_cast<Sample>(pos)) == 0.0f);
+        TEST("BufRd long buffer: Playhead interpolates",
+             reader.tick(Playhead(pos)) == 0.5f);
+
+        Sample out[8];
+        reader.process(out, Playhead(pos), Playhead(0.25), 8);
+        TEST("BufRd long buffer: block ramp keeps the fraction",
+             out[0] == 0.5f && out[1] == 0.75f && out[2] == 1.0f && out[3] == 0.75f);
+    }
+
+    return failures;
+}
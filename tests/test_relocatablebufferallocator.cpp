@@ -0,0 +1,213 @@
+/**
+ * @file test_relocatablebufferallocator.cpp
+ * @brief Unit tests for RelocatableBufferAllocator, BufferHandle and BufRd/XPlay handle playback
+ */
+
+#include <iostream>
+#include <cmath>
+#include <subcollider/RelocatableBufferAllocator.h>
+#include <subcollider/ugens/BufRd.h>
+#include <subcollider/ugens/XPlay.h>
+
+using namespace subcollider;
+using namespace subcollider::ugens;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+using TestRelocatable = RelocatableBufferAllocator<BufferAllocator<1000, 32>, 16, 16>;
+
+namespace {
+
+/// Fill a mono buffer with value + index so moves can be checked
+void fillRamp(const Buffer& buf, Sample value) {
+    for (size_t i = 0; i < buf.numSamples; ++i) {
+        buf.data[i] = value + static_cast<Sample>(i);
+    }
+}
+
+bool hasRamp(const Buffer& buf, Sample value) {
+    if (!buf.isValid()) {
+        return false;
+    }
+    for (size_t i = 0; i < buf.numSamples; ++i) {
+        if (buf.data[i] != value + static_cast<Sample>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int test_relocatablebufferallocator() {
+    int failures = 0;
+
+    // Test handle lifecycle and generation checks
+    {
+        static TestRelocatable pool;
+        pool.init(48000.0f);
+
+        TEST("Handle: default handle is invalid", !BufferHandle().isValid());
+        TEST("Handle: default handle resolves invalid", !pool.resolve(BufferHandle()).isValid());
+
+        BufferHandle h = pool.allocate(100, 1);
+        TEST("Handle: allocate returns valid handle", h.isValid());
+        Buffer buf = pool.resolve(h);
+        TEST("Handle: resolves to allocated buffer",
+             buf.isValid() && buf.numSamples == 100 && buf.channels == 1);
+        TEST("Handle: seal live handle", pool.seal(h));
+
+        TEST("Handle: release queued", pool.release(h));
+        pool.collect();
+        TEST("Handle: released handle resolves invalid", !pool.resolve(h).isValid());
+        TEST("Handle: memory held until block ends", pool.freeSpace() == 900);
+        pool.endBlock();
+        pool.collect();
+        TEST("Handle: memory freed after block ends", pool.freeSpace() == 1000);
+
+        BufferHandle h2 = pool.allocate(50, 1);
+        TEST("Handle: slot reused with new generation",
+             h2.index == h.index && h2.generation != h.generation);
+        TEST("Handle: stale handle does not resolve to new buffer", !pool.resolve(h).isValid());
+        TEST("Handle: seal of stale handle rejected", !pool.seal(h));
+    }
+
+    // Test compaction defragments the pool and preserves contents
+    {
+        static TestRelocatable pool;
+        pool.init(48000.0f);
+
+        BufferHandle handles[10];
+        for (int i = 0; i < 10; ++i) {
+            handles[i] = pool.allocate(100, 1);
+            fillRamp(pool.resolve(handles[i]), static_cast<Sample>(i * 1000));
+            pool.seal(handles[i]);
+        }
+        for (int i = 0; i < 10; i += 2) {
+            pool.release(handles[i]);
+        }
+        pool.collect();
+        pool.endBlock();
+        pool.collect();
+        TEST("Compact: half the pool is free", pool.freeSpace() == 500);
+        TEST("Compact: fragmented pool rejects large request",
+             !pool.allocate(300, 1).isValid());
+
+        size_t moved = 0;
+        for (int pass = 0; pass < 20; ++pass) {
+            moved += pool.compact();
+            pool.endBlock();
+        }
+        pool.collect();
+        TEST("Compact: buffers were moved", moved > 0 && pool.moveCount() == moved);
+        TEST("Compact: free space coalesced", pool.blockCount() == 6);
+
+        bool intact = true;
+        for (int i = 1; i < 10; i += 2) {
+            intact = intact && hasRamp(pool.resolve(handles[i]), static_cast<Sample>(i * 1000));
+        }
+        TEST("Compact: moved buffers keep their contents", intact);
+        TEST("Compact: large request fits after compaction", pool.allocate(500, 1).isValid());
+    }
+
+    // Test unsealed buffers are not moved
+    {
+        static TestRelocatable pool;
+        pool.init(48000.0f);
+        BufferHandle a = pool.allocate(100, 1);
+        BufferHandle b = pool.allocate(100, 1);
+        pool.release(a);
+        pool.collect();
+        pool.endBlock();
+        pool.collect();
+        const Sample* before = pool.resolve(b).data;
+        TEST("Compact: unsealed buffer stays", pool.compact() == 0 && pool.resolve(b).data == before);
+        pool.seal(b);
+        TEST("Compact: sealed buffer moves down", pool.compact() == 1 && pool.resolve(b).data < before);
+    }
+
+    // Test guard frames are published by seal() and move with the samples
+    {
+        static TestRelocatable pool;
+        pool.init(48000.0f);
+        BufferHandle gap = pool.allocate(104, 1);
+        BufferHandle h = pool.allocate(100, 1, 2);
+        fillRamp(pool.resolve(h), 0.0f);
+        TEST("Guards: unused until sealed",
+             pool.resolve(h).guardFrames == 2 && pool.resolve(h).guardMode == Buffer::GuardMode::Off);
+        pool.seal(h, Buffer::GuardMode::Wrap);
+        TEST("Guards: seal writes and publishes them",
+             pool.resolve(h).hasGuards(Buffer::GuardMode::Wrap, 2) &&
+             pool.resolve(h).data[-2] == 98.0f && pool.resolve(h).data[101] == 1.0f);
+
+        const Sample* before = pool.resolve(h).data;
+        pool.release(gap);
+        pool.collect();
+        pool.endBlock();
+        pool.collect();
+        TEST("Guards: guarded buffer moves down", pool.compact() == 1 && pool.resolve(h).data < before);
+        const Buffer moved = pool.resolve(h);
+        TEST("Guards: mode kept after the move", moved.hasGuards(Buffer::GuardMode::Wrap, 2));
+        TEST("Guards: contents moved with the samples",
+             hasRamp(moved, 0.0f) && moved.data[-2] == 98.0f && moved.data[-1] == 99.0f &&
+             moved.data[100] == 0.0f && moved.data[101] == 1.0f);
+        pool.release(h);
+        pool.collect();
+        pool.endBlock();
+        pool.collect();
+        TEST("Guards: whole allocation freed", pool.freeSpace() == 1000);
+    }
+
+    // Test BufRd and XPlay follow a moved buffer at the next block
+    {
+        static TestRelocatable pool;
+        pool.init(48000.0f);
+        BufferHandle gap = pool.allocate(64, 1);
+        BufferHandle h = pool.allocate(64, 1);
+        fillRamp(pool.resolve(h), 0.0f);
+        pool.seal(h);
+
+        BufRd reader;
+        reader.init();
+        reader.setInterpolation(1);
+        reader.setBuffer(pool.ref(h));
+        Sample phase[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+        Sample out[4] = {};
+        reader.process(out, phase, 4);
+        TEST("BufRd handle: reads through handle", out[3] == 3.0f);
+
+        const Sample* oldData = pool.resolve(h).data;
+        pool.release(gap);
+        pool.collect();
+        pool.endBlock();
+        pool.collect();
+        pool.compact();
+        TEST("BufRd handle: buffer moved", pool.resolve(h).data != oldData);
+        TEST("BufRd handle: old address kept until block ends", reader.source()->data == oldData);
+        reader.process(out, phase, 4);
+        TEST("BufRd handle: re-resolved at block start",
+             reader.source()->data == pool.resolve(h).data && out[2] == 2.0f);
+
+        XPlay xplay;
+        xplay.init(48000.0f);
+        xplay.setBuffer(pool.ref(h));
+        TEST("XPlay handle: loop bounds from handle", xplay.frames == 64.0f);
+
+        pool.release(h);
+        pool.collect();
+        Sample left[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        Sample right[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        xplay.process(left, right, 4);
+        TEST("XPlay handle: released buffer plays silence", left[0] == 0.0f && right[3] == 0.0f);
+        reader.process(out, phase, 4);
+        TEST("BufRd handle: released buffer reads silence", out[0] == 0.0f && out[3] == 0.0f);
+    }
+
+    return failures;
+}
@@ -4,6 +4,7 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
 #include <subcollider/ugens/SuperSaw.h>
 
@@ -226,12 +227,12 @@ int test_supersaw() {
         bool allUnique = true;
         for (int i = 0; i < SuperSaw::NUM_VOICES - 1; ++i) {
             for (int j = i + 1; j < SuperSaw::NUM_VOICES; ++j) {
-                // Check detune offsets are different
-                if (supersaw.voices[i].detuneOffset == supersaw.voices[j].detuneOffset) {
+                // Check detune ratios are different
+                if (supersaw.detuneRatio[i] == supersaw.detuneRatio[j]) {
                     allUnique = false;
                 }
                 // Check random phases are different
-                if (supersaw.voices[i].sawPhase == supersaw.voices[j].sawPhase) {
+                if (supersaw.phase[i] == supersaw.phase[j]) {
                     allUnique = false;
                 }
             }
@@ -239,5 +240,99 @@ int test_supersaw() {
         TEST("SuperSaw voices: all have unique detune/phases", allUnique);
     }
 
+    // Test cached detune ratios and pan gains
+    {
+        SuperSaw supersaw;
+        supersaw.init(48000.0f, 42);
+        supersaw.setDetune(0.4f);
+        supersaw.setSpread(1.0f);
+        TEST("SuperSaw detune: outer voices at -/+ detune/2",
+             std::abs(supersaw.detuneRatio[0] - std::pow(2.0f, -0.2f / 12.0f)) < 1e-6f &&
+             std::abs(supersaw.detuneRatio[6] - std::pow(2.0f, 0.2f / 12.0f)) < 1e-6f);
+        TEST("SuperSaw spread: full spread pans hard left and right",
+             supersaw.gainRight[0] < 1e-6f && supersaw.gainLeft[1] < 1e-6f);
+        TEST("SuperSaw lanes: seven voices fill eight lanes, padding silent",
+             SuperSaw::LANES == 8 && supersaw.gainLeft[7] == 0.0f && supersaw.gainRight[7] == 0.0f);
+    }
+
+    // Test vibrato runs at control rate and frequency changes ramp in
+    {
+        SuperSaw supersaw;
+        supersaw.init(48000.0f, 42);
+        supersaw.setVibratoDepth(0.0f);
+        supersaw.setDetune(0.0f);
+        supersaw.setFrequency(480.0f);
+        supersaw.tick();
+        TEST("SuperSaw control: first update jumps to the increment",
+             std::abs(supersaw.phaseIncrement[3] - 0.01f) < 1e-7f);
+
+        supersaw.setFrequency(960.0f);
+        for (size_t i = 1; i < SuperSaw::CONTROL_PERIOD + 8; ++i) {
+            supersaw.tick();
+        }
+        // Halfway through the ramp from 0.01 to 0.02
+        TEST("SuperSaw control: frequency change ramps over a period",
+             std::abs(supersaw.phaseIncrement[3] - 0.015f) < 1e-5f);
+        for (size_t i = 0; i < SuperSaw::CONTROL_PERIOD; ++i) {
+            supersaw.tick();
+        }
+        TEST("SuperSaw control: ramp reaches the new increment",
+             std::abs(supersaw.phaseIncrement[3] - 0.02f) < 1e-5f);
+    }
+
+    // Test other voice counts, including a full 16-lane layout
+    {
+        SuperSawN<5> five;
+        SuperSawN<16> sixteen;
+        five.init(48000.0f, 3);
+        sixteen.init(48000.0f, 3);
+        five.gate(1.0f);
+        sixteen.gate(1.0f);
+        Sample left[512];
+        Sample right[512];
+        Sample peak = 0.0f;
+        bool finite = true;
+        sixteen.process(left, right, 512);
+        for (size_t i = 0; i < 512; ++i) {
+            peak = std::max(peak, std::abs(left[i]));
+            finite = finite && std::isfinite(left[i]) && std::isfinite(right[i]);
+        }
+        TEST("SuperSawN<16>: bounded, finite output", finite && peak > 0.01f && peak < 10.0f);
+
+        five.process(left, right, 512);
+        finite = true;
+        for (size_t i = 0; i < 512; ++i) {
+            finite = finite && std::isfinite(left[i]) && std::isfinite(right[i]);
+        }
+        TEST("SuperSawN<5>: padding lanes stay silent",
+             SuperSawN<5>::LANES == 8 && finite && five.scale[5] == 0.0f && five.gainLeft[7] == 0.0f);
+    }
+
+    // Test block process matches per-sample tick
+    {
+        SuperSaw block;
+        SuperSaw reference;
+        block.init(48000.0f, 7);
+        reference.init(48000.0f, 7);
+        block.setFrequency(220.0f);
+        reference.setFrequency(220.0f);
+        block.gate(1.0f);
+        reference.gate(1.0f);
+
+        Sample left[200];
+        Sample right[200];
+        bool identical = true;
+        for (int b = 0; b < 5; ++b) {
+            block.process(left, right, 200);
+            for (size_t i = 0; i < 200; ++i) {
+                Stereo s = reference.tick();
+                if (s.left != left[i] || s.right != right[i]) {
+                    identical = false;
+                }
+            }
+        }
+        TEST("SuperSaw process: matches tick", identical);
+    }
+
     return failures;
 }
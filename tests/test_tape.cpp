@@ -108,5 +108,38 @@ int test_tape() {
         TEST("Tape reset: silent tick after reset", std::fabs(tape.tick(0.0f)) < 1e-6f);
     }
 
+    // Planar stereo block matches per-sample tickStereo
+    {
+        Tape block;
+        Tape reference;
+        block.init(48000.0f);
+        reference.init(48000.0f);
+        block.setBias(0.7f);
+        reference.setBias(0.7f);
+        block.setPregain(3.0f);
+        reference.setPregain(3.0f);
+
+        Sample left[150];
+        Sample right[150];
+        Sample refLeft[150];
+        Sample refRight[150];
+        for (size_t i = 0; i < 150; ++i) {
+            left[i] = refLeft[i] = std::sin(0.05f * static_cast<Sample>(i));
+            right[i] = refRight[i] = 0.5f * std::cos(0.11f * static_cast<Sample>(i));
+        }
+        block.processStereo(left, right, 150);
+
+        bool identical = true;
+        for (size_t i = 0; i < 150; ++i) {
+            Stereo out = reference.tickStereo(refLeft[i], refRight[i]);
+            if (out.left != left[i] || out.right != right[i]) {
+                identical = false;
+            }
+        }
+        TEST("Tape processStereo: matches tickStereo", identical);
+        TEST("Tape processStereo: follower state matches",
+             block.getFollowerValue() == reference.getFollowerValue());
+    }
+
     return failures;
 }
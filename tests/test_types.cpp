@@ -4,6 +4,7 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
 #include <subcollider/types.h>
 
@@ -38,5 +39,42 @@ int test_types() {
     TEST("clamp(15, 0, 10) = 10", clamp(15.0f, 0.0f, 10.0f) == 10.0f);
     TEST("clamp(0, -1, 1) = 0", clamp(0.0f, -1.0f, 1.0f) == 0.0f);
 
+    // Test tanhApprox
+    {
+        double worst = 0.0;
+        for (int i = -8000; i <= 8000; ++i) {
+            const double x = i * 0.001;
+            worst = std::max(worst, std::abs(tanhApprox(x) - std::tanh(x)));
+        }
+        TEST("tanhApprox: within 1e-4 of tanh", worst < 1e-4);
+        TEST("tanhApprox: saturates at +/-1", std::abs(tanhApprox(50.0f) - 1.0f) < 1e-6f &&
+             std::abs(tanhApprox(-50.0f) + 1.0f) < 1e-6f);
+    }
+
+    // Test Lcg
+    {
+        Lcg a(42);
+        Lcg b(42);
+        bool same = true;
+        bool inRange = true;
+        Sample sum = 0.0f;
+        for (int i = 0; i < 10000; ++i) {
+            const Sample u = a.nextUnipolar();
+            same = same && u == b.nextUnipolar();
+            const Sample v = a.nextBipolar();
+            b.nextBipolar();
+            inRange = inRange && u >= 0.0f && u < 1.0f && v >= -1.0f && v < 1.0f;
+            sum += u;
+        }
+        TEST("Lcg: same seed, same sequence", same);
+        TEST("Lcg: unipolar and bipolar ranges", inRange);
+        TEST("Lcg: unipolar mean near 0.5", std::abs(sum / 10000.0f - 0.5f) < 0.02f);
+        TEST("Lcg: four bytes of state", sizeof(Lcg) == 4);
+
+        // State 0x26f5b720 steps to 0xffffffff, which rounds to 2^32 as a float
+        Lcg top(0x26f5b720u);
+        TEST("Lcg: bipolar stays below 1 at the top state", top.nextBipolar() < 1.0f);
+    }
+
     return failures;
 }
@@ -0,0 +1,244 @@
+/**
+ * @file test_voicepool.cpp
+ * @brief Unit tests for VoicePool
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <subcollider/VoicePool.h>
+#include <subcollider/ExampleVoice.h>
+
+using namespace subcollider;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+/// Minimal voice that outputs a constant and counts process() calls
+struct ConstantVoice {
+    Sample value;
+    Sample envLevel;
+    bool active;
+    int processCalls;
+    int resets;
+
+    void init(Sample) noexcept {
+        value = 0.0f;
+        envLevel = 0.0f;
+        active = false;
+        processCalls = 0;
+        resets = 0;
+    }
+
+    void start(Sample v, Sample lvl) noexcept {
+        value = v;
+        envLevel = lvl;
+        active = true;
+    }
+
+    bool isActive() const noexcept { return active; }
+    Sample level() const noexcept { return envLevel; }
+
+    void reset() noexcept {
+        active = false;
+        value = 0.0f;
+        ++resets;
+    }
+
+    void process(Sample* left, Sample* right, size_t numSamples) noexcept {
+        ++processCalls;
+        for (size_t i = 0; i < numSamples; ++i) {
+            left[i] = value;
+            right[i] = -value;
+        }
+    }
+};
+
+} // namespace
+
+int test_voicepool() {
+    int failures = 0;
+
+    // Test initialization
+    {
+        VoicePool<ConstantVoice, 8> pool;
+        pool.init(48000.0f);
+        TEST("VoicePool init: no active voices", pool.activeCount() == 0);
+        TEST("VoicePool init: all voices free", pool.freeCount() == 8);
+        TEST("VoicePool init: capacity", pool.capacity() == 8);
+        TEST("VoicePool init: sample rate", pool.sampleRate() == 48000.0f);
+    }
+
+    // Test allocation hands out distinct voices
+    {
+        VoicePool<ConstantVoice, 4> pool;
+        pool.init();
+        ConstantVoice* a = pool.noteOn(60);
+        ConstantVoice* b = pool.noteOn(64);
+        TEST("VoicePool noteOn: returns voice", a != nullptr && b != nullptr);
+        TEST("VoicePool noteOn: distinct voices", a != b);
+        TEST("VoicePool noteOn: active count", pool.activeCount() == 2);
+        TEST("VoicePool noteOn: free count", pool.freeCount() == 2);
+        TEST("VoicePool find: locates note", pool.find(64) == b);
+        TEST("VoicePool find: unknown note", pool.find(99) == nullptr);
+    }
+
+    // Test process skips free voices and sums active ones
+    {
+        VoicePool<ConstantVoice, 16> pool;
+        pool.init();
+        pool.noteOn(1)->start(0.25f, 1.0f);
+        pool.noteOn(2)->start(0.5f, 1.0f);
+
+        Sample left[64];
+        Sample right[64];
+        pool.process(left, right, 64);
+
+        int totalCalls = 0;
+        for (size_t i = 0; i < pool.capacity(); ++i) {
+            totalCalls += pool.voice(i).processCalls;
+        }
+        TEST("VoicePool process: only active voices processed", totalCalls == 2);
+        TEST("VoicePool process: left is sum", std::abs(left[10] - 0.75f) < 1e-6f);
+        TEST("VoicePool process: right is sum", std::abs(right[10] + 0.75f) < 1e-6f);
+    }
+
+    // Test inactive voices are returned to the pool
+    {
+        VoicePool<ConstantVoice, 4> pool;
+        pool.init();
+        ConstantVoice* v = pool.noteOn(7);
+        v->start(1.0f, 1.0f);
+
+        ConstantVoice* released = pool.noteOff(7);
+        TEST("VoicePool noteOff: returns voice", released == v);
+        TEST("VoicePool noteOff: note detached", pool.find(7) == nullptr);
+        TEST("VoicePool noteOff: second noteOff misses", pool.noteOff(7) == nullptr);
+
+        Sample left[16];
+        Sample right[16];
+        pool.process(left, right, 16);
+        TEST("VoicePool noteOff: still active while sounding", pool.activeCount() == 1);
+
+        v->active = false;  // envelope finished
+        pool.process(left, right, 16);
+        TEST("VoicePool reap: inactive voice removed", pool.activeCount() == 0);
+        TEST("VoicePool reap: voice back in free list", pool.freeCount() == 4);
+    }
+
+    // Test block larger than the internal scratch
+    {
+        VoicePool<ConstantVoice, 2> pool;
+        pool.init();
+        pool.noteOn(1)->start(0.5f, 1.0f);
+
+        Sample left[300];
+        Sample right[300];
+        pool.process(left, right, 300);
+        TEST("VoicePool large block: last sample rendered", std::abs(left[299] - 0.5f) < 1e-6f);
+    }
+
+    // Test stealing the oldest voice
+    {
+        VoicePool<ConstantVoice, 2> pool;
+        pool.init();
+        ConstantVoice* first = pool.noteOn(1);
+        first->start(0.1f, 1.0f);
+        pool.noteOn(2)->start(0.2f, 1.0f);
+
+        ConstantVoice* stolen = pool.noteOn(3);
+        TEST("VoicePool steal oldest: reuses first voice", stolen == first);
+        TEST("VoicePool steal oldest: old note gone", pool.find(1) == nullptr);
+        TEST("VoicePool steal oldest: new note bound", pool.find(3) == stolen);
+        TEST("VoicePool steal oldest: steal counted", pool.stealCount() == 1);
+        TEST("VoicePool steal oldest: voice reset", stolen->resets == 1);
+        TEST("VoicePool steal oldest: active count unchanged", pool.activeCount() == 2);
+    }
+
+    // Test stealing the quietest voice
+    {
+        VoicePool<ConstantVoice, 3> pool;
+        pool.init();
+        pool.setStealMode(VoicePool<ConstantVoice, 3>::StealMode::Quietest);
+        pool.noteOn(1)->start(0.1f, 0.9f);
+        ConstantVoice* quiet = pool.noteOn(2);
+        quiet->start(0.1f, 0.2f);
+        pool.noteOn(3)->start(0.1f, 0.5f);
+
+        ConstantVoice* stolen = pool.noteOn(4);
+        TEST("VoicePool steal quietest: lowest level stolen", stolen == quiet);
+        TEST("VoicePool steal quietest: loud note kept", pool.find(1) != nullptr);
+    }
+
+    // Test released voices are stolen before held ones
+    {
+        VoicePool<ConstantVoice, 2> pool;
+        pool.init();
+        pool.noteOn(1)->start(0.1f, 1.0f);
+        ConstantVoice* second = pool.noteOn(2);
+        second->start(0.1f, 1.0f);
+        pool.noteOff(2);
+
+        ConstantVoice* stolen = pool.noteOn(3);
+        TEST("VoicePool steal: released voice preferred", stolen == second);
+        TEST("VoicePool steal: held note kept", pool.find(1) != nullptr);
+    }
+
+    // Test stolen voice fades out instead of cutting off
+    {
+        VoicePool<ConstantVoice, 1, 32> pool;
+        pool.init();
+        pool.noteOn(1)->start(1.0f, 1.0f);
+
+        Sample left[64];
+        Sample right[64];
+        pool.process(left, right, 64);
+
+        pool.noteOn(2);  // steal; new voice left silent and inactive
+        pool.process(left, right, 64);
+
+        TEST("VoicePool steal fade: starts near full level", std::abs(left[0] - 1.0f) < 1e-6f);
+        TEST("VoicePool steal fade: decreasing", left[16] < left[1] && left[16] > 0.0f);
+        TEST("VoicePool steal fade: silent after fade", left[32] == 0.0f && left[63] == 0.0f);
+        TEST("VoicePool steal fade: right follows", std::abs(right[0] + 1.0f) < 1e-6f);
+    }
+
+    // Test with ExampleVoice
+    {
+        VoicePool<ExampleVoice, 8> pool;
+        pool.init(48000.0f);
+        for (uint32_t note = 0; note < 3; ++note) {
+            ExampleVoice* v = pool.noteOn(note);
+            v->setFrequency(220.0f * static_cast<Sample>(note + 1));
+            v->setRelease(0.001f);
+            v->trigger();
+        }
+
+        Sample left[64];
+        Sample right[64];
+        pool.process(left, right, 64);
+        Sample peak = 0.0f;
+        for (size_t i = 0; i < 64; ++i) {
+            peak = std::max(peak, std::abs(left[i]) + std::abs(right[i]));
+        }
+        TEST("VoicePool ExampleVoice: produces output", peak > 0.0f);
+        TEST("VoicePool ExampleVoice: three active", pool.activeCount() == 3);
+
+        for (uint32_t note = 0; note < 3; ++note) {
+            pool.noteOff(note)->release();
+        }
+        for (int block = 0; block < 100; ++block) {
+            pool.process(left, right, 64);
+        }
+        TEST("VoicePool ExampleVoice: released voices reaped", pool.activeCount() == 0);
+    }
+
+    return failures;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file test_wavfile.cpp
+ * @brief Unit tests for WavInfo and WavFile
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <subcollider/BufferAllocator.h>
+#include <subcollider/WavFile.h>
+
+using namespace subcollider;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+void putU16(std::vector<uint8_t>& v, uint32_t x) {
+    v.push_back(static_cast<uint8_t>(x));
+    v.push_back(static_cast<uint8_t>(x >> 8));
+}
+
+void putU32(std::vector<uint8_t>& v, uint32_t x) {
+    putU16(v, x & 0xFFFFu);
+    putU16(v, x >> 16);
+}
+
+void putTag(std::vector<uint8_t>& v, const char* tag) {
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(static_cast<uint8_t>(tag[i]));
+    }
+}
+
+/// Build a WAV image; fmtExtra pads the fmt chunk to move the data offset
+std::vector<uint8_t> makeWav(uint16_t tag, uint16_t channels, uint32_t rate, uint16_t bits,
+                             const std::vector<uint8_t>& samples, uint16_t fmtExtra = 0) {
+    std::vector<uint8_t> v;
+    putTag(v, "RIFF");
+    putU32(v, 0);  // patched below
+    putTag(v, "WAVE");
+    putTag(v, "LIST");  // unknown chunk with odd size and pad byte
+    putU32(v, 3);
+    v.push_back('a');
+    v.push_back('b');
+    v.push_back('c');
+    v.push_back(0);
+    putTag(v, "fmt ");
+    putU32(v, 16u + fmtExtra);
+    putU16(v, tag);
+    putU16(v, channels);
+    putU32(v, rate);
+    putU32(v, rate * channels * (bits / 8));
+    putU16(v, static_cast<uint16_t>(channels * (bits / 8)));
+    putU16(v, bits);
+    for (uint16_t i = 0; i < fmtExtra; ++i) {
+        v.push_back(0);
+    }
+    putTag(v, "data");
+    putU32(v, static_cast<uint32_t>(samples.size()));
+    v.insert(v.end(), samples.begin(), samples.end());
+    const uint32_t riff = static_cast<uint32_t>(v.size() - 8);
+    v[4] = static_cast<uint8_t>(riff);
+    v[5] = static_cast<uint8_t>(riff >> 8);
+    v[6] = static_cast<uint8_t>(riff >> 16);
+    v[7] = static_cast<uint8_t>(riff >> 24);
+    return v;
+}
+
+std::vector<uint8_t> floatBytes(const std::vector<float>& values) {
+    std::vector<uint8_t> v;
+    for (float f : values) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        putU32(v, bits);
+    }
+    return v;
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int test_wavfile() {
+    int failures = 0;
+
+    // Test header parsing and integer conversion from memory
+    {
+        std::vector<uint8_t> pcm;
+        putU16(pcm, 0x4000);  // 0.5
+        putU16(pcm, 0xC000);  // -0.5
+        putU16(pcm, 0x7FFF);
+        putU16(pcm, 0x8000);  // -1.0
+        const std::vector<uint8_t> wav = makeWav(1, 2, 44100, 16, pcm);
+        const WavInfo info = WavInfo::parse(wav.data(), wav.size());
+        TEST("WavInfo: 16-bit parsed", info.isValid() && info.format == WavInfo::Format::PCM16);
+        TEST("WavInfo: channels and rate", info.channels == 2 && info.sampleRate == 44100);
+        TEST("WavInfo: frames", info.frames == 2);
+        TEST("WavInfo: skips padded unknown chunk", info.dataOffset == 12 + 12 + 24 + 8);
+
+        Sample out[4] = {};
+        info.convert(wav.data(), out, 2, info.frames);
+        TEST("WavInfo: 16-bit converted",
+             out[0] == 0.5f && out[1] == -0.5f && std::abs(out[2] - 1.0f) < 1e-4f && out[3] == -1.0f);
+        Sample mono[2] = {};
+        info.convert(wav.data(), mono, 1, info.frames);
+        TEST("WavInfo: stereo to mono takes left", mono[0] == 0.5f && std::abs(mono[1] - 1.0f) < 1e-4f);
+    }
+
+    {
+        const std::vector<uint8_t> pcm = {0x00, 0x00, 0xC0, 0x00, 0x00, 0x40};  // -0.5, 0.5
+        const std::vector<uint8_t> wav = makeWav(1, 1, 48000, 24, pcm);
+        const WavInfo info = WavInfo::parse(wav.data(), wav.size());
+        Sample out[2] = {};
+        info.convert(wav.data(), out, 1, info.frames);
+        TEST("WavInfo: 24-bit converted", info.frames == 2 && out[0] == -0.5f && out[1] == 0.5f);
+
+        Sample stereo[4] = {};
+        info.convert(wav.data(), stereo, 2, info.frames);
+        TEST("WavInfo: mono duplicated to stereo", stereo[0] == -0.5f && stereo[1] == -0.5f);
+    }
+
+    {
+        const std::vector<uint8_t> junk = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 'A', 'V', 'I', ' '};
+        TEST("WavInfo: non-WAVE rejected", !WavInfo::parse(junk.data(), junk.size()).isValid());
+        const std::vector<uint8_t> alaw = makeWav(6, 1, 8000, 8, {1, 2, 3});
+        TEST("WavInfo: unsupported format rejected", !WavInfo::parse(alaw.data(), alaw.size()).isValid());
+    }
+
+#if defined(SUBCOLLIDER_HAS_MMAP)
+    static BufferAllocator<1 << 20, 16> allocator;
+    allocator.init(48000.0f);
+
+    // Test float32 files map without copying
+    {
+        const std::string path = "wavfile_test_float.wav";
+        const std::vector<float> values = {0.25f, -0.25f, 0.75f, -0.75f, 1.5f, -1.5f};
+        writeFile(path, makeWav(3, 2, 96000, 32, floatBytes(values)));
+
+        WavFile wav;
+        TEST("WavFile float: opens", wav.open(path.c_str()));
+        TEST("WavFile float: zero-copy", wav.isZeroCopy());
+        Buffer buf = wav.buffer();
+        TEST("WavFile float: buffer format",
+             buf.isValid() && buf.isStereo() && buf.numSamples == 3 && buf.sampleRate == 96000.0f);
+        TEST("WavFile float: samples read in place",
+             buf.getStereoSample(1).left == 0.75f && buf.getStereoSample(2).right == -1.5f);
+
+        if (buf.isValid()) {
+            buf.data[0] = 9.0f;
+        }
+        WavFile again;
+        again.open(path.c_str());
+        TEST("WavFile float: writes do not reach the file",
+             again.buffer().isValid() && again.buffer().data[0] == 0.25f);
+
+        const size_t used = allocator.usedSpace();
+        Buffer copy = wav.load(allocator);
+        TEST("WavFile float: load copies into allocator",
+             copy.isValid() && copy.data[2] == 0.75f && allocator.usedSpace() == used + 6);
+        allocator.release(copy);
+        std::remove(path.c_str());
+    }
+
+    // Test misaligned float data falls back to load()
+    {
+        const std::string path = "wavfile_test_misaligned.wav";
+        writeFile(path, makeWav(3, 1, 48000, 32, floatBytes({0.5f, -0.5f}), 2));
+        WavFile wav;
+        TEST("WavFile misaligned: opens", wav.open(path.c_str()));
+        TEST("WavFile misaligned: no zero-copy buffer", !wav.isZeroCopy() && !wav.buffer().isValid());
+        Buffer buf = wav.load(allocator);
+        TEST("WavFile misaligned: load converts", buf.isValid() && buf.data[1] == -0.5f);
+        allocator.release(buf);
+        std::remove(path.c_str());
+    }
+
+    // Test the bundled 16-bit PCM and 24-bit extensible files
+    {
+        WavFile wav;
+        TEST("WavFile amen16: opens", wav.open("data/amen_16_48000.wav"));
+        TEST("WavFile amen16: format",
+             wav.info().format == WavInfo::Format::PCM16 && wav.info().channels == 2 &&
+             wav.info().sampleRate == 48000);
+        TEST("WavFile amen16: integer data is not zero-copy", !wav.buffer().isValid());
+        Buffer buf = wav.load(allocator);
+        TEST("WavFile amen16: loaded", buf.isValid() && buf.numSamples == wav.info().frames);
+        TEST("WavFile amen16: first samples",
+             buf.isValid() && buf.data[0] == 95.0f / 32768.0f && buf.data[1] == 97.0f / 32768.0f);
+        allocator.release(buf);
+
+        WavFile ext;
+        TEST("WavFile amen24: extensible opens", ext.open("data/amen_beats8_bpm172.wav"));
+        TEST("WavFile amen24: format",
+             ext.info().format == WavInfo::Format::PCM24 && ext.info().sampleRate == 44100);
+        Buffer buf24 = ext.load(allocator);
+        bool inRange = buf24.isValid();
+        for (size_t i = 0; inRange && i < buf24.totalFloats(); ++i) {
+            inRange = buf24.data[i] >= -1.0f && buf24.data[i] < 1.0f;
+        }
+        TEST("WavFile amen24: samples in range", inRange);
+        allocator.release(buf24);
+    }
+
+    {
+        WavFile wav;
+        TEST("WavFile: missing file fails", !wav.open("data/does_not_exist.wav") && !wav.isOpen());
+    }
+#endif
+
+    return failures;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file test_workerpool.cpp
+ * @brief Unit tests for WorkerPool and ParallelVoiceRenderer
+ */
+
+#include <iostream>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <subcollider/WorkerPool.h>
+#include <subcollider/ParallelVoiceRenderer.h>
+#include <subcollider/VoicePool.h>
+#include <subcollider/ExampleVoice.h>
+#include <subcollider/AudioLoop.h>
+
+using namespace subcollider;
+
+#define TEST(name, condition) \
+    if (!(condition)) { \
+        std::cout << "FAIL: " << name << std::endl; \
+        failures++; \
+    } else { \
+        std::cout << "PASS: " << name << std::endl; \
+    }
+
+namespace {
+
+struct TaskCounts {
+    std::atomic<int> hits[512];
+};
+
+void countTask(void* context, size_t task) {
+    static_cast<TaskCounts*>(context)->hits[task].fetch_add(1, std::memory_order_relaxed);
+}
+
+using TestPool = VoicePool<ExampleVoice, 32>;
+
+void startVoices(TestPool& pool) {
+    pool.init(48000.0f);
+    for (uint32_t note = 0; note < 20; ++note) {
+        ExampleVoice* v = pool.noteOn(note);
+        v->setFrequency(110.0f + 37.0f * static_cast<Sample>(note));
+        v->setVibratoDepth(0.2f);
+        v->setRelease(0.01f);
+        v->trigger();
+    }
+}
+
+} // namespace
+
+int test_workerpool() {
+    int failures = 0;
+
+    // Test every task runs exactly once, with and without helper threads
+    {
+        for (size_t threads : {size_t(0), size_t(1), size_t(3)}) {
+            WorkerPool<4> workers;
+            workers.start(threads);
+
+            bool exact = true;
+            for (size_t batch = 0; batch < 50; ++batch) {
+                TaskCounts counts;
+                for (auto& h : counts.hits) {
+                    h.store(0);
+                }
+                const size_t numTasks = 1 + (batch * 37) % 500;
+                workers.run(countTask, &counts, numTasks);
+                for (size_t i = 0; i < 512; ++i) {
+                    const int expected = i < numTasks ? 1 : 0;
+                    if (counts.hits[i].load() != expected) {
+                        exact = false;
+                    }
+                }
+            }
+            workers.stop();
+            TEST("WorkerPool: each task runs exactly once (" + std::to_string(threads) + " threads)", exact);
+        }
+    }
+
+    // Test thread count and empty batches
+    {
+        WorkerPool<2> workers;
+        TEST("WorkerPool: start clamps to MaxThreads", workers.start(8) == 2);
+        TEST("WorkerPool: numThreads", workers.numThreads() == 2);
+        TaskCounts counts;
+        for (auto& h : counts.hits) {
+            h.store(0);
+        }
+        workers.run(countTask, &counts, 0);
+        TEST("WorkerPool: empty batch runs nothing", counts.hits[0].load() == 0);
+        workers.stop();
+        TEST("WorkerPool: stop joins threads", workers.numThreads() == 0);
+    }
+
+    // Test parallel rendering matches serial rendering bit for bit
+    {
+        static TestPool serialPool;
+        static TestPool parallelPool1;
+        static TestPool parallelPool3;
+        startVoices(serialPool);
+        startVoices(parallelPool1);
+        startVoices(parallelPool3);
+
+        static ParallelVoiceRenderer<TestPool, 4> renderer1;
+        static ParallelVoiceRenderer<TestPool, 4> renderer3;
+        renderer1.init(&parallelPool1, 1);
+        renderer3.init(&parallelPool3, 3);
+
+        Sample sL[200], sR[200], aL[200], aR[200], bL[200], bR[200];
+        bool identical = true;
+        bool nonSilent = false;
+        for (int block = 0; block < 40; ++block) {
+            if (block == 10) {
+                for (uint32_t note = 0; note < 20; note += 2) {
+                    serialPool.noteOff(note)->release();
+                    parallelPool1.noteOff(note)->release();
+                    parallelPool3.noteOff(note)->release();
+                }
+            }
+            serialPool.process(sL, sR, 200);
+            renderer1.process(aL, aR, 200);
+            renderer3.process(bL, bR, 200);
+            for (size_t i = 0; i < 200; ++i) {
+                if (sL[i] != aL[i] || sR[i] != aR[i] || sL[i] != bL[i] || sR[i] != bR[i]) {
+                    identical = false;
+                }
+                if (sL[i] != 0.0f) {
+                    nonSilent = true;
+                }
+            }
+        }
+        renderer1.shutdown();
+        renderer3.shutdown();
+
+        TEST("ParallelVoiceRenderer: output is non-silent", nonSilent);
+        TEST("ParallelVoiceRenderer: matches serial and is thread-count independent", identical);
+        TEST("ParallelVoiceRenderer: released voices reaped",
+             parallelPool3.activeCount() == serialPool.activeCount() &&
+             parallelPool3.activeCount() == 10);
+    }
+
+    // Test hooking the renderer into AudioCallbackHandler
+    {
+        static TestPool pool;
+        startVoices(pool);
+        static ParallelVoiceRenderer<TestPool, 2> renderer;
+        renderer.init(&pool, 2);
+
+        AudioCallbackHandler handler;
+        handler.init(48000.0f);
+        handler.setStereoCallback(ParallelVoiceRenderer<TestPool, 2>::stereoCallback, &renderer);
+
+        Sample left[64] = {};
+        Sample right[64] = {};
+        handler.processStereo(left, right, 64);
+        renderer.shutdown();
+
+        Sample energy = 0.0f;
+        for (size_t i = 0; i < 64; ++i) {
+            energy += left[i] * left[i] + right[i] * right[i];
+        }
+        TEST("ParallelVoiceRenderer: stereo callback renders", energy > 0.0f);
+    }
+
+    return failures;
+}
@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include <cmath>
+#include <string>
 #include <subcollider/ugens/XPlay.h>
 
 using namespace subcollider;
@@ -72,7 +73,8 @@ int test_xplay() {
         bool inRange = true;
         for (int i = 0; i < 10; ++i) {
             xplay.tick();
-            if (xplay.phasor < windowStart || xplay.phasor >= windowEnd) {
+            const Sample phasor = xplay.phasor.toSample();
+            if (phasor < windowStart || phasor >= windowEnd) {
                 inRange = false;
                 break;
             }
@@ -80,5 +82,75 @@ int test_xplay() {
         TEST("XPlay reverse phasor wraps within window", inRange);
     }
 
+    // Block process matches tick for both play modes and every interpolation
+    {
+        const Sample sr = 48000.0f;
+        Sample data[96 * 2];
+        for (size_t i = 0; i < 96; ++i) {
+            data[i * 2] = std::sin(0.23f * static_cast<Sample>(i));
+            data[i * 2 + 1] = std::cos(0.11f * static_cast<Sample>(i));
+        }
+        Buffer buf(data, 2, 44100.0f, 96);
+
+        const XPlay::PlayMode modes[2] = {XPlay::PlayMode::Loop, XPlay::PlayMode::Bounce};
+        const uint8_t interps[4] = {1, 2, 4, 16};
+        for (int m = 0; m < 2; ++m) {
+            for (int k = 0; k < 4; ++k) {
+                XPlay blocked;
+                blocked.init(sr);
+                blocked.setBuffer(&buf);
+                blocked.setPlayMode(modes[m]);
+                blocked.reader.setInterpolation(interps[k]);
+                blocked.setStartEnd(0.8f, 0.2f);  // Reverse segment
+                blocked.setRate(1.3f);
+                blocked.setFadeTime(0.0002f);     // Crossfades last ~10 samples
+                XPlay ticked = blocked;
+
+                Sample left[64];
+                Sample right[64];
+                bool same = true;
+                for (int b = 0; b < 12; ++b) {
+                    blocked.process(left, right, 64);
+                    for (size_t i = 0; i < 64; ++i) {
+                        const Stereo s = ticked.tick();
+                        same = same && left[i] == s.left && right[i] == s.right;
+                    }
+                }
+                const std::string tag = std::string(m == 0 ? "loop" : "bounce") + " interp " +
+                                        std::to_string(interps[k]);
+                TEST("XPlay process matches tick: " + tag, same);
+            }
+        }
+    }
+
+    // Settled crossfade reads only the audible head
+    {
+        const Sample sr = 48000.0f;
+        Sample data[16 * 2];
+        for (size_t i = 0; i < 32; ++i) {
+            data[i] = static_cast<Sample>(i) * 0.01f;
+        }
+        Buffer buf(data, 2, sr, 16);
+
+        XPlay xplay;
+        xplay.init(sr);
+        xplay.setBuffer(&buf);
+        xplay.setStartEnd(0.25f, 0.75f);  // Frames 4..12, window 4..20
+        xplay.setRate(0.0f);
+        xplay.setFadeTime(0.0f);
+        xplay.env.value = 1.0f;
+        xplay.env.state = EnvelopeADSR::State::Sustain;
+        xplay.env.sustainLevel = 1.0f;
+        xplay.env.gateValue = 1.0f;
+        xplay.phasor = Playhead(14.5);    // Second half: head 2 at 6.5
+        xplay.fadeLag.setValue(1.0f);
+
+        Sample left[4];
+        Sample right[4];
+        xplay.process(left, right, 4);
+        const Stereo head2 = xplay.reader.tickStereo(Playhead(6.5));
+        TEST("XPlay settled fade: head 2 only", left[3] == head2.left && right[3] == head2.right);
+    }
+
     return failures;
 }